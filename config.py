@@ -71,8 +71,18 @@ class configuration:
   # Build the openmoc.cuda module
   with_cuda = False
 
+  # Build the openmoc.double module in double precision alongside the main
+  # openmoc module, such that a run may switch from a single to a double
+  # precision Solver without rebuilding its Tracks
+  with_double = False
+
+  # Build the VectorizedSolver with the GNU or Clang compilers (it is always
+  # built with Intel's compiler). The solver uses OpenMP SIMD directives and
+  # is compiled for the instruction set of the host (ie, AVX2, AVX-512)
+  with_simd = False
+
   # The vector length used for the VectorizedSolver class. This will used
-  # as a hint for the Intel compiler to issue SIMD (ie, SSE, AVX, etc) vector
+  # as a hint for the compiler to issue SIMD (ie, SSE, AVX, etc) vector
   # instructions. This is accomplished by adding "dummy" energy groups such
   # that the number of energy groups is be fit too a multiple of this
   # vector_length, and restructuring the innermost loops in the solver to
@@ -80,15 +90,16 @@ class configuration:
   vector_length = 8
 
   # The vector alignment used in the VectorizedSolver class when allocating
-  # aligned data structures using MM_MALLOC and MM_FREE
-  vector_alignment = 16
+  # aligned data structures using MM_MALLOC and MM_FREE (64 bytes is the
+  # cache line size and the width of AVX-512 registers)
+  vector_alignment = 64
 
   # List of C/C++/CUDA distutils.extension objects which are created based
   # on which flags are specified at compile time.
   extensions = list()
 
   # List of the possible packages to install based on runtime options
-  packages = ['openmoc', 'openmoc.cuda']
+  packages = ['openmoc', 'openmoc.cuda', 'openmoc.double']
 
 
   #############################################################################
@@ -107,6 +118,7 @@ class configuration:
                     'src/MOCKernel.cpp',
                     'src/Point.cpp',
                     'src/Quadrature.cpp',
+                    'src/SegmentStore.cpp',
                     'src/ExpEvaluator.cpp',
                     'src/Solver.cpp',
                     'src/CPUSolver.cpp',
@@ -131,6 +143,7 @@ class configuration:
                       'src/MOCKernel.cpp',
                       'src/Point.cpp',
                       'src/Quadrature.cpp',
+                      'src/SegmentStore.cpp',
                       'src/ExpEvaluator.cpp',
                       'src/Solver.cpp',
                       'src/CPUSolver.cpp',
@@ -156,6 +169,7 @@ class configuration:
                      'src/MOCKernel.cpp',
                      'src/Point.cpp',
                      'src/Quadrature.cpp',
+                     'src/SegmentStore.cpp',
                      'src/ExpEvaluator.cpp',
                      'src/Solver.cpp',
                      'src/CPUSolver.cpp',
@@ -182,6 +196,7 @@ class configuration:
                       'src/MOCKernel.cpp',
                       'src/Point.cpp',
                       'src/Quadrature.cpp',
+                      'src/SegmentStore.cpp',
                       'src/ExpEvaluator.cpp',
                       'src/Solver.cpp',
                       'src/CPUSolver.cpp',
@@ -396,6 +411,12 @@ class configuration:
                               ('NVCC', None),
                               ('CCACHE_CC', 'nvcc')]
 
+  # Mixed precision computes in double precision while storing the angular
+  # fluxes, reduced sources and segment lengths in single precision
+  for compiler in macros:
+    macros[compiler]['mixed'] = macros[compiler]['double'] + \
+                                [('MIXED', None), ('FP_STORAGE', 'float')]
+
   # define OPENMP and SWIG (for log output)
   for compiler in macros:
     for precision in macros[compiler]:
@@ -435,10 +456,27 @@ class configuration:
       self.include_directories[cc].append(numpy_include)
 
 
+    # If the user wishes to build the VectorizedSolver with the GNU or Clang
+    # compilers, add its source, macro and host instruction set flags
+    if self.with_simd and self.cc in ['gcc', 'clang']:
+      self.sources[self.cc].append('src/VectorizedSolver.cpp')
+      self.compiler_flags[self.cc].append('-march=native')
+      for fp in self.macros[self.cc]:
+        self.macros[self.cc][fp].append(('SIMD', None))
+      self.swig_flags += ['-DSIMD']
+
+    # The SWIG flags for the openmoc.double extension
+    self.double_swig_flags = self.swig_flags + \
+        ['-DDOUBLE', '-DFP_PRECISION=double', '-module', 'openmoc_double',
+         '-outdir', 'openmoc/double']
+
     # The main openmoc extension (defaults are gcc and single precision)
     self.swig_flags += ['-D' + self.fp.upper()]
     if self.fp == 'double':
       self.swig_flags += ['-DFP_PRECISION=double']
+    elif self.fp == 'mixed':
+      self.swig_flags += ['-DDOUBLE', '-DFP_PRECISION=double',
+                          '-DFP_STORAGE=float']
     else:
       self.swig_flags += ['-DFP_PRECISION=float']
 
@@ -452,6 +490,24 @@ class configuration:
                 define_macros = self.macros[self.cc][self.fp],
                 swig_opts = self.swig_flags + ['-D' + self.cc.upper()]))
 
+    # The openmoc.double extension if requested by the user at compile
+    # time (--with-double)
+    if self.with_double:
+
+      sources = copy.deepcopy(self.sources[self.cc])
+      sources[0] = 'openmoc/openmoc_double_wrap.cpp'
+
+      self.extensions.append(
+        Extension(name = '_openmoc_double',
+                  sources = sources,
+                  library_dirs = self.library_directories[self.cc],
+                  libraries = self.shared_libraries[self.cc],
+                  extra_link_args = self.linker_flags[self.cc],
+                  include_dirs = self.include_directories[self.cc],
+                  define_macros = self.macros[self.cc]['double'],
+                  swig_opts = self.double_swig_flags + \
+                              ['-D' + self.cc.upper()]))
+
     # The openmoc.cuda extension if requested by the user at compile
     # time (--with-cuda)
     if self.with_cuda:
@@ -8039,7 +8039,7 @@ tracks to a file for reuse
 ";
 
 %feature("docstring") TrackGenerator::getNumSegments "
-getNumSegments() -> int  
+getNumSegments() -> long  
 
 Return the total number of Track segments across the Geometry.  
 
@@ -0,0 +1,20 @@
+import signal
+import sys
+
+# For Python 2.X.X
+if (sys.version_info[0] == 2):
+    import _openmoc_double
+    from openmoc_double import *
+# For Python 3.X.X
+else:
+    import _openmoc_double
+    from openmoc.double.openmoc_double import *
+
+# Log to the same file as the main openmoc module
+import openmoc
+initialize_logger()
+set_log_filename(openmoc.get_log_filename())
+
+# Tell Python to recognize CTRL+C and stop the C++ extension module
+# when this is passed in from the keyboard
+signal.signal(signal.SIGINT, signal.SIG_DFL)
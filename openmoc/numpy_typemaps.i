@@ -70,3 +70,13 @@
 
 /* The typemap used to match the method signature for Solver::setFluxes */
 %apply (FP_PRECISION* INPLACE_ARRAY1, int DIM1) {(FP_PRECISION* in_fluxes, int num_fluxes)}
+
+/* The typemap used to match the method signature for Solver::setInitialGuess */
+%apply (double* IN_ARRAY1, int DIM1) {(double* initial_fluxes, int num_fluxes)}
+
+/* The typemap used to match the method signature for Solver::getTrackFluxes */
+%apply (double* ARGOUT_ARRAY1, int DIM1) {(double* out_track_fluxes, int num_track_fluxes)}
+
+/* The typemap used to match the method signature for
+ * Solver::setInitialTrackFluxes */
+%apply (double* IN_ARRAY1, int DIM1) {(double* initial_track_fluxes, int num_track_fluxes)}
@@ -22,9 +22,13 @@
   #include "../src/ExpEvaluator.h"
   #include "../src/Point.h"
   #include "../src/Quadrature.h"
+  #include "../src/SegmentStore.h"
   #include "../src/Solver.h"
   #include "../src/CPUSolver.h"
   #include "../src/boundary_type.h"
+  #include "../src/flux_accumulation_type.h"
+  #include "../src/segmentation_type.h"
+  #include "../src/track_scheduling_type.h"
   #include "../src/Surface.h"
   #include "../src/Timer.h"
   #include "../src/Track.h"
@@ -35,7 +39,7 @@
   #include "../src/Matrix.h"
   #include "../src/linalg.h"
 
-  #ifdef ICPC
+  #if defined(ICPC) || defined(SIMD)
   #include "../src/VectorizedSolver.h"
   #endif
 
@@ -117,9 +121,13 @@ namespace std {
 %include ../src/Material.h
 %include ../src/Point.h
 %include ../src/Quadrature.h
+%include ../src/SegmentStore.h
 %include ../src/Solver.h
 %include ../src/CPUSolver.h
 %include ../src/boundary_type.h
+%include ../src/flux_accumulation_type.h
+%include ../src/segmentation_type.h
+%include ../src/track_scheduling_type.h
 %include ../src/Surface.h
 %include ../src/Timer.h
 %include ../src/Track.h
@@ -131,7 +139,7 @@ namespace std {
 %include ../src/Matrix.h
 %include ../src/linalg.h
 
-#ifdef ICPC
+#if defined(ICPC) || defined(SIMD)
 %include ../src/VectorizedSolver.h
 #endif
 
@@ -166,10 +166,13 @@ def compute_fission_rates(solver, use_hdf5=False):
 
             # Get the linked list of LocalCoords
             point = geometry.getFSRPoint(fsr)
-            coords = openmoc.LocalCoords(point.getX(), point.getY(), point.getZ())
-            coords.setUniverse(geometry.getRootUniverse())
-            geometry.findCellContainingCoords(coords)
-            coords = coords.getHighestLevel().getNext()
+            # Keep a reference to the highest level LocalCoords, which owns
+            # the lower levels traversed below
+            root_coords = \
+                openmoc.LocalCoords(point.getX(), point.getY(), point.getZ())
+            root_coords.setUniverse(geometry.getRootUniverse())
+            geometry.findCellContainingCoords(root_coords)
+            coords = root_coords.getNext()
 
             # initialize dictionary key
             key = 'UNIV = 0 : '
@@ -316,7 +319,9 @@ def store_simulation_state(solver, fluxes=False, sources=False,
         solver_type = 'GPUSolver'
 
     # Determine the floating point precision level
-    if solver.isUsingDoublePrecision():
+    if solver.isUsingMixedPrecision():
+        precision = 'mixed'
+    elif solver.isUsingDoublePrecision():
         precision = 'double'
     else:
         precision = 'single'
@@ -325,6 +330,8 @@ def store_simulation_state(solver, fluxes=False, sources=False,
     # linear interpolation for exponential evaluations
     if solver.isUsingExponentialInterpolation():
         method = 'linear interpolation'
+    elif solver.isUsingExponentialPolynomial():
+        method = 'polynomial approximation'
     else:
         method = 'exp intrinsic'
 
@@ -0,0 +1,71 @@
+#include "../../../src/CPUSolver.h"
+#include "../../../src/log.h"
+#include "C5G7Geometry.h"
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+
+#ifdef MPIx
+  MPI_Init(&argc, &argv);
+  log_set_ranks(MPI_COMM_WORLD);
+#endif
+
+  /* Define simulation parameters */
+  #ifdef OPENMP
+  int num_threads = omp_get_num_procs();
+  #else
+  int num_threads = 1;
+  #endif
+  double azim_spacing = 0.1;
+  int num_azim = 16;
+  double tolerance = 1e-5;
+  int max_iters = 1000;
+
+  /* Set logging information */
+  set_log_level("NORMAL");
+  log_printf(TITLE, "Simulating the C5G7 Benchmark Problem in angles...");
+
+  /* Create the materials, cells and lattices */
+  Universe* root_universe = createC5G7Geometry();
+
+  /* Create CMFD mesh */
+  log_printf(NORMAL, "Creating CMFD mesh...");
+
+  Cmfd cmfd;
+  cmfd.setSORRelaxationFactor(1.5);
+  cmfd.setLatticeStructure(51, 51);
+  std::vector< std::vector<int> > cmfd_group_structure = {{1,2,3}, {4,5,6,7}};
+  cmfd.setGroupStructure(cmfd_group_structure);
+
+  /* Scope the Geometry, TrackGenerator and Solver such that the MPI
+   * communicators they hold are freed before MPI is finalized */
+  {
+    /* Create the geometry */
+    log_printf(NORMAL, "Creating geometry...");
+    Geometry geometry;
+    geometry.setRootUniverse(root_universe);
+    geometry.setCmfd(&cmfd);
+
+    /* Generate tracks */
+    log_printf(NORMAL, "Initializing the track generator...");
+    TrackGenerator track_generator(&geometry, num_azim, azim_spacing);
+    track_generator.setNumThreads(num_threads);
+#ifdef MPIx
+    track_generator.setAngularDecomposition();
+#endif
+    track_generator.generateTracks();
+
+    /* Run simulation */
+    CPUSolver solver(&track_generator);
+    solver.setNumThreads(num_threads);
+    solver.setConvergenceThreshold(tolerance);
+    solver.computeEigenvalue(max_iters);
+    solver.printTimerReport();
+  }
+
+#ifdef MPIx
+  MPI_Finalize();
+#endif
+
+  return 0;
+}
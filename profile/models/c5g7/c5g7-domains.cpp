@@ -0,0 +1,63 @@
+#include "../../../src/CPUSolver.h"
+#include "../../../src/log.h"
+#include "C5G7Geometry.h"
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+
+#ifdef MPIx
+  MPI_Init(&argc, &argv);
+  log_set_ranks(MPI_COMM_WORLD);
+#endif
+
+  /* Define simulation parameters */
+  #ifdef OPENMP
+  int num_threads = omp_get_num_procs();
+  #else
+  int num_threads = 1;
+  #endif
+  double azim_spacing = 0.1;
+  int num_azim = 4;
+  double tolerance = 1e-5;
+  int max_iters = 1000;
+  int num_domains_x = 2;
+  int num_domains_y = 2;
+
+  /* Set logging information */
+  set_log_level("NORMAL");
+  log_printf(TITLE, "Simulating the C5G7 Benchmark Problem in domains...");
+
+  /* Create the materials, cells and lattices */
+  Universe* root_universe = createC5G7Geometry();
+
+  /* Scope the Geometry, TrackGenerator and Solver such that the MPI
+   * communicators they hold are freed before MPI is finalized */
+  {
+    /* Create the geometry */
+    log_printf(NORMAL, "Creating geometry...");
+    Geometry geometry;
+    geometry.setRootUniverse(root_universe);
+#ifdef MPIx
+    geometry.setDomainDecomposition(num_domains_x, num_domains_y);
+#endif
+
+    /* Generate tracks */
+    log_printf(NORMAL, "Initializing the track generator...");
+    TrackGenerator track_generator(&geometry, num_azim, azim_spacing);
+    track_generator.setNumThreads(num_threads);
+    track_generator.generateTracks();
+
+    /* Run simulation */
+    CPUSolver solver(&track_generator);
+    solver.setNumThreads(num_threads);
+    solver.setConvergenceThreshold(tolerance);
+    solver.computeEigenvalue(max_iters);
+    solver.printTimerReport();
+  }
+
+#ifdef MPIx
+  MPI_Finalize();
+#endif
+
+  return 0;
+}
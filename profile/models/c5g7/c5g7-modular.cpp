@@ -0,0 +1,46 @@
+#include "../../../src/CPUSolver.h"
+#include "../../../src/log.h"
+#include "C5G7Geometry.h"
+#include <iostream>
+
+int main() {
+
+  /* Define simulation parameters */
+  #ifdef OPENMP
+  int num_threads = omp_get_num_procs();
+  #else
+  int num_threads = 1;
+  #endif
+  double azim_spacing = 0.1;
+  int num_azim = 4;
+  double tolerance = 1e-5;
+  int max_iters = 1000;
+
+  /* Set logging information */
+  set_log_level("NORMAL");
+  log_printf(TITLE, "Simulating the C5G7 Benchmark with modular tracks...");
+
+  /* Create the materials, cells and lattices */
+  Universe* root_universe = createC5G7Geometry();
+
+  /* Create the geometry */
+  log_printf(NORMAL, "Creating geometry...");
+  Geometry geometry;
+  geometry.setRootUniverse(root_universe);
+
+  /* Generate tracks */
+  log_printf(NORMAL, "Initializing the track generator...");
+  TrackGenerator track_generator(&geometry, num_azim, azim_spacing);
+  track_generator.setNumThreads(num_threads);
+  track_generator.setModularRayTracing(3, 3);
+  track_generator.generateTracks();
+
+  /* Run simulation */
+  CPUSolver solver(&track_generator);
+  solver.setNumThreads(num_threads);
+  solver.setConvergenceThreshold(tolerance);
+  solver.computeEigenvalue(max_iters);
+  solver.printTimerReport();
+
+  return 0;
+}
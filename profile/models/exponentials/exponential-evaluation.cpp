@@ -0,0 +1,100 @@
+#include "../../../src/ExpEvaluator.h"
+#include "../../../src/Timer.h"
+#include "../../../src/log.h"
+#include <stdlib.h>
+
+int main() {
+
+  /* Define benchmark parameters */
+  int num_azim = 4;
+  int num_polar = 6;
+  int num_groups = 70;
+  int num_segments = 100000;
+  int num_trials = 10;
+  FP_PRECISION max_optical_length = 10.0;
+
+  /* Set logging information */
+  set_log_level("NORMAL");
+  log_printf(TITLE, "Benchmarking the exponential evaluation modes...");
+
+  /* Create the polar quadrature */
+  Quadrature* quadrature = new TYPolarQuad();
+  quadrature->setNumAzimAngles(num_azim);
+  quadrature->setNumPolarAngles(num_polar);
+  quadrature->initialize();
+  for (int a=0; a < num_azim/4; a++)
+    quadrature->setAzimSpacing(0.1, a);
+  quadrature->precomputeWeights(false);
+
+  /* Sample random segment lengths and total cross-sections such that the
+   * optical lengths span the range covered by the interpolation table */
+  srand(1);
+  FP_PRECISION* lengths = new FP_PRECISION[num_segments];
+  FP_PRECISION* sigma_t = new FP_PRECISION[num_groups];
+  for (int s=0; s < num_segments; s++)
+    lengths[s] = FP_PRECISION(rand()) / RAND_MAX;
+  for (int e=0; e < num_groups; e++)
+    sigma_t[e] = max_optical_length * rand() / RAND_MAX;
+
+  int num_polar_2 = num_polar / 2;
+  FP_PRECISION* exponentials = new FP_PRECISION[num_polar_2 * num_groups];
+  const char* modes[3] = {"interpolation", "intrinsic", "polynomial"};
+  Timer timer;
+
+  for (int m=0; m < 3; m++) {
+
+    ExpEvaluator exp_evaluator;
+    if (m == 0)
+      exp_evaluator.useInterpolation();
+    else if (m == 1)
+      exp_evaluator.useIntrinsic();
+    else
+      exp_evaluator.usePolynomial();
+
+    exp_evaluator.setQuadrature(quadrature);
+    exp_evaluator.setMaxOpticalLength(max_optical_length + TAU_NUDGE);
+    exp_evaluator.initialize();
+
+    /* Time the batched evaluation over all segments */
+    FP_PRECISION checksum = 0.;
+    timer.startTimer();
+    for (int t=0; t < num_trials; t++) {
+      for (int s=0; s < num_segments; s++) {
+        exp_evaluator.computeExponentials(lengths[s], sigma_t, num_groups,
+                                          num_polar_2, exponentials);
+        checksum += exponentials[s % (num_polar_2 * num_groups)];
+      }
+    }
+    timer.stopTimer();
+    double time = timer.getTime();
+
+    /* Compute the maximum error with respect to the exp(...) function */
+    double max_error = 0.;
+    for (int s=0; s < num_segments; s++) {
+      exp_evaluator.computeExponentials(lengths[s], sigma_t, num_groups,
+                                        num_polar_2, exponentials);
+      for (int p=0; p < num_polar_2; p++) {
+        double sin_theta = quadrature->getSinTheta(0, p);
+        for (int e=0; e < num_groups; e++) {
+          double tau = double(sigma_t[e]) * lengths[s];
+          double exact = 1. - exp(-tau / sin_theta);
+          double error = fabs(exponentials[p * num_groups + e] - exact);
+          max_error = std::max(max_error, error);
+        }
+      }
+    }
+
+    long num_exponentials = long(num_trials) * num_segments * num_polar_2 *
+                            num_groups;
+    log_printf(RESULT, "%-13s time per exponential = %1.4E sec, "
+               "max error = %1.4E (checksum %f)", modes[m],
+               time / num_exponentials, max_error, checksum);
+  }
+
+  delete [] lengths;
+  delete [] sigma_t;
+  delete [] exponentials;
+  delete quadrature;
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+#include "../../../src/Geometry.h"
+#include "../../../src/Timer.h"
+#include "../../../src/log.h"
+#include "ChainedHashMap.h"
+#include <vector>
+
+/* Build the FSR key of a synthetic FSR in a 3 level Geometry */
+FSRKey getKey(int fsr) {
+  FSRKey key;
+  key.append(fsr % 289);
+  key.append(10000 + (fsr / 289) % 17);
+  key.append(fsr / 4913);
+  key.append(10000 + fsr % 7);
+  return key;
+}
+
+
+/* Look up random FSRs from all threads, adding those not yet encountered as
+ * the ray tracing does, and return the number of FSRs added */
+template <class Map>
+int findFSRs(Map& map, std::vector<FSRKey>& keys, int num_lookups,
+             std::vector<int>& counts) {
+
+  int num_added = 0;
+
+#pragma omp parallel reduction(+:num_added)
+  {
+    unsigned int seed = 1 + omp_get_thread_num();
+    int num_threads = omp_get_num_threads();
+
+    for (int i=0; i < num_lookups / num_threads; i++) {
+
+      /* Draw a random FSR with a linear congruential generator */
+      seed = 1103515245 * seed + 12345;
+      int fsr = (seed >> 8) % keys.size();
+
+      if (!map.contains(keys[fsr])) {
+        int count = map.insert_and_get_count(keys[fsr], fsr);
+        if (count != -1) {
+#pragma omp atomic update
+          counts.at(count)++;
+          num_added++;
+        }
+      }
+      else if (map.at(keys[fsr]) != fsr)
+        log_printf(ERROR, "Found the wrong value for FSR %d", fsr);
+    }
+  }
+
+  return num_added;
+}
+
+
+/* Time the lookups into an empty map and into the filled map */
+template <class Map>
+void benchmark(const char* name, std::vector<FSRKey>& keys,
+               int num_lookups) {
+
+  Map map;
+  Timer timer;
+  std::vector<int> counts(keys.size(), 0);
+
+  timer.startTimer();
+  int num_added = findFSRs(map, keys, num_lookups, counts);
+  timer.stopTimer();
+  double fill_time = timer.getTime();
+
+  timer.startTimer();
+  findFSRs(map, keys, num_lookups, counts);
+  timer.stopTimer();
+  double lookup_time = timer.getTime();
+
+  /* Check that each FSR was added once with a unique order number */
+  if (num_added != map.size())
+    log_printf(ERROR, "Added %d FSRs to a %s map of size %d", num_added,
+               name, map.size());
+  for (int i=0; i < num_added; i++)
+    if (counts[i] != 1)
+      log_printf(ERROR, "Order number %d was drawn %d times from the %s "
+                 "map", i, counts[i], name);
+
+  log_printf(RESULT, "%-9s time per lookup (filling) = %1.4E sec", name,
+             fill_time / num_lookups);
+  log_printf(RESULT, "%-9s time per lookup (filled)  = %1.4E sec", name,
+             lookup_time / num_lookups);
+}
+
+
+int main() {
+
+  /* Define benchmark parameters */
+  int num_FSRs = 200000;
+  int num_lookups = 20000000;
+
+  /* Set logging information */
+  set_log_level("NORMAL");
+  log_printf(TITLE, "Benchmarking the hash maps under contention...");
+  log_printf(NORMAL, "Looking up %d FSRs from %d threads", num_FSRs,
+             omp_get_max_threads());
+
+  std::vector<FSRKey> keys(num_FSRs);
+  for (int fsr=0; fsr < num_FSRs; fsr++)
+    keys[fsr] = getKey(fsr);
+
+  benchmark< ChainedHashMap<FSRKey, int> >("chained", keys, num_lookups);
+  benchmark< ParallelHashMap<FSRKey, int> >("lock-free", keys, num_lookups);
+
+  return 0;
+}
@@ -59,9 +59,11 @@ class custom_install(install):
   # The user options for a customized OpenMOC build
   user_options = [
     ('cc=', None, "Compiler (gcc, icpc, or bgxlc) for main openmoc module"),
-    ('fp=', None, "Floating point precision (single or double) for " + \
+    ('fp=', None, "Floating point precision (single, double or mixed) for " + \
                   "main openmoc module"),
     ('with-cuda', None, "Build openmoc.cuda module for NVIDIA GPUs"),
+    ('with-double', None, "Build openmoc.double module in double precision"),
+    ('with-simd', None, "Build the VectorizedSolver with gcc or clang"),
     ('debug-mode', None, "Build with debugging symbols"),
     ('profile-mode', None, "Build with profiling symbols"),
     ('with-ccache', None, "Build with ccache for rapid recompilation"),
@@ -72,7 +74,9 @@ class custom_install(install):
   user_options += install.user_options
 
   # Set some compile options to be boolean switches
-  boolean_options = ['debug-mode',
+  boolean_options = ['with-double',
+                     'with-simd',
+                     'debug-mode',
                      'profile-mode',
                      'with-ccache']
 
@@ -101,6 +105,8 @@ class custom_install(install):
 
     # Set defaults for each of the newly defined compile time options
     self.with_cuda = False
+    self.with_double = False
+    self.with_simd = False
     self.debug_mode = False
     self.profile_mode = False
     self.with_ccache = False
@@ -123,6 +129,8 @@ class custom_install(install):
     # Set the configuration options specified to be the default
     # unless the corresponding flag was invoked by the user
     config.with_cuda = self.with_cuda
+    config.with_double = self.with_double
+    config.with_simd = self.with_simd
     config.debug_mode = self.debug_mode
     config.profile_mode = self.profile_mode
     config.with_ccache = self.with_ccache
@@ -136,10 +144,10 @@ class custom_install(install):
       config.cc = self.cc
 
     # Check that the user specified a supported floating point precision
-    if self.fp not in ['single', 'double']:
+    if self.fp not in ['single', 'double', 'mixed']:
       raise DistutilsOptionError \
           ('Must supply the -cc flag with one of the supported ' +
-           'floating point precision levels: single, double')
+           'floating point precision levels: single, double, mixed')
     else:
       config.fp = self.fp
 
@@ -341,6 +349,11 @@ class custom_build_ext(build_ext):
     os.system('swig {0} -o '.format(str.join(' ', swig_flags)) + \
               'openmoc/openmoc_wrap.cpp openmoc/openmoc.i')
 
+    if config.with_double:
+      swig_flags = config.double_swig_flags + ['-D' + config.cc.upper()]
+      os.system('swig {0} -o '.format(str.join(' ', swig_flags)) + \
+                'openmoc/openmoc_double_wrap.cpp openmoc/openmoc.i')
+
     if config.with_cuda:
       swig_flags = config.swig_flags + ['-DNVCC']
       os.system('swig {0} -o '.format(str.join(' ', swig_flags)) + \
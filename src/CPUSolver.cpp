@@ -13,7 +13,33 @@ CPUSolver::CPUSolver(TrackGenerator* track_generator)
   : Solver(track_generator) {
 
   setNumThreads(1);
+  _flux_accumulation = ATOMIC_UPDATES;
   _FSR_locks = NULL;
+  _thread_scalar_flux = NULL;
+  _num_thread_fluxes = 0;
+  _thread_exponentials = NULL;
+  _boundary_flux_update = DOUBLE_BUFFERED;
+  _num_boundary_fluxes = 0;
+  _num_cycle_chunks = 0;
+  _cycle_chunk_offsets = NULL;
+  _cycle_chunk_flux_offsets = NULL;
+  _cycle_chunk_fluxes = NULL;
+}
+
+
+/**
+ * @brief Destructor deletes the private per-thread FSR scalar fluxes,
+ *        segment exponentials and Track cycle chunks.
+ */
+CPUSolver::~CPUSolver() {
+
+  if (_thread_scalar_flux != NULL)
+    delete [] _thread_scalar_flux;
+
+  if (_thread_exponentials != NULL)
+    delete [] _thread_exponentials;
+
+  deleteCycleChunks();
 }
 
 
@@ -26,6 +52,67 @@ int CPUSolver::getNumThreads() {
 }
 
 
+/**
+ * @brief Returns the scheme used to accumulate FSR scalar fluxes.
+ * @return the flux accumulation type (FSR_LOCKS, ATOMIC_UPDATES or
+ *         THREAD_PRIVATE)
+ */
+fluxAccumulationType CPUSolver::getFluxAccumulation() {
+  return _flux_accumulation;
+}
+
+
+/**
+ * @brief Returns the storage and update of the boundary fluxes during each
+ *        transport sweep.
+ * @return the boundary flux update type (DOUBLE_BUFFERED, SINGLE_BUFFERED or
+ *         GAUSS_SEIDEL)
+ */
+boundaryFluxUpdateType CPUSolver::getBoundaryFluxUpdate() {
+  return _boundary_flux_update;
+}
+
+
+/**
+ * @brief Returns the number of chunks into which the Track cycles are split
+ *        to be swept in parallel.
+ * @return the number of chunks, or zero unless the boundary fluxes are
+ *         stored along the Track cycles
+ */
+int CPUSolver::getNumCycleChunks() {
+  return _num_cycle_chunks;
+}
+
+
+/**
+ * @brief Returns the offset of each chunk in the TrackGenerator's Track
+ *        cycles.
+ * @details The Track directions of chunk c are those between
+ *          getCycleChunkOffsets()[c] and getCycleChunkOffsets()[c+1] in
+ *          the TrackGenerator's Track cycles.
+ * @return an array of the offsets with the number of Track directions in the
+ *         last entry, or NULL unless the boundary fluxes are stored along
+ *         the Track cycles
+ */
+int* CPUSolver::getCycleChunkOffsets() {
+  return _cycle_chunk_offsets;
+}
+
+
+/**
+ * @brief Returns the incoming flux of the first Track direction of a chunk
+ *        of the Track cycles staged for this transport sweep.
+ * @param chunk the index of the chunk
+ * @return a pointer to the staged incoming flux, or NULL if the chunk's
+ *         first Track direction enters through a vacuum boundary
+ */
+FP_STORAGE* CPUSolver::getCycleChunkFlux(int chunk) {
+
+  long offset = _cycle_chunk_flux_offsets[chunk];
+  return (offset == -1) ? NULL : &_cycle_chunk_fluxes[offset];
+}
+
+
 /**
  * @brief Fills an array with the scalar fluxes.
  * @details This class method is a helper routine called by the OpenMOC
@@ -68,6 +155,53 @@ void CPUSolver::getFluxes(FP_PRECISION* out_fluxes, int num_fluxes) {
 }
 
 
+/**
+ * @brief Fills an array with the Track angular fluxes.
+ * @details This is a helper method to restart a calculation, possibly in
+ *          another precision, from the Track angular fluxes with
+ *          setInitialTrackFluxes(...). The incoming fluxes for the next
+ *          transport sweep are returned in double precision for any build.
+ *          This method may be called from Python as follows:
+ *
+ * @code
+ *          num_track_fluxes = 2 * num_tracks * num_polar / 2 * num_groups
+ *          track_fluxes = solver.getTrackFluxes(num_track_fluxes)
+ * @endcode
+ *
+ * @param out_track_fluxes an array of the Track angular fluxes
+ * @param num_track_fluxes the total number of Track angular flux values
+ */
+void CPUSolver::getTrackFluxes(double* out_track_fluxes,
+                               int num_track_fluxes) {
+
+  long size = 2 * (long)_tot_num_tracks * _polar_times_groups;
+  if (num_track_fluxes != size)
+    log_printf(ERROR, "Unable to get the Track angular fluxes since there are "
+               "%ld values which does not match the requested %d values",
+               size, num_track_fluxes);
+
+  else if (_boundary_flux == NULL)
+    log_printf(ERROR, "Unable to get the Track angular fluxes since they "
+               "have not yet been allocated");
+
+  /* Directions entering through vacuum boundaries have no stored flux */
+  if (_boundary_flux_offsets != NULL) {
+#pragma omp parallel for schedule(guided)
+    for (long i=0; i < 2 * (long)_tot_num_tracks; i++) {
+      long offset = _boundary_flux_offsets[i];
+      for (int j=0; j < _polar_times_groups; j++)
+        out_track_fluxes[i*_polar_times_groups+j] =
+            (offset == -1) ? 0. : _boundary_flux[offset+j];
+    }
+    return;
+  }
+
+#pragma omp parallel for schedule(guided)
+  for (long i=0; i < size; i++)
+    out_track_fluxes[i] = _start_flux[i];
+}
+
+
 /**
  * @brief Sets the number of shared memory OpenMP threads to use (>0).
  * @param num_threads the number of threads
@@ -84,6 +218,67 @@ void CPUSolver::setNumThreads(int num_threads) {
 }
 
 
+/**
+ * @brief Sets the scheme used to accumulate segment contributions into the
+ *        FSR scalar fluxes during each transport sweep.
+ * @details FSR_LOCKS guards each FSR with an OpenMP lock, ATOMIC_UPDATES
+ *          (the default) uses atomic adds, and THREAD_PRIVATE tallies into
+ *          a private copy of the scalar flux for each thread which is
+ *          reduced at the end of the sweep. The lock-free schemes avoid
+ *          allocating the TrackGenerator's array of FSR locks, while
+ *          THREAD_PRIVATE trades memory (# threads x # FSRs x # groups)
+ *          for contention-free updates. This routine may be called from
+ *          Python as follows:
+ *
+ * @code
+ *          solver.setFluxAccumulation(openmoc.THREAD_PRIVATE)
+ * @endcode
+ *
+ * @param accumulation the flux accumulation type
+ */
+void CPUSolver::setFluxAccumulation(fluxAccumulationType accumulation) {
+  _flux_accumulation = accumulation;
+}
+
+
+/**
+ * @brief Sets the storage and update of the Track boundary angular fluxes
+ *        during each transport sweep.
+ * @details DOUBLE_BUFFERED (the default) stores an incoming and an outgoing
+ *          boundary flux array of 2 x # Tracks x # polar angles / 2 x
+ *          # groups values each, copying one into the other before each
+ *          sweep. SINGLE_BUFFERED sweeps the Track directions along the
+ *          TrackGenerator's Track cycles with a single array which stores no
+ *          flux for directions entering through vacuum boundaries. Each
+ *          thread reads a Track direction's incoming flux before the
+ *          previous Track direction's outgoing flux overwrites it, such that
+ *          both give the same iterates, except that the CMFD boundary flux
+ *          update applies to the single array of incoming fluxes for the next
+ *          sweep rather than to the array swept. With SINGLE_BUFFERED, the
+ *          Tracks are swept one direction at a time, so that segments formed
+ *          on-the-fly are ray traced twice.
+ *
+ *          GAUSS_SEIDEL sweeps the Track cycles with a single array as for
+ *          SINGLE_BUFFERED, but sweeps each Track direction with the outgoing
+ *          flux of the previous Track direction in its chunk of the Track
+ *          cycles from the same transport sweep. Only the first Track
+ *          direction of each chunk uses the incoming flux of the previous
+ *          sweep, which speeds the convergence of the boundary fluxes on
+ *          problems with reflective or periodic boundaries. The chunks, and
+ *          hence the iterates, depend on the number of threads. This routine
+ *          may be called from Python as follows:
+ *
+ * @code
+ *          solver.setBoundaryFluxUpdate(openmoc.GAUSS_SEIDEL)
+ * @endcode
+ *
+ * @param update the boundary flux update type
+ */
+void CPUSolver::setBoundaryFluxUpdate(boundaryFluxUpdateType update) {
+  _boundary_flux_update = update;
+}
+
+
 /**
  * @brief Set the flux array for use in transport sweep source calculations.
  * @detail This is a helper method for the checkpoint restart capabilities,
@@ -119,12 +314,61 @@ void CPUSolver::setFluxes(FP_PRECISION* in_fluxes, int num_fluxes) {
 
 /**
  * @brief Initializes the FSR volumes and Materials array.
- * @details This method gets an array of OpenMP mutual exclusion locks
- *          for each FSR for use in the transport sweep algorithm.
+ * @details This method releases the FSR locks and private per-thread FSR
+ *          scalar fluxes from a previous simulation. Those needed by the
+ *          flux accumulation scheme are retrieved at the next transport sweep.
  */
 void CPUSolver::initializeFSRs() {
   Solver::initializeFSRs();
-  _FSR_locks = _track_generator->getFSRLocks();
+
+  _FSR_locks = NULL;
+
+  /* Delete old private FSR scalar fluxes if they exist */
+  if (_thread_scalar_flux != NULL)
+    delete [] _thread_scalar_flux;
+
+  _thread_scalar_flux = NULL;
+  _num_thread_fluxes = 0;
+}
+
+
+/**
+ * @brief Allocates zeroed private FSR scalar fluxes for each thread for
+ *        the THREAD_PRIVATE flux accumulation scheme.
+ */
+void CPUSolver::initializeThreadScalarFluxes() {
+
+  if (_thread_scalar_flux != NULL)
+    delete [] _thread_scalar_flux;
+
+  long size = (long)_num_threads * _num_FSRs * _num_groups;
+
+  try {
+    _thread_scalar_flux = new FP_PRECISION[size];
+  }
+  catch(std::exception &e) {
+    log_printf(ERROR, "Could not allocate memory for the private thread "
+               "FSR scalar fluxes");
+  }
+
+  memset(_thread_scalar_flux, 0.0, sizeof(FP_PRECISION) * size);
+  _num_thread_fluxes = _num_threads;
+}
+
+
+/**
+ * @brief Initializes the ExpEvaluator and allocates memory for the
+ *        exponentials of a segment for each thread.
+ */
+void CPUSolver::initializeExpEvaluator() {
+
+  Solver::initializeExpEvaluator();
+
+  /* Delete old exponentials if they exist */
+  if (_thread_exponentials != NULL)
+    delete [] _thread_exponentials;
+
+  _thread_exponentials = new FP_PRECISION[_num_threads * _polar_times_groups];
 }
 
 
@@ -142,20 +386,38 @@ void CPUSolver::initializeFluxArrays() {
   if (_start_flux != NULL)
     delete [] _start_flux;
 
+  if (_boundary_flux_offsets != NULL)
+    delete [] _boundary_flux_offsets;
+
   if (_scalar_flux != NULL)
     delete [] _scalar_flux;
 
   if (_old_scalar_flux != NULL)
     delete [] _old_scalar_flux;
 
+  _start_flux = NULL;
+  _boundary_flux_offsets = NULL;
+  deleteCycleChunks();
+
+  /* The boundary fluxes of spatial domains are exchanged between sweeps */
+  if (_geometry->isDomainDecomposed() &&
+      _boundary_flux_update != DOUBLE_BUFFERED)
+    log_printf(ERROR, "Unable to update the boundary fluxes along the Track "
+               "cycles of a Geometry decomposed into spatial domains");
+
+  /* Store the boundary fluxes along the Track cycles if requested */
+  _num_boundary_fluxes = 2 * (long)_tot_num_tracks * _polar_times_groups;
+  if (_boundary_flux_update != DOUBLE_BUFFERED)
+    initializeCycleChunks();
+
   /* Allocate memory for the Track boundary flux arrays */
   try {
-    int size = 2 * _tot_num_tracks * _polar_times_groups;
-    _boundary_flux = new FP_PRECISION[size];
-    _start_flux = new FP_PRECISION[size];
+    _boundary_flux = new FP_STORAGE[_num_boundary_fluxes];
+    if (_boundary_flux_update == DOUBLE_BUFFERED)
+      _start_flux = new FP_STORAGE[_num_boundary_fluxes];
 
     /* Allocate an array for the FSR scalar flux */
-    size = _num_FSRs * _num_groups;
+    int size = _num_FSRs * _num_groups;
     _scalar_flux = new FP_PRECISION[size];
     _old_scalar_flux = new FP_PRECISION[size];
   }
@@ -182,7 +444,7 @@ void CPUSolver::initializeSourceArrays() {
 
   /* Allocate memory for all source arrays */
   try {
-    _reduced_sources = new FP_PRECISION[size];
+    _reduced_sources = new FP_STORAGE[size];
     _fixed_sources = new FP_PRECISION[size];
   }
   catch(std::exception &e) {
@@ -230,12 +492,115 @@ void CPUSolver::initializeFixedSources() {
 }
 
 
+/**
+ * @brief Splits the TrackGenerator's Track cycles into chunks to be swept in
+ *        parallel from a single boundary flux array.
+ * @details The incoming flux of each Track direction is stored in the order
+ *          of the Track cycles, except for the first Track direction of each
+ *          open cycle which enters through a vacuum boundary. The cycles are
+ *          split into chunks of at most 2 x # Tracks / (# threads x
+ *          CYCLE_CHUNKS_PER_THREAD) Track directions such that the chunks
+ *          may be balanced among the threads. The incoming flux of the first
+ *          Track direction of each chunk is staged in a separate array.
+ */
+void CPUSolver::initializeCycleChunks() {
+
+  if (_track_generator->getNumTrackCycles() == 0)
+    _track_generator->initializeTrackCycles();
+
+  int num_cycles = _track_generator->getNumTrackCycles();
+  int* cycles = _track_generator->getTrackCycles();
+  int* cycle_offsets = _track_generator->getTrackCycleOffsets();
+  int num_directions = 2 * _tot_num_tracks;
+
+  /* Assign an incoming flux to each Track direction in cycle order unless
+   * it starts an open cycle */
+  _boundary_flux_offsets = new long[num_directions];
+  long offset = 0;
+  for (int c=0; c < num_cycles; c++) {
+    int last = cycles[cycle_offsets[c+1]-1];
+    Track* track = _tracks[last / 2];
+    bool closed = (last % 2 == 0) ? track->getTransferFluxOut() :
+                                    track->getTransferFluxIn();
+
+    for (int i=cycle_offsets[c]; i < cycle_offsets[c+1]; i++) {
+      if (i == cycle_offsets[c] && !closed)
+        _boundary_flux_offsets[cycles[i]] = -1;
+      else {
+        _boundary_flux_offsets[cycles[i]] = offset;
+        offset += _polar_times_groups;
+      }
+    }
+  }
+  _num_boundary_fluxes = offset;
+
+  /* Split the cycles into chunks */
+  int max_length = std::max(1, num_directions /
+                            (CYCLE_CHUNKS_PER_THREAD * _num_threads));
+  std::vector<int> chunk_offsets;
+  for (int c=0; c < num_cycles; c++) {
+    for (int i=cycle_offsets[c]; i < cycle_offsets[c+1]; i += max_length)
+      chunk_offsets.push_back(i);
+  }
+
+  _num_cycle_chunks = chunk_offsets.size();
+  _cycle_chunk_offsets = new int[_num_cycle_chunks+1];
+  _cycle_chunk_flux_offsets = new long[_num_cycle_chunks];
+  offset = 0;
+  for (int k=0; k < _num_cycle_chunks; k++) {
+    _cycle_chunk_offsets[k] = chunk_offsets[k];
+    if (_boundary_flux_offsets[cycles[chunk_offsets[k]]] == -1)
+      _cycle_chunk_flux_offsets[k] = -1;
+    else {
+      _cycle_chunk_flux_offsets[k] = offset;
+      offset += _polar_times_groups;
+    }
+  }
+  _cycle_chunk_offsets[_num_cycle_chunks] = num_directions;
+  _cycle_chunk_fluxes = new FP_STORAGE[offset];
+
+  log_printf(INFO, "Storing %ld of %ld boundary angular fluxes along %d Track "
+             "cycles swept in %d chunks", _num_boundary_fluxes,
+             2 * (long)_tot_num_tracks * _polar_times_groups, num_cycles,
+             _num_cycle_chunks);
+}
+
+
+/**
+ * @brief Deletes the chunks of the Track cycles and their staged fluxes.
+ */
+void CPUSolver::deleteCycleChunks() {
+
+  if (_cycle_chunk_offsets != NULL)
+    delete [] _cycle_chunk_offsets;
+
+  if (_cycle_chunk_flux_offsets != NULL)
+    delete [] _cycle_chunk_flux_offsets;
+
+  if (_cycle_chunk_fluxes != NULL)
+    delete [] _cycle_chunk_fluxes;
+
+  _num_cycle_chunks = 0;
+  _cycle_chunk_offsets = NULL;
+  _cycle_chunk_flux_offsets = NULL;
+  _cycle_chunk_fluxes = NULL;
+}
+
+
 /**
  * @brief Zero each Track's boundary fluxes for each energy group
  *        and polar angle in the "forward" and "reverse" directions.
  */
 void CPUSolver::zeroTrackFluxes() {
 
+  /* Zero the single boundary flux array stored along the Track cycles */
+  if (_boundary_flux_offsets != NULL) {
+#pragma omp parallel for schedule(guided)
+    for (long i=0; i < _num_boundary_fluxes; i++)
+      _boundary_flux[i] = 0.0;
+    return;
+  }
+
 #pragma omp parallel for schedule(guided)
   for (int t=0; t < _tot_num_tracks; t++) {
     for (int d=0; d < 2; d++) {
@@ -269,6 +634,30 @@ void CPUSolver::copyBoundaryFluxes() {
 }
 
 
+/**
+ * @brief Copies the incoming flux of the first Track direction of each chunk
+ *        of the Track cycles from the boundary fluxes into its staging array.
+ * @details The first Track direction of a chunk may receive its new incoming
+ *          flux from another chunk before it is swept, so its incoming flux
+ *          for this transport sweep is staged beforehand.
+ */
+void CPUSolver::stageCycleChunkFluxes() {
+
+  int* cycles = _track_generator->getTrackCycles();
+
+#pragma omp parallel for schedule(guided)
+  for (int k=0; k < _num_cycle_chunks; k++) {
+    FP_STORAGE* chunk_flux = getCycleChunkFlux(k);
+    if (chunk_flux == NULL)
+      continue;
+
+    long offset = _boundary_flux_offsets[cycles[_cycle_chunk_offsets[k]]];
+    for (int i=0; i < _polar_times_groups; i++)
+      chunk_flux[i] = _boundary_flux[offset+i];
+  }
+}
+
+
 /**
  * @brief Set the scalar flux for each FSR and energy group to some value.
  * @param value the value to assign to each FSR scalar flux
@@ -283,6 +672,57 @@ void CPUSolver::flattenFSRFluxes(FP_PRECISION value) {
 }
 
 
+/**
+ * @brief Set the scalar flux for each FSR and energy group to the initial
+ *        guess given by setInitialGuess(...).
+ */
+void CPUSolver::loadFSRFluxes() {
+
+  if (_num_initial_fluxes != _num_groups * _num_FSRs)
+    log_printf(ERROR, "Unable to load an initial guess with %d flux values "
+               "for %d groups and %d FSRs", _num_initial_fluxes, _num_groups,
+               _num_FSRs);
+
+#pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    for (int e=0; e < _num_groups; e++)
+      _scalar_flux(r,e) = _initial_fluxes[r*_num_groups+e];
+  }
+}
+
+
+/**
+ * @brief Set each Track's boundary fluxes to the initial guess given by
+ *        setInitialTrackFluxes(...).
+ */
+void CPUSolver::loadTrackFluxes() {
+
+  long size = 2 * (long)_tot_num_tracks * _polar_times_groups;
+  if (_num_initial_track_fluxes != size)
+    log_printf(ERROR, "Unable to load an initial guess with %d Track flux "
+               "values for %ld Track flux values", _num_initial_track_fluxes,
+               size);
+
+  /* Directions entering through vacuum boundaries have no stored flux */
+  if (_boundary_flux_offsets != NULL) {
+#pragma omp parallel for schedule(guided)
+    for (long i=0; i < 2 * (long)_tot_num_tracks; i++) {
+      long offset = _boundary_flux_offsets[i];
+      for (int j=0; offset != -1 && j < _polar_times_groups; j++)
+        _boundary_flux[offset+j] =
+            _initial_track_fluxes[i*_polar_times_groups+j];
+    }
+    return;
+  }
+
+#pragma omp parallel for schedule(guided)
+  for (long i=0; i < size; i++) {
+    _boundary_flux[i] = _initial_track_fluxes[i];
+    _start_flux[i] = _initial_track_fluxes[i];
+  }
+}
+
+
 /**
  * @brief Stores the FSR scalar fluxes in the old scalar flux array.
  */
@@ -325,6 +765,16 @@ void CPUSolver::normalizeFluxes() {
   /* Compute the total fission source */
   tot_fission_source = pairwise_sum<FP_PRECISION>(fission_sources,size);
 
+#ifdef MPIx
+  /* Reduce the total fission source across the spatial domains */
+  if (_geometry->isDomainDecomposed()) {
+    double domain_fission_source = tot_fission_source;
+    MPI_Allreduce(MPI_IN_PLACE, &domain_fission_source, 1, MPI_DOUBLE,
+                  MPI_SUM, _geometry->getMPICart());
+    tot_fission_source = domain_fission_source;
+  }
+#endif
+
   /* Deallocate memory for fission source array */
   delete [] fission_sources;
 
@@ -342,6 +792,14 @@ void CPUSolver::normalizeFluxes() {
     }
   }
 
+  /* Normalize the single boundary flux array stored along the Track cycles */
+  if (_boundary_flux_offsets != NULL) {
+#pragma omp parallel for schedule(guided)
+    for (long i=0; i < _num_boundary_fluxes; i++)
+      _boundary_flux[i] *= norm_factor;
+    return;
+  }
+
   /* Normalize angular boundary fluxes for each Track */
 #pragma omp parallel for schedule(guided)
   for (int t=0; t < _tot_num_tracks; t++) {
@@ -398,9 +856,9 @@ void CPUSolver::computeFSRSources() {
         fission_source /= _k_eff;
 
         /* Compute total (scatter+fission+fixed) reduced source */
-        _reduced_sources(r,g) = _fixed_sources(r,g);
-        _reduced_sources(r,g) += scatter_source + fission_source;
-        _reduced_sources(r,g) *= ONE_OVER_FOUR_PI / sigma_t[g];
+        _reduced_sources(r,g) = (_fixed_sources(r,g) + scatter_source +
+                                 fission_source) * ONE_OVER_FOUR_PI /
+                                sigma_t[g];
       }
     }
 
@@ -443,8 +901,7 @@ void CPUSolver::computeFSRFissionSources() {
                                                     _num_groups);
 
         /* Compute total (fission) reduced source */
-        _reduced_sources(r,g) = fission_source;
-        _reduced_sources(r,g) *= ONE_OVER_FOUR_PI / sigma_t[g];
+        _reduced_sources(r,g) = fission_source * ONE_OVER_FOUR_PI / sigma_t[g];
       }
     }
 
@@ -486,8 +943,7 @@ void CPUSolver::computeFSRScatterSources() {
                                                     _num_groups);
 
         /* Compute total (scatter) reduced source */
-        _reduced_sources(r,g) = scatter_source;
-        _reduced_sources(r,g) *= ONE_OVER_FOUR_PI / sigma_t[g];
+        _reduced_sources(r,g) = scatter_source * ONE_OVER_FOUR_PI / sigma_t[g];
       }
     }
 
@@ -524,7 +980,8 @@ double CPUSolver::computeResidual(residualType res_type) {
 
   else if (res_type == FISSION_SOURCE) {
 
-    if (_num_fissionable_FSRs == 0)
+    /* Spatial domains may hold no fissionable FSRs */
+    if (_num_fissionable_FSRs == 0 && !_geometry->isDomainDecomposed())
       log_printf(ERROR, "The Solver is unable to compute a "
                  "FISSION_SOURCE residual without fissionable FSRs");
 
@@ -610,6 +1067,18 @@ double CPUSolver::computeResidual(residualType res_type) {
 
   /* Sum up the residuals from each FSR and normalize */
   residual = pairwise_sum<double>(residuals, _num_FSRs);
+
+#ifdef MPIx
+  /* Reduce the residuals and number of FSRs across the spatial domains */
+  if (_geometry->isDomainDecomposed()) {
+    double sums[2] = {residual, double(norm)};
+    MPI_Allreduce(MPI_IN_PLACE, sums, 2, MPI_DOUBLE, MPI_SUM,
+                  _geometry->getMPICart());
+    residual = sums[0];
+    norm = int(sums[1]);
+  }
+#endif
+
   residual = sqrt(residual / norm);
 
   /* Deallocate memory for residuals array */
@@ -655,6 +1124,16 @@ void CPUSolver::computeKeff() {
   /* Reduce new fission rates across FSRs */
   fission = pairwise_sum<FP_PRECISION>(FSR_rates, _num_FSRs);
 
+#ifdef MPIx
+  /* Reduce new fission rates across the spatial domains */
+  if (_geometry->isDomainDecomposed()) {
+    double domain_fission = fission;
+    MPI_Allreduce(MPI_IN_PLACE, &domain_fission, 1, MPI_DOUBLE, MPI_SUM,
+                  _geometry->getMPICart());
+    fission = domain_fission;
+  }
+#endif
+
   _k_eff *= fission;
 
   delete [] FSR_rates;
@@ -679,14 +1158,163 @@ void CPUSolver::transportSweep() {
   /* Initialize flux in each FSR to zero */
   flattenFSRFluxes(0.0);
 
-  /* Copy starting flux to current flux */
-  copyBoundaryFluxes();
+  /* Copy starting flux to current flux, or stage the incoming flux of each
+   * chunk of the Track cycles */
+  if (_boundary_flux_offsets != NULL)
+    stageCycleChunkFluxes();
+  else
+    copyBoundaryFluxes();
+
+  /* Build the contiguous segment storage streamed by the sweep unless the
+   * segments are formed on-the-fly */
+  if (_track_generator->getSegmentFormation() == EXPLICIT_2D &&
+      _track_generator->getSegmentStore() == NULL)
+    _track_generator->initializeSegmentStore();
+
+  /* Retrieve the FSR locks or private thread fluxes used to tally */
+  if (_flux_accumulation == FSR_LOCKS && _FSR_locks == NULL)
+    _FSR_locks = _track_generator->getFSRLocks();
+  else if (_flux_accumulation == THREAD_PRIVATE &&
+           _num_thread_fluxes != _num_threads)
+    initializeThreadScalarFluxes();
 
   /* Tracks are traversed and the MOC equations from this CPUSolver are applied
      to all Tracks and corresponding segments */
   TransportSweep sweep_tracks(_track_generator);
   sweep_tracks.setCPUSolver(this);
   sweep_tracks.execute();
+
+  /* Sum the private thread scalar fluxes into the FSR scalar flux */
+  if (_flux_accumulation == THREAD_PRIVATE)
+    reduceThreadScalarFluxes();
+
+#ifdef MPIx
+  /* Exchange the angular fluxes crossing the spatial domain interfaces */
+  if (_geometry->isDomainDecomposed())
+    exchangeBoundaryFluxes();
+
+  /* Sum the scalar fluxes and currents tallied by the azimuthal angles of
+   * each rank */
+  if (_track_generator->isAngularDecomposed()) {
+    MPI_Comm comm = _track_generator->getMPIAngles();
+    MPI_Allreduce(MPI_IN_PLACE, _scalar_flux, _num_FSRs*_num_groups,
+                  MPI_FP_PRECISION, MPI_SUM, comm);
+    if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
+      _cmfd->reduceCurrents(comm);
+  }
+#endif
+}
+
+
+#ifdef MPIx
+/**
+ * @brief Exchanges the angular fluxes leaving this rank's spatial domain
+ *        with the neighboring domains after a transport sweep.
+ * @details The sweep stores the outgoing flux of each Track direction
+ *          leaving through an interface in the starting boundary flux of its
+ *          reflected Track. These fluxes are sent to the neighbor across each
+ *          face, while the fluxes leaving the neighbor through the opposite
+ *          face are received into the starting boundary fluxes of the Track
+ *          directions entering through this face. All outgoing fluxes are
+ *          packed before any incoming flux is unpacked since both may share
+ *          the same boundary fluxes.
+ */
+void CPUSolver::exchangeBoundaryFluxes() {
+
+  int* exits = _track_generator->getInterfaceExits();
+  int* entries = _track_generator->getInterfaceEntries();
+  int* offsets = _track_generator->getInterfaceOffsets();
+  long num_fluxes = long(offsets[NUM_FACES]) * _polar_times_groups;
+  size_t flux_size = _polar_times_groups * sizeof(FP_STORAGE);
+  MPI_Comm comm = _geometry->getMPICart();
+
+  /* Count the messages in Track directions, rather than in bytes or flux
+   * entries, such that the MPI counts cannot overflow */
+  MPI_Datatype flux_type;
+  MPI_Type_contiguous(flux_size, MPI_BYTE, &flux_type);
+  MPI_Type_commit(&flux_type);
+
+  FP_STORAGE* send_fluxes = new FP_STORAGE[num_fluxes];
+  FP_STORAGE* recv_fluxes = new FP_STORAGE[num_fluxes];
+  MPI_Request requests[2*NUM_FACES];
+  int num_requests = 0;
+
+  for (int f=0; f < NUM_FACES; f++) {
+
+    int neighbor = _geometry->getNeighborDomain(f);
+    if (neighbor == -1)
+      continue;
+
+    /* Pack and send the fluxes leaving through this face */
+    for (int i=offsets[f]; i < offsets[f+1]; i++)
+      memcpy(&send_fluxes[long(i)*_polar_times_groups],
+             &_start_flux[long(exits[i])*_polar_times_groups], flux_size);
+
+    MPI_Isend(&send_fluxes[long(offsets[f])*_polar_times_groups],
+              offsets[f+1] - offsets[f], flux_type, neighbor, f, comm,
+              &requests[num_requests++]);
+
+    /* Receive the fluxes leaving the neighbor through the opposite face */
+    int opposite = (f + NUM_FACES/2) % NUM_FACES;
+    MPI_Irecv(&recv_fluxes[long(offsets[opposite])*_polar_times_groups],
+              offsets[opposite+1] - offsets[opposite], flux_type, neighbor,
+              opposite, comm, &requests[num_requests++]);
+  }
+
+  MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
+  MPI_Type_free(&flux_type);
+
+  /* Unpack the received fluxes into the Track directions entering through
+   * each face with a neighbor */
+  for (int f=0; f < NUM_FACES; f++) {
+
+    if (_geometry->getNeighborDomain(f) == -1)
+      continue;
+
+    int opposite = (f + NUM_FACES/2) % NUM_FACES;
+    for (int i=offsets[opposite]; i < offsets[opposite+1]; i++)
+      memcpy(&_start_flux[long(entries[i])*_polar_times_groups],
+             &recv_fluxes[long(i)*_polar_times_groups], flux_size);
+  }
+
+  delete [] send_fluxes;
+  delete [] recv_fluxes;
+}
+#endif
+
+
+/**
+ * @brief Increments the scalar flux in an FSR from a temporary buffer with
+ *        the flux accumulation scheme set for this CPUSolver.
+ * @param fsr_id the ID of the FSR to increment
+ * @param fsr_flux a pointer to the temporary FSR flux buffer
+ */
+void CPUSolver::accumulateScalarFlux(int fsr_id, FP_PRECISION* fsr_flux) {
+
+  if (_flux_accumulation == ATOMIC_UPDATES)
+    accumulateScalarFluxFixed<0, ATOMIC_UPDATES>(fsr_id, fsr_flux);
+  else if (_flux_accumulation == THREAD_PRIVATE)
+    accumulateScalarFluxFixed<0, THREAD_PRIVATE>(fsr_id, fsr_flux);
+  else
+    accumulateScalarFluxFixed<0, FSR_LOCKS>(fsr_id, fsr_flux);
+}
+
+
+/**
+ * @brief Sums the private thread FSR scalar fluxes into the FSR scalar flux
+ *        and zeroes them for the next transport sweep.
+ */
+void CPUSolver::reduceThreadScalarFluxes() {
+
+  long size = (long)_num_FSRs * _num_groups;
+
+#pragma omp parallel for schedule(static)
+  for (long i=0; i < size; i++) {
+    for (int t=0; t < _num_thread_fluxes; t++) {
+      _scalar_flux[i] += _thread_scalar_flux[t*size+i];
+      _thread_scalar_flux[t*size+i] = 0.0;
+    }
+  }
 }
 
 
@@ -695,58 +1323,46 @@ void CPUSolver::transportSweep() {
  * @details This method integrates the angular flux for a Track segment across
  *          energy groups and polar angles, and tallies it into the FSR
  *          scalar flux, and updates the Track's angular flux.
- * @param curr_segment a pointer to the Track segment of interest
+ * @param length the length of the Track segment
+ * @param fsr_id the ID of the FSR in which the segment resides
+ * @param sigma_t the total cross-sections of the segment's Material
  * @param azim_index a pointer to the azimuthal angle index for this segment
  * @param track_flux a pointer to the Track's angular flux
  * @param fsr_flux a pointer to the temporary FSR flux buffer
- * @param fwd
  */
-void CPUSolver::tallyScalarFlux(segment* curr_segment, int azim_index,
+void CPUSolver::tallyScalarFlux(FP_PRECISION length, int fsr_id,
+                                FP_PRECISION* sigma_t, int azim_index,
                                 FP_PRECISION* track_flux,
                                 FP_PRECISION* fsr_flux) {
 
-  int fsr_id = curr_segment->_region_id;
-  FP_PRECISION length = curr_segment->_length;
-  FP_PRECISION* sigma_t = curr_segment->_material->getSigmaT();
-  FP_PRECISION delta_psi, exponential;
-
-  /* Set the FSR scalar flux buffer to zero */
-  memset(fsr_flux, 0.0, _num_groups * sizeof(FP_PRECISION));
-
-  /* Compute change in angular flux along segment in this FSR */
-  for (int e=0; e < _num_groups; e++) {
-    for (int p=0; p < _num_polar_2; p++) {
-      exponential = _exp_evaluator->computeExponential(sigma_t[e] * length, p);
-      delta_psi = (track_flux(p,e)-_reduced_sources(fsr_id,e)) * exponential;
-      fsr_flux[e] += delta_psi * _quadrature->getWeightInline(azim_index, p);
-      track_flux(p,e) -= delta_psi;
-    }
-  }
-
-  /* Atomically increment the FSR scalar flux from the temporary array */
-  omp_set_lock(&_FSR_locks[fsr_id]);
-  {
-    for (int e=0; e < _num_groups; e++)
-      _scalar_flux(fsr_id,e) += fsr_flux[e];
-  }
-  omp_unset_lock(&_FSR_locks[fsr_id]);
+  if (_flux_accumulation == ATOMIC_UPDATES)
+    tallyScalarFluxFixed<0, 0, ATOMIC_UPDATES>(length, fsr_id, sigma_t,
+                                               azim_index, track_flux,
+                                               fsr_flux);
+  else if (_flux_accumulation == THREAD_PRIVATE)
+    tallyScalarFluxFixed<0, 0, THREAD_PRIVATE>(length, fsr_id, sigma_t,
+                                               azim_index, track_flux,
+                                               fsr_flux);
+  else
+    tallyScalarFluxFixed<0, 0, FSR_LOCKS>(length, fsr_id, sigma_t,
+                                          azim_index, track_flux, fsr_flux);
 }
 
 
 /**
  * @brief Tallies the current contribution from this segment across the
  *        the appropriate CMFD mesh cell surface.
- * @param curr_segment a pointer to the Track segment of interest
+ * @param cmfd_surface the CMFD surface crossed in the direction of travel
  * @param azim_index the azimuthal index for this segmenbt
  * @param track_flux a pointer to the Track's angular flux
  * @param fwd boolean indicating direction of integration along segment
  */
-void CPUSolver::tallyCurrent(segment* curr_segment, int azim_index,
+void CPUSolver::tallyCurrent(int cmfd_surface, int azim_index,
                              FP_PRECISION* track_flux, bool fwd) {
 
   /* Tally surface currents if CMFD is in use */
-  if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
-    _cmfd->tallyCurrent(curr_segment, track_flux, azim_index, fwd);
+  if (cmfd_surface != -1 && isTallyingCurrents())
+    tallyCurrentFixed(cmfd_surface, azim_index, track_flux);
 }
 
 
@@ -765,31 +1381,20 @@ void CPUSolver::transferBoundaryFlux(int track_id,
                                      int azim_index,
                                      bool direction,
                                      FP_PRECISION* track_flux) {
-  int start;
-  bool transfer_flux;
-  int track_out_id;
-
-  /* For the "forward" direction */
-  if (direction) {
-    start = _tracks[track_id]->isNextOut() * _polar_times_groups;
-    transfer_flux = _tracks[track_id]->getTransferFluxOut();
-    track_out_id = _tracks[track_id]->getTrackOut()->getUid();
-  }
-
-  /* For the "reverse" direction */
-  else {
-    start = _tracks[track_id]->isNextIn() * _polar_times_groups;
-    transfer_flux = _tracks[track_id]->getTransferFluxIn();
-    track_out_id = _tracks[track_id]->getTrackIn()->getUid();
-  }
+  transferBoundaryFluxFixed<0, 0>(track_id, azim_index, direction, track_flux);
+}
 
-  FP_PRECISION* track_out_flux = &_start_flux(track_out_id, 0, 0, start);
 
-  /* Loop over polar angles and energy groups */
-  for (int e=0; e < _num_groups; e++) {
-    for (int p=0; p < _num_polar_2; p++)
-      track_out_flux(p,e) = track_flux(p,e) * transfer_flux;
-  }
+/**
+ * @brief Returns whether the TransportSweep may call the templated MOC
+ *        kernels rather than the virtual tallyScalarFlux(...) and
+ *        transferBoundaryFlux(...) methods.
+ * @details Subclasses which override the virtual MOC kernels should return
+ *          false so that their kernels are used in the transport sweep.
+ * @return whether the templated MOC kernels are used
+ */
+bool CPUSolver::usesTemplatedKernels() {
+  return true;
 }
 
 
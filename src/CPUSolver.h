@@ -13,9 +13,11 @@
 #define _USE_MATH_DEFINES
 #include "Solver.h"
 #include "TrackTraversingAlgorithms.h"
+#include "flux_accumulation_type.h"
 #include <math.h>
 #include <omp.h>
 #include <stdlib.h>
+#include <vector>
 #endif
 
 
@@ -30,6 +32,31 @@
 #define track_out_flux(p,e) (track_out_flux[(p)*_num_groups + (e)])
 
 
+/**
+ * @enum boundaryFluxUpdateType
+ * @brief The storage and update of the Track boundary angular fluxes during
+ *        a transport sweep.
+ */
+enum boundaryFluxUpdateType {
+
+  /** Sweep the incoming fluxes of one array while transferring the outgoing
+   *  fluxes into a second array, which is copied into the first before each
+   *  transport sweep */
+  DOUBLE_BUFFERED,
+
+  /** Sweep the Tracks along the TrackGenerator's Track cycles with a single
+   *  array, holding no flux for Tracks entering through vacuum boundaries,
+   *  with each incoming flux staged by the thread before it is overwritten */
+  SINGLE_BUFFERED,
+
+  /** Sweep the Tracks along the Track cycles with a single array as for
+   *  SINGLE_BUFFERED, with each Track direction swept with the outgoing flux
+   *  of the previous Track direction in the same transport sweep */
+  GAUSS_SEIDEL
+
+};
+
+
 /**
  * @class CPUSolver CPUSolver.h "src/CPUSolver.h"
  * @brief This a subclass of the Solver class for multi-core CPUs using
@@ -42,30 +69,78 @@ protected:
   /** The number of shared memory OpenMP threads */
   int _num_threads;
 
+  /** The scheme used to accumulate the FSR scalar fluxes in a sweep */
+  fluxAccumulationType _flux_accumulation;
+
   /** OpenMP mutual exclusion locks for atomic FSR scalar flux updates */
   omp_lock_t* _FSR_locks;
 
+  /** Private FSR scalar flux tallies for each thread (THREAD_PRIVATE) */
+  FP_PRECISION* _thread_scalar_flux;
+
+  /** The number of threads the private FSR scalar fluxes were sized for */
+  int _num_thread_fluxes;
+
+  /** The exponentials for a segment in each polar angle and energy group
+   *  for each thread */
+  FP_PRECISION* _thread_exponentials;
+
+  /** The storage and update of the boundary fluxes during a sweep */
+  boundaryFluxUpdateType _boundary_flux_update;
+
+  /** The number of angular flux values in the boundary flux array */
+  long _num_boundary_fluxes;
+
+  /** The number of chunks into which the Track cycles are split to be swept
+   *  in parallel with SINGLE_BUFFERED or GAUSS_SEIDEL boundary fluxes, or
+   *  zero */
+  int _num_cycle_chunks;
+
+  /** The offset of each chunk in the TrackGenerator's Track cycles, with the
+   *  number of Track directions in the last entry */
+  int* _cycle_chunk_offsets;
+
+  /** The offset of each chunk's staged incoming flux, or -1 if the chunk's
+   *  first Track direction enters through a vacuum boundary */
+  long* _cycle_chunk_flux_offsets;
+
+  /** The incoming flux of the first Track direction of each chunk, staged
+   *  before each sweep since it may be overwritten by another chunk */
+  FP_STORAGE* _cycle_chunk_fluxes;
+
+  void initializeThreadScalarFluxes();
+  void initializeCycleChunks();
+  void deleteCycleChunks();
+  void accumulateScalarFlux(int fsr_id, FP_PRECISION* fsr_flux);
+  template <int NUM_GROUPS, fluxAccumulationType ACCUMULATION>
+  void accumulateScalarFluxFixed(int fsr_id, FP_PRECISION* fsr_flux);
+  void reduceThreadScalarFluxes();
+
 public:
   CPUSolver(TrackGenerator* track_generator=NULL);
+  virtual ~CPUSolver();
 
   /**
    * @brief Computes the contribution to the FSR flux from a Track segment.
-   * @param curr_segment a pointer to the Track segment of interest
+   * @param length the length of the Track segment
+   * @param fsr_id the ID of the FSR in which the segment resides
+   * @param sigma_t the total cross-sections of the segment's Material
    * @param azim_index a pointer to the azimuthal angle index for this segment
    * @param track_flux a pointer to the Track's angular flux
    * @param fsr_flux a pointer to the temporary FSR scalar flux buffer
    */
-  virtual void tallyScalarFlux(segment* curr_segment, int azim_index,
+  virtual void tallyScalarFlux(FP_PRECISION length, int fsr_id,
+                               FP_PRECISION* sigma_t, int azim_index,
                                FP_PRECISION* track_flux, FP_PRECISION* fsr_flux);
 
   /**
    * @brief Computes the contribution to surface current from a segment.
-   * @param curr_segment a pointer to the Track segment of interest
+   * @param cmfd_surface the CMFD surface crossed in the direction of travel
    * @param azim_index a pointer to the azimuthal angle index for this segment
    * @param track_flux a pointer to the Track's angular flux
    * @param fwd the direction of integration along the segment
    */
-  virtual void tallyCurrent(segment* curr_segment, int azim_index,
+  virtual void tallyCurrent(int cmfd_surface, int azim_index,
                             FP_PRECISION* track_flux, bool fwd);
 
   /**
@@ -78,12 +153,37 @@ public:
   virtual void transferBoundaryFlux(int track_id, int azim_index,
                                     bool direction, FP_PRECISION* track_flux);
 
+  template <int NUM_GROUPS, int NUM_POLAR_2,
+            fluxAccumulationType ACCUMULATION>
+  void tallyScalarFluxFixed(FP_PRECISION length, int fsr_id,
+                            FP_PRECISION* sigma_t, int azim_index,
+                            FP_PRECISION* track_flux, FP_PRECISION* fsr_flux);
+
+  bool isTallyingCurrents();
+  void tallyCurrentFixed(int cmfd_surface, int azim_index,
+                         FP_PRECISION* track_flux);
+
+  template <int NUM_GROUPS, int NUM_POLAR_2>
+  void transferBoundaryFluxFixed(int track_id, int azim_index,
+                                 bool direction, FP_PRECISION* track_flux);
+
+  virtual bool usesTemplatedKernels();
+
   int getNumThreads();
+  fluxAccumulationType getFluxAccumulation();
+  boundaryFluxUpdateType getBoundaryFluxUpdate();
+  int getNumCycleChunks();
+  int* getCycleChunkOffsets();
+  FP_STORAGE* getCycleChunkFlux(int chunk);
   virtual void getFluxes(FP_PRECISION* out_fluxes, int num_fluxes);
+  virtual void getTrackFluxes(double* out_track_fluxes, int num_track_fluxes);
 
   void setNumThreads(int num_threads);
+  void setFluxAccumulation(fluxAccumulationType accumulation);
+  void setBoundaryFluxUpdate(boundaryFluxUpdateType update);
   virtual void setFluxes(FP_PRECISION* in_fluxes, int num_fluxes);
 
+  void initializeExpEvaluator();
   void initializeFluxArrays();
   void initializeSourceArrays();
   void initializeFixedSources();
@@ -91,13 +191,19 @@ public:
 
   void zeroTrackFluxes();
   void copyBoundaryFluxes();
+  void stageCycleChunkFluxes();
   void flattenFSRFluxes(FP_PRECISION value);
+  void loadFSRFluxes();
+  void loadTrackFluxes();
   void storeFSRFluxes();
   void normalizeFluxes();
   void computeFSRSources();
   void computeFSRFissionSources();
   void computeFSRScatterSources();
   void transportSweep();
+#ifdef MPIx
+  void exchangeBoundaryFluxes();
+#endif
   void addSourceToScalarFlux();
   void computeKeff();
   double computeResidual(residualType res_type);
@@ -106,4 +212,171 @@ public:
 };
 
 
+/**
+ * @brief Computes the contribution to the FSR flux from a Track segment for
+ *        a number of energy groups and polar angles fixed at compile time.
+ * @details Fixing the loop bounds allows the compiler to fully unroll and
+ *          vectorize the loops over energy groups and polar angles. A
+ *          template parameter of zero uses the runtime number of energy
+ *          groups or polar angles instead. The flux accumulation scheme is
+ *          also fixed such that it is not branched on for each segment.
+ * @param length the length of the Track segment
+ * @param fsr_id the ID of the FSR in which the segment resides
+ * @param sigma_t the total cross-sections of the segment's Material
+ * @param azim_index the azimuthal angle index for this segment
+ * @param track_flux a pointer to the Track's angular flux
+ * @param fsr_flux a pointer to the temporary FSR scalar flux buffer
+ */
+template <int NUM_GROUPS, int NUM_POLAR_2, fluxAccumulationType ACCUMULATION>
+inline void CPUSolver::tallyScalarFluxFixed(FP_PRECISION length, int fsr_id,
+                                            FP_PRECISION* sigma_t,
+                                            int azim_index,
+                                            FP_PRECISION* track_flux,
+                                            FP_PRECISION* fsr_flux) {
+
+  const int num_groups = (NUM_GROUPS > 0) ? NUM_GROUPS : _num_groups;
+  const int num_polar_2 = (NUM_POLAR_2 > 0) ? NUM_POLAR_2 : _num_polar_2;
+  FP_STORAGE* reduced_sources = &_reduced_sources[fsr_id*num_groups];
+  FP_PRECISION* exponentials =
+      &_thread_exponentials[omp_get_thread_num()*_polar_times_groups];
+  FP_PRECISION delta_psi, weight;
+
+  /* Compute the exponentials for all energy groups and polar angles */
+  _exp_evaluator->computeExponentials(length, sigma_t, num_groups,
+                                      num_polar_2, exponentials);
+
+  /* Set the FSR scalar flux buffer to zero */
+  for (int e=0; e < num_groups; e++)
+    fsr_flux[e] = 0.;
+
+  /* Compute change in angular flux along segment in this FSR */
+  for (int p=0; p < num_polar_2; p++) {
+    weight = _quadrature->getWeightInline(azim_index, p);
+    for (int e=0; e < num_groups; e++) {
+      delta_psi = (track_flux[p*num_groups+e] - reduced_sources[e]) *
+          exponentials[p*num_groups+e];
+      fsr_flux[e] += delta_psi * weight;
+      track_flux[p*num_groups+e] -= delta_psi;
+    }
+  }
+
+  /* Atomically increment the FSR scalar flux from the temporary array */
+  accumulateScalarFluxFixed<NUM_GROUPS, ACCUMULATION>(fsr_id, fsr_flux);
+}
+
+
+/**
+ * @brief Increments the scalar flux in an FSR from a temporary buffer with
+ *        a flux accumulation scheme and number of energy groups fixed at
+ *        compile time.
+ * @details A NUM_GROUPS template parameter of zero uses the runtime number
+ *          of energy groups instead.
+ * @param fsr_id the ID of the FSR to increment
+ * @param fsr_flux a pointer to the temporary FSR flux buffer
+ */
+template <int NUM_GROUPS, fluxAccumulationType ACCUMULATION>
+inline void CPUSolver::accumulateScalarFluxFixed(int fsr_id,
+                                                 FP_PRECISION* fsr_flux) {
+
+  const int num_groups = (NUM_GROUPS > 0) ? NUM_GROUPS : _num_groups;
+
+  if (ACCUMULATION == ATOMIC_UPDATES) {
+    for (int e=0; e < num_groups; e++) {
+#pragma omp atomic update
+      _scalar_flux(fsr_id,e) += fsr_flux[e];
+    }
+  }
+
+  else if (ACCUMULATION == THREAD_PRIVATE) {
+    long offset = ((long)omp_get_thread_num() * _num_FSRs + fsr_id)
+        * num_groups;
+    FP_PRECISION* thread_flux = &_thread_scalar_flux[offset];
+    for (int e=0; e < num_groups; e++)
+      thread_flux[e] += fsr_flux[e];
+  }
+
+  else {
+    omp_set_lock(&_FSR_locks[fsr_id]);
+    {
+      for (int e=0; e < num_groups; e++)
+        _scalar_flux(fsr_id,e) += fsr_flux[e];
+    }
+    omp_unset_lock(&_FSR_locks[fsr_id]);
+  }
+}
+
+
+/**
+ * @brief Returns whether CMFD surface currents are tallied in the transport
+ *        sweep.
+ * @return whether a CMFD mesh with flux updates is in use
+ */
+inline bool CPUSolver::isTallyingCurrents() {
+  return _cmfd != NULL && _cmfd->isFluxUpdateOn();
+}
+
+
+/**
+ * @brief Tallies the current contribution from a segment across a CMFD mesh
+ *        cell surface without virtual dispatch.
+ * @details This must only be called for segments crossing a CMFD surface
+ *          when isTallyingCurrents() is true.
+ * @param cmfd_surface the CMFD surface crossed in the direction of travel
+ * @param azim_index the azimuthal angle index for this segment
+ * @param track_flux a pointer to the Track's angular flux
+ */
+inline void CPUSolver::tallyCurrentFixed(int cmfd_surface, int azim_index,
+                                         FP_PRECISION* track_flux) {
+  _cmfd->tallyCurrent(cmfd_surface, track_flux, azim_index);
+}
+
+
+/**
+ * @brief Updates the boundary flux for a Track given boundary conditions for
+ *        a number of energy groups and polar angles fixed at compile time.
+ * @details A template parameter of zero uses the runtime number of energy
+ *          groups or polar angles instead.
+ * @param track_id the ID number for the Track of interest
+ * @param azim_index the azimuthal angle index for this segment
+ * @param direction the Track direction (forward - true, reverse - false)
+ * @param track_flux a pointer to the Track's outgoing angular flux
+ */
+template <int NUM_GROUPS, int NUM_POLAR_2>
+inline void CPUSolver::transferBoundaryFluxFixed(int track_id, int azim_index,
+                                                 bool direction,
+                                                 FP_PRECISION* track_flux) {
+
+  const int num_groups = (NUM_GROUPS > 0) ? NUM_GROUPS : _num_groups;
+  const int num_polar_2 = (NUM_POLAR_2 > 0) ? NUM_POLAR_2 : _num_polar_2;
+  const int polar_times_groups = num_groups * num_polar_2;
+  int start;
+  bool transfer_flux;
+  int track_out_id;
+
+  /* For the "forward" direction */
+  if (direction) {
+    start = _tracks[track_id]->isNextOut() * polar_times_groups;
+    transfer_flux = _tracks[track_id]->getTransferFluxOut();
+    track_out_id = _tracks[track_id]->getTrackOut()->getUid();
+  }
+
+  /* For the "reverse" direction */
+  else {
+    start = _tracks[track_id]->isNextIn() * polar_times_groups;
+    transfer_flux = _tracks[track_id]->getTransferFluxIn();
+    track_out_id = _tracks[track_id]->getTrackIn()->getUid();
+  }
+
+  FP_STORAGE* track_out_flux =
+      &_start_flux[track_out_id*2*polar_times_groups + start];
+
+  /* Loop over polar angles and energy groups */
+  for (int e=0; e < num_groups; e++) {
+    for (int p=0; p < num_polar_2; p++)
+      track_out_flux[p*num_groups+e] = track_flux[p*num_groups+e] *
+          transfer_flux;
+  }
+}
+
+
 #endif /* CPUSOLVER_H_ */
@@ -639,7 +639,7 @@ std::map<int, surface_halfspace*> Cell::getSurfaces() const {
  * @brief Return the std::vector of neighbor Cells to this Cell.
  * @return std::vector of neighbor Cell pointers
  */
-std::vector<Cell*> Cell::getNeighbors() const {
+const std::vector<Cell*>& Cell::getNeighbors() const {
   return _neighbors;
 }
 
@@ -973,6 +973,7 @@ void Cell::addSurface(int halfspace, Surface* surface) {
   new_surf_half->_halfspace = halfspace;
 
   _surfaces[surface->getId()] = new_surf_half;
+  buildCellSurfaces();
 }
 
 
@@ -985,6 +986,32 @@ void Cell::removeSurface(Surface* surface) {
   if (_surfaces.find(surface->getId()) != _surfaces.end()) {
     delete _surfaces[surface->getId()];
     _surfaces.erase(surface->getId());
+    buildCellSurfaces();
+  }
+}
+
+
+/**
+ * @brief Collects this Cell's bounding Surfaces with their types in a flat
+ *        array used to test points against the Surfaces.
+ * @details Planes and ZCylinders are evaluated from the coefficients read
+ *          through their Surface, such that Surfaces moved after they were
+ *          added to the Cell are evaluated at their new location. Any other
+ *          Surface is evaluated through its virtual methods. The array is
+ *          rebuilt when a Surface is added to or removed from the Cell.
+ */
+void Cell::buildCellSurfaces() {
+
+  _cell_surfaces.clear();
+
+  std::map<int, surface_halfspace*>::iterator iter;
+  for (iter = _surfaces.begin(); iter != _surfaces.end(); ++iter) {
+
+    cell_surface surface;
+    surface._surface = iter->second->_surface;
+    surface._type = surface._surface->getSurfaceType();
+    surface._halfspace = iter->second->_halfspace;
+    _cell_surfaces.push_back(surface);
   }
 }
 
@@ -1010,14 +1037,32 @@ void Cell::addNeighborCell(Cell* cell) {
  */
 bool Cell::containsPoint(Point* point) {
 
+  double x = point->getX();
+  double y = point->getY();
+  double z = point->getZ();
+  double value;
+
   /* Loop over all Surfaces inside the Cell */
-  std::map<int, surface_halfspace*>::iterator iter;
+  for (int i=0; i < _cell_surfaces.size(); i++) {
 
-  for (iter = _surfaces.begin(); iter != _surfaces.end(); ++iter) {
+    const cell_surface& surface = _cell_surfaces[i];
+
+    /* Evaluate the Surface's potential equation at the Point */
+    if (surface._type == ZCYLINDER) {
+      ZCylinder* zcylinder = static_cast<ZCylinder*>(surface._surface);
+      double dx = x - zcylinder->_center.getX();
+      double dy = y - zcylinder->_center.getY();
+      value = dx * dx + dy * dy - zcylinder->_radius * zcylinder->_radius;
+    }
+    else if (surface._type != QUADRATIC) {
+      Plane* plane = static_cast<Plane*>(surface._surface);
+      value = plane->_A * x + plane->_B * y + plane->_C * z + plane->_D;
+    }
+    else
+      value = surface._surface->evaluate(point);
 
     /* Return false if the Point is not in the correct Surface halfspace */
-    if (iter->second->_surface->evaluate(point) * iter->second->_halfspace
-        < 0.0)
+    if (value * surface._halfspace < 0.0)
       return false;
   }
 
@@ -1038,6 +1083,78 @@ bool Cell::containsCoords(LocalCoords* coords) {
 }
 
 
+/**
+ * @brief Determines whether a Cell may overlap a box in the x-y plane.
+ * @details Each Plane and ZCylinder of the Cell is checked for whether its
+ *          halfspace overlaps the box. Other Surfaces, and Planes which are
+ *          not parallel to the z-axis, are assumed to overlap it. The Cell
+ *          certainly does not overlap the box if any halfspace does not, but
+ *          may not overlap it even if all halfspaces do. The box may extend
+ *          to infinity.
+ * @param min_x the minimum x-coordinate of the box
+ * @param max_x the maximum x-coordinate of the box
+ * @param min_y the minimum y-coordinate of the box
+ * @param max_y the maximum y-coordinate of the box
+ * @return false if the Cell does not overlap the box, true if it may
+ */
+bool Cell::mayOverlapBox(double min_x, double max_x, double min_y,
+                         double max_y) {
+
+  std::map<int, surface_halfspace*>::iterator iter;
+
+  for (iter = _surfaces.begin(); iter != _surfaces.end(); ++iter) {
+
+    Surface* surface = iter->second->_surface;
+    int halfspace = iter->second->_halfspace;
+    surfaceType type = surface->getSurfaceType();
+
+    /* A Plane's halfspace overlaps the box if it contains the corner
+     * furthest into the halfspace */
+    if (type == PLANE || type == XPLANE || type == YPLANE) {
+      Plane* plane = static_cast<Plane*>(surface);
+      if (plane->getC() != 0.)
+        continue;
+
+      double a = halfspace * plane->getA();
+      double b = halfspace * plane->getB();
+      double max_value = halfspace * plane->getD();
+      if (a != 0.)
+        max_value += a * ((a > 0.) ? max_x : min_x);
+      if (b != 0.)
+        max_value += b * ((b > 0.) ? max_y : min_y);
+
+      if (max_value < 0.)
+        return false;
+    }
+
+    /* A ZCylinder's inside overlaps the box if the nearest point of the box
+     * is inside it, and its outside if the farthest corner is outside it */
+    else if (type == ZCYLINDER) {
+      ZCylinder* zcylinder = static_cast<ZCylinder*>(surface);
+      double x0 = zcylinder->getX0();
+      double y0 = zcylinder->getY0();
+      double r2 = zcylinder->getRadius() * zcylinder->getRadius();
+      double dx, dy;
+
+      if (halfspace == -1) {
+        dx = std::max(std::max(min_x - x0, x0 - max_x), 0.);
+        dy = std::max(std::max(min_y - y0, y0 - max_y), 0.);
+        if (dx * dx + dy * dy > r2)
+          return false;
+      }
+      else {
+        dx = std::max(x0 - min_x, max_x - x0);
+        dy = std::max(y0 - min_y, max_y - y0);
+        if (dx * dx + dy * dy < r2)
+          return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+
 /**
  * @brief Computes the minimum distance to a Surface from a point with a given
  *        trajectory at a certain angle stored in a LocalCoords object.
@@ -1050,13 +1167,32 @@ double Cell::minSurfaceDist(LocalCoords* coords) {
   double curr_dist;
   double min_dist = INFINITY;
 
-  std::map<int, surface_halfspace*>::iterator iter;
+  double x = coords->getX();
+  double y = coords->getY();
+  double z = coords->getZ();
+  double cos_phi = cos(coords->getPhi());
+  double sin_phi = sin(coords->getPhi());
 
   /* Loop over all of the Cell's Surfaces */
-  for (iter = _surfaces.begin(); iter != _surfaces.end(); ++iter) {
+  for (int i=0; i < _cell_surfaces.size(); i++) {
+
+    const cell_surface& surface = _cell_surfaces[i];
 
     /* Find the minimum distance from this surface to this Point */
-    curr_dist = iter->second->_surface->getMinDistance(coords);
+    if (surface._type == ZCYLINDER) {
+      ZCylinder* zcylinder = static_cast<ZCylinder*>(surface._surface);
+      curr_dist = zcylinderDistance(zcylinder->_center.getX(),
+                                    zcylinder->_center.getY(),
+                                    zcylinder->_radius * zcylinder->_radius,
+                                    x, y, cos_phi, sin_phi);
+    }
+    else if (surface._type != QUADRATIC) {
+      Plane* plane = static_cast<Plane*>(surface._surface);
+      curr_dist = planeDistance(plane->_A, plane->_B, plane->_C, plane->_D,
+                                x, y, z, cos_phi, sin_phi);
+    }
+    else
+      curr_dist = surface._surface->getMinDistance(coords);
 
     /* If the distance to Cell is less than current min distance, update */
     if (curr_dist < min_dist)
@@ -1123,8 +1259,10 @@ Cell* Cell::clone() {
 /**
  * @brief Subdivides the Cell into clones for fuel pin angular sectors.
  * @param subcells an empty vector to store all subcells
+ * @param planes an empty vector to store the Planes bounding the sectors
  */
-void Cell::sectorize(std::vector<Cell*>& subcells) {
+void Cell::sectorize(std::vector<Cell*>& subcells,
+                     std::vector<Plane*>& planes) {
 
   /* If the user didn't request any sectors, don't make any */
   if (_num_sectors == 0)
@@ -1134,9 +1272,6 @@ void Cell::sectorize(std::vector<Cell*>& subcells) {
   double delta_azim = 2. * M_PI / _num_sectors;
   double A, B;
 
-  /* A container for each of the bounding planes for the sector Cells */
-  std::vector<Plane*> planes;
-
   log_printf(DEBUG, "Sectorizing Cell %d with %d sectors",_id, _num_sectors);
 
   /* Create each of the bounding planes for the sector Cells */
@@ -1187,8 +1322,11 @@ void Cell::sectorize(std::vector<Cell*>& subcells) {
  * @brief Subdivides the Cell into clones for fuel pin rings.
  * @param subcells an empty vector to store all subcells
  * @param max_radius the maximum allowable radius used in the subdivisions
+ * @param zcylinders an empty vector to store the ZCylinders bounding the
+ *        rings from the outside, from the outermost ring inward
  */
-void Cell::ringify(std::vector<Cell*>& subcells, double max_radius) {
+void Cell::ringify(std::vector<Cell*>& subcells, double max_radius,
+                   std::vector<ZCylinder*>& zcylinders) {
 
   /* If the user didn't request any rings, don't make any */
   if (_num_rings == 0)
@@ -1205,7 +1343,6 @@ void Cell::ringify(std::vector<Cell*>& subcells, double max_radius) {
   double y2 = 0.;
   int halfspace1 = 0;
   int halfspace2 = 0;
-  std::vector<ZCylinder*> zcylinders;
   std::vector<Cell*> rings;
 
   /* See if the Cell contains 1 or 2 ZCYLINDER Surfaces */
@@ -1380,8 +1517,12 @@ void Cell::subdivideCell(double max_radius) {
   /** A container of all Cell clones created for rings and sectors */
   std::vector<Cell*> subcells;
 
-  sectorize(subcells);
-  ringify(subcells, max_radius);
+  /* The Surfaces bounding the rings and sectors */
+  std::vector<ZCylinder*> zcylinders;
+  std::vector<Plane*> planes;
+
+  sectorize(subcells, planes);
+  ringify(subcells, max_radius, zcylinders);
 
   /* Put any ring / sector subcells in a new Universe fill */
   if (subcells.size() != 0) {
@@ -1394,6 +1535,9 @@ void Cell::subdivideCell(double max_radius) {
     for (iter = subcells.begin(); iter != subcells.end(); ++iter)
       new_fill->addCell(*iter);
 
+    /* Describe the rings and sectors to find the subcells arithmetically */
+    new_fill->setSubdivision(subcells, zcylinders, planes);
+
     /* Set the new Universe as the fill for this Cell */
     setFill(new_fill);
   }
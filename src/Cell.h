@@ -23,6 +23,8 @@
 /* Forward declarations to resolve circular dependencies */
 class Universe;
 class Surface;
+class Plane;
+class ZCylinder;
 
 int cell_id();
 void reset_cell_id();
@@ -45,6 +47,26 @@ struct surface_halfspace {
 };
 
 
+/**
+ * @struct cell_surface
+ * @brief A cell_surface holds a Surface bounding a Cell along with its type,
+ *        such that the Cell can read the coefficients of its Planes and
+ *        ZCylinders without virtual calls.
+ */
+struct cell_surface {
+
+  /** The surfaceType of the Surface, which determines its coefficients */
+  int _type;
+
+  /** The halfspace associated with this surface */
+  int _halfspace;
+
+  /** A pointer to the Surface object */
+  Surface* _surface;
+
+};
+
+
 
 /**
  * @enum cellType
@@ -122,11 +144,16 @@ private:
   /** Map of bounding Surface IDs with pointers and halfspaces (+/-1) */
   std::map<int, surface_halfspace*> _surfaces;
 
+  /** The bounding Surfaces with their types in the order of their IDs */
+  std::vector<cell_surface> _cell_surfaces;
+
   /* Vector of neighboring Cells */
   std::vector<Cell*> _neighbors;
 
-  void ringify(std::vector<Cell*>& subcells, double max_radius);
-  void sectorize(std::vector<Cell*>& subcells);
+  void buildCellSurfaces();
+  void ringify(std::vector<Cell*>& subcells, double max_radius,
+               std::vector<ZCylinder*>& zcylinders);
+  void sectorize(std::vector<Cell*>& subcells, std::vector<Plane*>& planes);
 
 public:
   Cell(int id=0, const char* name="");
@@ -163,7 +190,7 @@ public:
   boundaryType getMaxYBoundaryType();
   int getNumSurfaces() const;
   std::map<int, surface_halfspace*> getSurfaces() const;
-  std::vector<Cell*> getNeighbors() const;
+  const std::vector<Cell*>& getNeighbors() const;
   bool hasParent();
   Cell* getParent();
   Cell* getOldestAncestor();
@@ -190,6 +217,7 @@ public:
   bool isFissionable();
   bool containsPoint(Point* point);
   bool containsCoords(LocalCoords* coords);
+  bool mayOverlapBox(double min_x, double max_x, double min_y, double max_y);
   double minSurfaceDist(LocalCoords* coords);
 
   Cell* clone();
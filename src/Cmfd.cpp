@@ -1771,33 +1771,39 @@ FP_PRECISION Cmfd::getDistanceToCentroid(Point* centroid, int cell_id,
  *          the ratio of new to old flux for the cell that the outgoing flux
  *          from the track enters.
  * @param tracks 2D array of Tracks
+ * @param segment_store the SegmentStore holding the Tracks' segments
  * @param boundary_flux Array of boundary fluxes
- * @return The number of Tracks
+ * @param num_tracks The number of Tracks
+ * @param boundary_flux_offsets The offset of each Track direction's boundary
+ *        flux, or -1 for none, if the boundary fluxes are not stored for
+ *        both directions of each Track in turn (NULL by default)
  */
-void Cmfd::updateBoundaryFlux(Track** tracks, FP_PRECISION* boundary_flux,
-                              int num_tracks) {
+void Cmfd::updateBoundaryFlux(Track** tracks, SegmentStore* segment_store,
+                              FP_STORAGE* boundary_flux, int num_tracks,
+                              long* boundary_flux_offsets) {
 
-  segment* segments;
-  segment* curr_segment;
-  int num_segments;
   int bc;
-  FP_PRECISION* track_flux;
+  FP_STORAGE* track_flux;
   FP_PRECISION ratio;
   int cell_id;
+  long offset;
 
   log_printf(DEBUG, "Updating boundary flux...");
 
   /* Loop over Tracks */
   for (int i=0; i < num_tracks; i++) {
 
-    num_segments = tracks[i]->getNumSegments();
-    segments = tracks[i]->getSegments();
+    int uid = tracks[i]->getUid();
 
     /* Update boundary flux in forward direction */
     bc = (int)tracks[i]->getBCIn();
-    curr_segment = &segments[0];
-    track_flux = &boundary_flux[i*2*_num_moc_groups*_num_polar_2];
-    cell_id = convertFSRIdToCmfdCell(curr_segment->_region_id);
+    offset = (long)i*2*_num_moc_groups*_num_polar_2;
+    if (boundary_flux_offsets != NULL) {
+      offset = boundary_flux_offsets[2*i];
+      bc = bc && offset != -1;
+    }
+    track_flux = &boundary_flux[offset];
+    cell_id = convertFSRIdToCmfdCell(segment_store->getFirstRegionId(uid));
 
     if (bc) {
       for (int e=0; e < _num_moc_groups; e++) {
@@ -1810,9 +1816,13 @@ void Cmfd::updateBoundaryFlux(Track** tracks, FP_PRECISION* boundary_flux,
 
     /* Update boundary flux in backwards direction */
     bc = (int)tracks[i]->getBCOut();
-    curr_segment = &segments[num_segments - 1];
-    track_flux = &boundary_flux[(i*2 + 1)*_num_moc_groups*_num_polar_2];
-    cell_id = convertFSRIdToCmfdCell(curr_segment->_region_id);
+    offset = ((long)i*2 + 1)*_num_moc_groups*_num_polar_2;
+    if (boundary_flux_offsets != NULL) {
+      offset = boundary_flux_offsets[2*i + 1];
+      bc = bc && offset != -1;
+    }
+    track_flux = &boundary_flux[offset];
+    cell_id = convertFSRIdToCmfdCell(segment_store->getLastRegionId(uid));
 
     if (bc) {
       for (int e=0; e < _num_moc_groups; e++) {
@@ -1857,61 +1867,51 @@ void Cmfd::zeroCurrents() {
 }
 
 
+#ifdef MPIx
+/**
+ * @brief Sums the surface currents tallied by each rank of an MPI
+ *        communicator such that every rank holds the total currents.
+ * @param comm the MPI communicator of the ranks to reduce across
+ */
+void Cmfd::reduceCurrents(MPI_Comm comm) {
+  MPI_Allreduce(MPI_IN_PLACE, _surface_currents->getArray(),
+                _surface_currents->getNumRows(), MPI_FP_PRECISION, MPI_SUM,
+                comm);
+}
+#endif
+
+
 /**
  * @brief Tallies the current contribution from this segment across the
  *        the appropriate CMFD mesh cell surface.
- * @param curr_segment The current Track segment
+ * @param cmfd_surface The CMFD surface crossed in the direction of travel
+ *        along the segment, or -1 if no surface is crossed
  * @param track_flux The outgoing angular flux for this segment
  * @param azim_index Azimuthal angle index of the current Track
- * @param fwd Boolean indicating direction of integration along segment
  */
-void Cmfd::tallyCurrent(segment* curr_segment, FP_PRECISION* track_flux,
-                        int azim_index, bool fwd) {
+void Cmfd::tallyCurrent(int cmfd_surface, FP_PRECISION* track_flux,
+                        int azim_index) {
+
+  if (cmfd_surface == -1)
+    return;
 
-  int surf_id, cell_id;
   int ncg = _num_cmfd_groups;
+  int surf_id = cmfd_surface % NUM_SURFACES;
+  int cell_id = cmfd_surface / NUM_SURFACES;
   FP_PRECISION currents[_num_cmfd_groups];
   memset(currents, 0.0, sizeof(FP_PRECISION) * _num_cmfd_groups);
 
-  if (fwd) {
-    if (curr_segment->_cmfd_surface_fwd != -1) {
-
-      surf_id = curr_segment->_cmfd_surface_fwd % NUM_SURFACES;
-      cell_id = curr_segment->_cmfd_surface_fwd / NUM_SURFACES;
-
-      for (int e=0; e < _num_moc_groups; e++) {
-        int g = getCmfdGroup(e);
-
-        for (int p=0; p < _num_polar_2; p++)
-          currents[g] += track_flux(p, e) *
-                         _quadrature->getWeightInline(azim_index, p);
-      }
+  for (int e=0; e < _num_moc_groups; e++) {
+    int g = getCmfdGroup(e);
 
-      /* Increment currents */
-      _surface_currents->incrementValues
-          (cell_id, surf_id*ncg, (surf_id+1)*ncg - 1, currents);
-    }
+    for (int p=0; p < _num_polar_2; p++)
+      currents[g] += track_flux(p, e) *
+                     _quadrature->getWeightInline(azim_index, p);
   }
-  else {
-    if (curr_segment->_cmfd_surface_bwd != -1) {
-
-      surf_id = curr_segment->_cmfd_surface_bwd % NUM_SURFACES;
-      cell_id = curr_segment->_cmfd_surface_bwd / NUM_SURFACES;
-
-      for (int e=0; e < _num_moc_groups; e++) {
-
-        int g = getCmfdGroup(e);
-
-        for (int p=0; p < _num_polar_2; p++)
-          currents[g] += track_flux(p, e) *
-                         _quadrature->getWeightInline(azim_index, p);
-      }
 
-      /* Increment currents */
-      _surface_currents->incrementValues
-          (cell_id, surf_id*ncg, (surf_id+1)*ncg - 1, currents);
-    }
-  }
+  /* Increment currents */
+  _surface_currents->incrementValues
+      (cell_id, surf_id*ncg, (surf_id+1)*ncg - 1, currents);
 }
 
 
@@ -19,6 +19,10 @@
 #include "Quadrature.h"
 #include "linalg.h"
 #include "Geometry.h"
+#include "SegmentStore.h"
+#ifdef MPIx
+#include <mpi.h>
+#endif
 #endif
 
 /** Forward declaration of Geometry class */
@@ -207,10 +211,14 @@ public:
   int findCmfdSurface(int cell_id, LocalCoords* coords);
   void addFSRToCell(int cell_id, int fsr_id);
   void zeroCurrents();
-  void tallyCurrent(segment* curr_segment, FP_PRECISION* track_flux,
-                    int azim_index, bool fwd);
-  void updateBoundaryFlux(Track** tracks, FP_PRECISION* boundary_flux,
-                          int num_tracks);
+#ifdef MPIx
+  void reduceCurrents(MPI_Comm comm);
+#endif
+  void tallyCurrent(int cmfd_surface, FP_PRECISION* track_flux,
+                    int azim_index);
+  void updateBoundaryFlux(Track** tracks, SegmentStore* segment_store,
+                          FP_STORAGE* boundary_flux, int num_tracks,
+                          long* boundary_flux_offsets=NULL);
 
   /* Get parameters */
   int getNumCmfdGroups();
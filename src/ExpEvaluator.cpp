@@ -8,6 +8,8 @@
  */
 ExpEvaluator::ExpEvaluator() {
   _interpolate = true;
+  _polynomial = false;
+  _poly_degree = 0;
   _exp_table = NULL;
   _quadrature = NULL;
   _max_optical_length = MAX_OPTICAL_LENGTH;
@@ -52,7 +54,8 @@ void ExpEvaluator::setMaxOpticalLength(FP_PRECISION max_optical_length) {
 /**
  * @brief Sets the maximum acceptable approximation error for exponentials.
  * @details This routine only affects the construction of the linear
- *          interpolation table for exponentials, if in use. By default,
+ *          interpolation table or the degree of the polynomial approximation
+ *          for exponentials, if either is in use. By default,
  *          a value of 1E-5 is used for the table, as recommended by the
  *          analysis of Yamamoto in his 2004 paper on the subject.
  * @param exp_precision the maximum exponential approximation error
@@ -72,6 +75,7 @@ void ExpEvaluator::setExpPrecision(FP_PRECISION exp_precision) {
  */
 void ExpEvaluator::useInterpolation() {
   _interpolate = true;
+  _polynomial = false;
 }
 
 
@@ -80,6 +84,19 @@ void ExpEvaluator::useInterpolation() {
  */
 void ExpEvaluator::useIntrinsic() {
   _interpolate = false;
+  _polynomial = false;
+}
+
+
+/**
+ * @brief Use a table-free polynomial approximation to compute exponentials.
+ * @details The degree of the polynomial is chosen when the ExpEvaluator is
+ *          initialized such that the approximation error does not exceed
+ *          the exponential precision.
+ */
+void ExpEvaluator::usePolynomial() {
+  _interpolate = false;
+  _polynomial = true;
 }
 
 
@@ -111,6 +128,30 @@ bool ExpEvaluator::isUsingInterpolation() {
 }
 
 
+/**
+ * @brief Returns true if using a polynomial approximation to compute
+ *        exponentials.
+ * @return true if so, false otherwise
+ */
+bool ExpEvaluator::isUsingPolynomial() {
+  return _polynomial;
+}
+
+
+/**
+ * @brief Returns the degree of the polynomial approximation.
+ * @return the polynomial degree
+ */
+int ExpEvaluator::getPolynomialDegree() {
+
+  if (_poly_degree == 0)
+    log_printf(ERROR, "Unable to return the polynomial degree "
+               "since it has not yet been initialized");
+
+  return _poly_degree;
+}
+
+
 /**
  * @brief Returns the exponential table spacing.
  * @return exponential table spacing
@@ -155,11 +196,17 @@ FP_PRECISION* ExpEvaluator::getExpTable() {
 
 
 /**
- * @brief If using linear interpolation, builds the table for each polar angle.
- * @param tolerance the minimum acceptable interpolation accuracy
+ * @brief If using linear interpolation, builds the table for each polar angle,
+ *        or if using the polynomial approximation, computes its coefficients.
  */
 void ExpEvaluator::initialize() {
 
+  /* If using the polynomial approximation, no table is needed */
+  if (_polynomial) {
+    initializePolynomial();
+    return;
+  }
+
   /* If no exponential table is needed, return */
   if (!_interpolate)
     return;
@@ -213,3 +260,75 @@ void ExpEvaluator::initialize() {
     }
   }
 }
+
+
+/**
+ * @brief Computes the coefficients of the polynomial approximation.
+ * @details The polynomial interpolates \f$ exp(-r) \f$ at the Chebyshev
+ *          nodes of the reduced interval \f$ [0, ln(2)] \f$. Since all
+ *          derivatives of \f$ exp(-r) \f$ are bounded by one on this
+ *          interval, the interpolation error for a degree \f$ n \f$ is
+ *          bounded by \f$ ln(2)^{n+1} / (2^{2n+1} (n+1)!) \f$. The lowest
+ *          degree whose bound and sampled error are within the exponential
+ *          precision is selected.
+ */
+void ExpEvaluator::initializePolynomial() {
+
+  log_printf(INFO, "Initializing exponential polynomial approximation...");
+
+  double nodes[MAX_EXP_POLY_DEGREE+1];
+  double coeffs[MAX_EXP_POLY_DEGREE+1];
+  double max_error = 0.;
+
+  for (int n=1; n <= MAX_EXP_POLY_DEGREE; n++) {
+
+    /* Skip degrees whose a priori error bound is too large */
+    double bound = pow(M_LN2, n+1) / (pow(2., 2*n+1) * tgamma(n+2));
+    if (bound > _exp_precision / 2. && n < MAX_EXP_POLY_DEGREE)
+      continue;
+
+    /* Compute the Chebyshev nodes and Newton divided differences */
+    for (int i=0; i <= n; i++) {
+      nodes[i] = M_LN2 / 2. * (1. - cos((2*i + 1) * M_PI / (2*n + 2)));
+      coeffs[i] = exp(-nodes[i]);
+    }
+
+    for (int j=1; j <= n; j++)
+      for (int i=n; i >= j; i--)
+        coeffs[i] = (coeffs[i] - coeffs[i-1]) / (nodes[i] - nodes[i-j]);
+
+    /* Expand the Newton form into monomial coefficients */
+    double monomial[MAX_EXP_POLY_DEGREE+1];
+    memset(monomial, 0, sizeof(monomial));
+    monomial[0] = coeffs[n];
+    for (int i=n-1; i >= 0; i--) {
+      for (int j=n-i; j > 0; j--)
+        monomial[j] = monomial[j-1] - nodes[i] * monomial[j];
+      monomial[0] = coeffs[i] - nodes[i] * monomial[0];
+    }
+
+    _poly_degree = n;
+    for (int i=0; i <= MAX_EXP_POLY_DEGREE; i++)
+      _poly_coeffs[i] = monomial[i];
+
+    /* Verify the approximation in the working precision */
+    max_error = 0.;
+    int num_samples = 10000;
+    for (int i=0; i <= num_samples; i++) {
+      FP_PRECISION x = 10. * M_LN2 * i / num_samples;
+      double error = fabs(computePolynomialExponential(x) - (1. - exp(-x)));
+      max_error = std::max(max_error, error);
+    }
+
+    if (max_error <= _exp_precision)
+      break;
+  }
+
+  if (max_error > _exp_precision)
+    log_printf(WARNING, "The exponential polynomial approximation of maximum "
+               "degree %d has an error %1.2E larger than the precision %1.2E",
+               _poly_degree, max_error, _exp_precision);
+
+  log_printf(DEBUG, "Exponential polynomial of degree %d with an error of "
+             "%1.2E", _poly_degree, max_error);
+}
@@ -11,8 +11,11 @@
 #ifdef __cplusplus
 #define _USE_MATH_DEFINES
 #include "log.h"
+#include "constants.h"
 #include "Quadrature.h"
 #include <math.h>
+#include <string.h>
+#include <algorithm>
 #endif
 
 
@@ -20,7 +23,9 @@
  * @class ExpEvaluator ExpEvaluator.h "src/ExpEvaluator.h"
  * @brief This is a class for evaluating exponentials.
  * @details The ExpEvaluator includes different algorithms to evaluate
- *          exponentials with varying degrees of accuracy and speed. This
+ *          exponentials with varying degrees of accuracy and speed: a linear
+ *          interpolation table, the exponential intrinsic exp(...) function,
+ *          and a table-free polynomial approximation. This
  *          is a helper class for the Solver and its subclasses and it not
  *          intended to be initialized as a standalone object.
  */
@@ -31,6 +36,17 @@ private:
   /** A boolean indicating whether or not to use linear interpolation */
   bool _interpolate;
 
+  /** A boolean indicating whether or not to use a polynomial approximation */
+  bool _polynomial;
+
+  /** The degree of the polynomial approximation of exp(-r) for r in
+   *  [0, ln(2)] */
+  int _poly_degree;
+
+  /** The coefficients of the polynomial approximation in increasing order,
+   *  padded with zeros above the degree */
+  FP_PRECISION _poly_coeffs[MAX_EXP_POLY_DEGREE+1];
+
   /** The inverse spacing for the exponential linear interpolation table */
   FP_PRECISION _inverse_exp_table_spacing;
 
@@ -52,6 +68,9 @@ private:
   /** The maximum acceptable approximation error for exponentials */
   FP_PRECISION _exp_precision;
 
+  void initializePolynomial();
+  FP_PRECISION computePolynomialExponential(FP_PRECISION x);
+
 public:
 
   ExpEvaluator();
@@ -62,25 +81,68 @@ public:
   void setExpPrecision(FP_PRECISION exp_precision);
   void useInterpolation();
   void useIntrinsic();
+  void usePolynomial();
 
   FP_PRECISION getMaxOpticalLength();
   FP_PRECISION getExpPrecision();
   bool isUsingInterpolation();
+  bool isUsingPolynomial();
+  int getPolynomialDegree();
   FP_PRECISION getTableSpacing();
   int getTableSize();
   FP_PRECISION* getExpTable();
 
   void initialize();
   FP_PRECISION computeExponential(FP_PRECISION tau, int polar);
+  void computeExponentials(FP_PRECISION length, FP_PRECISION* sigma_t,
+                           int num_groups, int num_polar_2,
+                           FP_PRECISION* exponentials);
 };
 
 
+/**
+ * @brief Computes \f$ 1 - exp(-x) \f$ with the polynomial approximation.
+ * @details The argument is reduced to \f$ x = k ln(2) + r \f$ with
+ *          \f$ r \in [0, ln(2)) \f$ such that
+ *          \f$ exp(-x) = 2^{-k} exp(-r) \f$, where \f$ exp(-r) \f$ is
+ *          evaluated with the polynomial and \f$ 2^{-k} \f$ is built
+ *          directly from its floating point exponent bits. No tables are
+ *          used so that the evaluation may be vectorized in registers.
+ * @param x the argument of the exponential (must be non-negative)
+ * @return the evaluated exponential \f$ 1 - exp(-x) \f$
+ */
+inline FP_PRECISION ExpEvaluator::computePolynomialExponential(FP_PRECISION x) {
+
+  /* Beyond 64 ln(2), exp(-x) < 2^-64 is negligible */
+  x = std::min(x, FP_PRECISION(64. * M_LN2));
+  int k = int(x * FP_PRECISION(M_LOG2E));
+  FP_PRECISION r = x - k * FP_PRECISION(M_LN2);
+
+  /* Evaluate the polynomial for exp(-r) with Horner's method over all
+   * coefficients (zero above the degree) for a fixed, vectorizable loop */
+  FP_PRECISION exponential = _poly_coeffs[MAX_EXP_POLY_DEGREE];
+  for (int i=MAX_EXP_POLY_DEGREE-1; i >= 0; i--)
+    exponential = exponential * r + _poly_coeffs[i];
+
+  /* Scale by 2^-k with the floating point exponent bits */
+  FP_PRECISION scale;
+#ifdef SINGLE
+  int bits = (127 - k) << 23;
+#else
+  long long bits = (long long)(1023 - k) << 52;
+#endif
+  memcpy(&scale, &bits, sizeof(scale));
+
+  return 1. - exponential * scale;
+}
+
+
 /**
  * @brief Computes the exponential term for a optical length and polar angle.
  * @details This method computes \f$ 1 - exp(-\tau/sin(\theta_p)) \f$
  *          for some optical path length and polar angle. This method
- *          uses either a linear interpolation table (default) or the
- *          exponential intrinsic exp(...) function.
+ *          uses either a linear interpolation table (default), a polynomial
+ *          approximation or the exponential intrinsic exp(...) function.
  * @param tau the optical path length (e.g., sigma_t times length)
  * @param polar the polar angle index
  * @return the evaluated exponential
@@ -99,6 +161,12 @@ inline FP_PRECISION ExpEvaluator::computeExponential(FP_PRECISION tau,
                   _exp_table[index + 2 * polar + 1]));
   }
 
+  /* Evaluate the exponential using the polynomial approximation */
+  else if (_polynomial) {
+    FP_PRECISION sin_theta = _quadrature->getSinTheta(0, polar);
+    exponential = computePolynomialExponential(tau / sin_theta);
+  }
+
   /* Evalute the exponential using the intrinsic exp(...) function */
   else {
     FP_PRECISION sin_theta = _quadrature->getSinTheta(0, polar);
@@ -108,4 +176,69 @@ inline FP_PRECISION ExpEvaluator::computeExponential(FP_PRECISION tau,
   return exponential;
 }
 
+
+/**
+ * @brief Computes the exponential terms for a segment in each energy group
+ *        and polar angle.
+ * @details This method computes \f$ 1 - exp(-l\Sigma_t^g/sin(\theta_p)) \f$
+ *          for a segment of length \f$ l \f$ with the linear interpolation
+ *          table, the polynomial approximation or the exponential intrinsic
+ *          exp(...) function, selected once for the segment rather than for
+ *          each exponential. The exponentials are stored by polar angle with the
+ *          energy groups contiguous (ie, exponentials[p*num_groups + e]) so
+ *          that the loops over energy groups may be vectorized.
+ * @param length the segment length
+ * @param sigma_t the total cross-sections of the segment's Material
+ * @param num_groups the number of energy groups
+ * @param num_polar_2 half the number of polar angles
+ * @param exponentials the array of num_polar_2 x num_groups exponentials
+ */
+inline void ExpEvaluator::computeExponentials(FP_PRECISION length,
+                                              FP_PRECISION* sigma_t,
+                                              int num_groups, int num_polar_2,
+                                              FP_PRECISION* exponentials) {
+
+  /* Evaluate the exponentials using the lookup table - linear interpolation */
+  if (_interpolate) {
+    for (int p=0; p < num_polar_2; p++) {
+      FP_PRECISION* exp_table = &_exp_table[2 * p];
+      FP_PRECISION* polar_exponentials = &exponentials[p * num_groups];
+
+#pragma omp simd
+      for (int e=0; e < num_groups; e++) {
+        FP_PRECISION tau = std::min(sigma_t[e] * length, _max_optical_length);
+        int index = int(tau * _inverse_exp_table_spacing) * _num_polar;
+        polar_exponentials[e] = 1. - (exp_table[index] * tau +
+                                      exp_table[index + 1]);
+      }
+    }
+  }
+
+  /* Evaluate the exponentials using the polynomial approximation */
+  else if (_polynomial) {
+    for (int p=0; p < num_polar_2; p++) {
+      FP_PRECISION inv_sin_theta = 1. / _quadrature->getSinTheta(0, p);
+      FP_PRECISION* polar_exponentials = &exponentials[p * num_groups];
+
+#pragma omp simd
+      for (int e=0; e < num_groups; e++)
+        polar_exponentials[e] =
+            computePolynomialExponential(sigma_t[e] * length * inv_sin_theta);
+    }
+  }
+
+  /* Evalute the exponentials using the intrinsic exp(...) function */
+  else {
+    for (int p=0; p < num_polar_2; p++) {
+      FP_PRECISION inv_sin_theta = 1. / _quadrature->getSinTheta(0, p);
+      FP_PRECISION* polar_exponentials = &exponentials[p * num_groups];
+
+#pragma omp simd
+      for (int e=0; e < num_groups; e++)
+        polar_exponentials[e] = 1. - exp(- sigma_t[e] * length *
+                                         inv_sin_theta);
+    }
+  }
+}
+
 #endif /* EXPEVALUATOR_H_ */
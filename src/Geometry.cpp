@@ -1,4 +1,5 @@
 #include "Geometry.h"
+#include "MOCKernel.h"
 
 
 /**
@@ -20,6 +21,18 @@ Geometry::Geometry() {
 
   /* Initialize CMFD object to NULL */
   _cmfd = NULL;
+
+  /* The Geometry is not decomposed into spatial domains by default */
+  _domain_decomposed = false;
+  _num_domains_x = 1;
+  _num_domains_y = 1;
+  _domain_index_x = 0;
+  _domain_index_y = 0;
+  for (int s=0; s < NUM_FACES; s++)
+    _neighbor_domains[s] = -1;
+
+  /* Segments are not reused across repeated Lattice cells by default */
+  _use_segment_templates = false;
 }
 
 
@@ -40,6 +53,16 @@ Geometry::~Geometry() {
     _FSRs_to_keys.clear();
   }
 
+  clearSegmentTemplates();
+
+#ifdef MPIx
+  /* Communicators may not be freed once MPI has been finalized */
+  int finalized;
+  MPI_Finalized(&finalized);
+  if (_domain_decomposed && !finalized)
+    MPI_Comm_free(&_MPI_cart);
+#endif
+
   /* Remove all Materials in the Geometry */
   std::map<int, Material*> materials = getAllMaterials();
   std::map<int, Cell*> cells = getAllCells();
@@ -91,36 +114,74 @@ double Geometry::getWidthZ() {
 
 /**
  * @brief Return the minimum x-coordinate contained by the Geometry.
+ * @details If the Geometry is decomposed into spatial domains, this is the
+ *          minimum x-coordinate of this rank's domain.
  * @return the minimum x-coordinate (cm)
  */
 double Geometry::getMinX() {
-  return _root_universe->getMinX();
+
+  double min_x = _root_universe->getMinX();
+
+  if (_domain_decomposed) {
+    double width = (_root_universe->getMaxX() - min_x) / _num_domains_x;
+    min_x += width * _domain_index_x;
+  }
+
+  return min_x;
 }
 
 
 /**
  * @brief Return the maximum x-coordinate contained by the Geometry.
+ * @details If the Geometry is decomposed into spatial domains, this is the
+ *          maximum x-coordinate of this rank's domain.
  * @return the maximum x-coordinate (cm)
  */
 double Geometry::getMaxX() {
+
+  if (_domain_decomposed) {
+    double min_x = _root_universe->getMinX();
+    double width = (_root_universe->getMaxX() - min_x) / _num_domains_x;
+    return min_x + width * (_domain_index_x + 1);
+  }
+
   return _root_universe->getMaxX();
 }
 
 
 /**
  * @brief Return the minimum y-coordinate contained by the Geometry.
+ * @details If the Geometry is decomposed into spatial domains, this is the
+ *          minimum y-coordinate of this rank's domain.
  * @return the minimum y-coordinate (cm)
  */
 double Geometry::getMinY() {
-  return _root_universe->getMinY();
+
+  double min_y = _root_universe->getMinY();
+
+  if (_domain_decomposed) {
+    double width = (_root_universe->getMaxY() - min_y) / _num_domains_y;
+    min_y += width * _domain_index_y;
+  }
+
+  return min_y;
 }
 
 
 /**
  * @brief Return the maximum y-coordinate contained by the Geometry.
+ * @details If the Geometry is decomposed into spatial domains, this is the
+ *          maximum y-coordinate of this rank's domain.
  * @return the maximum y-coordinate (cm)
  */
 double Geometry::getMaxY() {
+
+  if (_domain_decomposed) {
+    double min_y = _root_universe->getMinY();
+    double width = (_root_universe->getMaxY() - min_y) / _num_domains_y;
+    return min_y + width * (_domain_index_y + 1);
+  }
+
   return _root_universe->getMaxY();
 }
 
@@ -146,9 +207,15 @@ double Geometry::getMaxZ() {
 /**
  * @brief Returns the boundary conditions (REFLECTIVE or VACUUM) at the
  *        minimum x-coordinate in the Geometry.
+ * @details The boundary conditions are INTERFACE where this rank's spatial
+ *          domain neighbors the domain of another rank.
  * @return the boundary conditions for the minimum x-coordinate in the Geometry
  */
 boundaryType Geometry::getMinXBoundaryType() {
+
+  if (_neighbor_domains[SURFACE_X_MIN] != -1)
+    return INTERFACE;
+
   return _root_universe->getMinXBoundaryType();
 }
 
@@ -156,9 +223,15 @@ boundaryType Geometry::getMinXBoundaryType() {
 /**
  * @brief Returns the boundary conditions (REFLECTIVE or VACUUM) at the
  *        maximum x-coordinate in the Geometry.
+ * @details The boundary conditions are INTERFACE where this rank's spatial
+ *          domain neighbors the domain of another rank.
  * @return the boundary conditions for the maximum z-coordinate in the Geometry
  */
 boundaryType Geometry::getMaxXBoundaryType() {
+
+  if (_neighbor_domains[SURFACE_X_MAX] != -1)
+    return INTERFACE;
+
   return _root_universe->getMaxXBoundaryType();
 }
 
@@ -166,9 +239,15 @@ boundaryType Geometry::getMaxXBoundaryType() {
 /**
  * @brief Returns the boundary conditions (REFLECTIVE or VACUUM) at the
  *        minimum y-coordinate in the Geometry.
+ * @details The boundary conditions are INTERFACE where this rank's spatial
+ *          domain neighbors the domain of another rank.
  * @return the boundary conditions for the minimum y-coordinate in the Geometry
  */
 boundaryType Geometry::getMinYBoundaryType() {
+
+  if (_neighbor_domains[SURFACE_Y_MIN] != -1)
+    return INTERFACE;
+
   return _root_universe->getMinYBoundaryType();
 }
 
@@ -176,9 +255,15 @@ boundaryType Geometry::getMinYBoundaryType() {
 /**
  * @brief Returns the boundary conditions (REFLECTIVE or VACUUM) at the
  *        maximum y-coordinate in the Geometry.
+ * @details The boundary conditions are INTERFACE where this rank's spatial
+ *          domain neighbors the domain of another rank.
  * @return the boundary conditions for the maximum y-coordinate in the Geometry
  */
 boundaryType Geometry::getMaxYBoundaryType() {
+
+  if (_neighbor_domains[SURFACE_Y_MAX] != -1)
+    return INTERFACE;
+
   return _root_universe->getMaxYBoundaryType();
 }
 
@@ -375,6 +460,123 @@ Universe* Geometry::getRootUniverse() {
 }
 
 
+/**
+ * @brief Returns whether the Geometry is decomposed into spatial domains.
+ * @return true if decomposed into spatial domains, false otherwise
+ */
+bool Geometry::isDomainDecomposed() {
+  return _domain_decomposed;
+}
+
+
+/**
+ * @brief Returns the number of spatial domains along the x-axis.
+ * @return the number of spatial domains along the x-axis
+ */
+int Geometry::getNumXDomains() {
+  return _num_domains_x;
+}
+
+
+/**
+ * @brief Returns the number of spatial domains along the y-axis.
+ * @return the number of spatial domains along the y-axis
+ */
+int Geometry::getNumYDomains() {
+  return _num_domains_y;
+}
+
+
+/**
+ * @brief Returns the x index of this rank's spatial domain.
+ * @return the x index of the spatial domain
+ */
+int Geometry::getDomainIndexX() {
+  return _domain_index_x;
+}
+
+
+/**
+ * @brief Returns the y index of this rank's spatial domain.
+ * @return the y index of the spatial domain
+ */
+int Geometry::getDomainIndexY() {
+  return _domain_index_y;
+}
+
+
+/**
+ * @brief Returns the rank of the spatial domain neighboring this rank's
+ *        domain across one of its faces.
+ * @param surface the face of the domain (SURFACE_X_MIN, SURFACE_Y_MIN,
+ *        SURFACE_X_MAX or SURFACE_Y_MAX)
+ * @return the rank of the neighboring domain, or -1 at a boundary of the
+ *         Geometry
+ */
+int Geometry::getNeighborDomain(int surface) {
+
+  if (surface < 0 || surface >= NUM_FACES)
+    log_printf(ERROR, "Unable to get the neighbor domain across surface %d "
+               "which is not a face of the domain", surface);
+
+  return _neighbor_domains[surface];
+}
+
+
+/**
+ * @brief Returns the number of segment templates formed across the Lattice
+ *        cells entered by the Tracks.
+ * @return the number of segment templates
+ */
+int Geometry::getNumSegmentTemplates() {
+  return _segment_templates.size();
+}
+
+
+/**
+ * @brief Returns the number of FSR IDs looked up by FSR key by all threads
+ *        since the FSR lookup counts were last reset.
+ * @return the number of FSR lookups
+ */
+long Geometry::getNumFSRLookups() {
+  long num_lookups = 0;
+  for (size_t i=0; i < _fsr_lookup_counts.size(); i+=FSR_LOOKUP_COUNT_STRIDE)
+    num_lookups += _fsr_lookup_counts[i];
+  return num_lookups;
+}
+
+
+/**
+ * @brief Returns the number of FSR lookups by all threads which found an FSR
+ *        already in the map of FSR keys since the counts were last reset.
+ * @details These lookups repeat an earlier lookup of the same FSR key and
+ *          bound the lookups which a per-thread cache of FSR IDs could skip.
+ * @return the number of FSR lookup hits
+ */
+long Geometry::getNumFSRLookupHits() {
+  long num_hits = 0;
+  for (size_t i=0; i < _fsr_lookup_counts.size(); i+=FSR_LOOKUP_COUNT_STRIDE)
+    num_hits += _fsr_lookup_counts[i+1];
+  return num_hits;
+}
+
+
+#ifdef MPIx
+/**
+ * @brief Returns the Cartesian MPI communicator of the spatial domains.
+ * @return the MPI communicator
+ */
+MPI_Comm Geometry::getMPICart() {
+
+  if (!_domain_decomposed)
+    log_printf(ERROR, "Unable to return the MPI communicator since the "
+               "Geometry is not decomposed into spatial domains");
+
+  return _MPI_cart;
+}
+#endif
+
+
 /**
  * @brief Returns a pointer to the CMFD object.
  * @return A pointer to the CMFD object
@@ -393,11 +595,96 @@ void Geometry::setRootUniverse(Universe* root_universe) {
 }
 
 
+#ifdef MPIx
+/**
+ * @brief Decomposes the Geometry into a uniform lattice of rectangular
+ *        spatial domains, one for each MPI rank.
+ * @details Each rank generates Tracks and segments only for its own domain,
+ *          whose faces between neighboring domains have INTERFACE boundary
+ *          conditions. The outgoing angular fluxes at these faces are
+ *          exchanged with the neighboring ranks after each transport sweep.
+ *          The number of domains must equal the number of MPI ranks in
+ *          MPI_COMM_WORLD. Faces with PERIODIC boundary conditions are
+ *          connected to the domain at the opposite side of the Geometry.
+ *          This method must be called after the root Universe is set and
+ *          before Tracks are generated:
+ *
+ * @code
+ *          geometry.setDomainDecomposition(2, 2)
+ * @endcode
+ *
+ * @param num_domains_x the number of domains along the x-axis
+ * @param num_domains_y the number of domains along the y-axis
+ */
+void Geometry::setDomainDecomposition(int num_domains_x, int num_domains_y) {
+
+  int num_ranks;
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  if (num_domains_x <= 0 || num_domains_y <= 0)
+    log_printf(ERROR, "Unable to decompose the Geometry into %d x %d "
+               "domains", num_domains_x, num_domains_y);
+
+  if (num_domains_x * num_domains_y != num_ranks)
+    log_printf(ERROR, "Unable to decompose the Geometry into %d x %d "
+               "domains with %d MPI ranks", num_domains_x, num_domains_y,
+               num_ranks);
+
+  if (_cmfd != NULL)
+    log_printf(ERROR, "Unable to decompose the Geometry into spatial "
+               "domains with CMFD acceleration");
+
+  if (_domain_decomposed)
+    MPI_Comm_free(&_MPI_cart);
+
+  /* Create a Cartesian communicator which wraps around PERIODIC faces */
+  int dims[2] = {num_domains_x, num_domains_y};
+  int periods[2];
+  periods[0] = (_root_universe->getMinXBoundaryType() == PERIODIC &&
+                num_domains_x > 1);
+  periods[1] = (_root_universe->getMinYBoundaryType() == PERIODIC &&
+                num_domains_y > 1);
+  MPI_Cart_create(MPI_COMM_WORLD, 2, dims, periods, 0, &_MPI_cart);
+
+  int rank, coords[2];
+  MPI_Comm_rank(_MPI_cart, &rank);
+  MPI_Cart_coords(_MPI_cart, rank, 2, coords);
+
+  _domain_decomposed = true;
+  _num_domains_x = num_domains_x;
+  _num_domains_y = num_domains_y;
+  _domain_index_x = coords[0];
+  _domain_index_y = coords[1];
+
+  /* Find the ranks of the neighboring domains across each face */
+  MPI_Cart_shift(_MPI_cart, 0, 1, &_neighbor_domains[SURFACE_X_MIN],
+                 &_neighbor_domains[SURFACE_X_MAX]);
+  MPI_Cart_shift(_MPI_cart, 1, 1, &_neighbor_domains[SURFACE_Y_MIN],
+                 &_neighbor_domains[SURFACE_Y_MAX]);
+  for (int s=0; s < NUM_FACES; s++)
+    if (_neighbor_domains[s] == MPI_PROC_NULL)
+      _neighbor_domains[s] = -1;
+
+  /* Only report log messages from the first rank */
+  log_set_ranks(_MPI_cart);
+
+  log_printf(INFO, "Rank %d owns domain (%d, %d) with x in [%f, %f] and "
+             "y in [%f, %f]", rank, _domain_index_x, _domain_index_y,
+             getMinX(), getMaxX(), getMinY(), getMaxY());
+}
+#endif
+
+
 /**
  * @brief Sets the pointer to a CMFD object used for acceleration.
  * @param cmfd a pointer to the CMFD object
  */
 void Geometry::setCmfd(Cmfd* cmfd) {
+
+  if (_domain_decomposed)
+    log_printf(ERROR, "Unable to set CMFD acceleration for a Geometry "
+               "decomposed into spatial domains");
+
   _cmfd = cmfd;
 }
 
@@ -478,11 +765,14 @@ Material* Geometry::findFSRMaterial(int fsr_id) {
  * @details The method will update the LocalCoords passed in as an argument
  *          to be the one at the boundary of the next Cell crossed along the
  *          given trajectory. It will do this by finding the minimum distance
- *          to the surfaces at all levels of the coords hierarchy. If the
- *          LocalCoords is outside the bounds of the Geometry or on the
- *          boundaries this method will return NULL; otherwise it will return
- *          a pointer to the Cell that the LocalCoords will reach next along
- *          its trajectory.
+ *          to the surfaces at all levels of the coords hierarchy. The Cells
+ *          and Lattice cells above the highest level whose nearest boundary
+ *          is crossed are kept, and the coords are only relocated from that
+ *          level downward. Lattice cell indices are stepped across the
+ *          crossed Lattice cell boundaries. If the LocalCoords is outside the
+ *          bounds of the Geometry or on the boundaries this method will
+ *          return NULL; otherwise it will return a pointer to the Cell that
+ *          the LocalCoords will reach next along its trajectory.
  * @param coords pointer to a LocalCoords object
  * @return a pointer to a Cell if found, NULL if no Cell found
  */
@@ -492,6 +782,10 @@ Cell* Geometry::findNextCell(LocalCoords* coords) {
   double dist;
   double min_dist = std::numeric_limits<double>::infinity();
 
+  /* The distance to the nearest boundary at each level of the coords */
+  double level_dists[MAX_LOCAL_COORDS_LEVELS];
+  int num_levels = 0;
+
   /* Get highest level coords */
   coords = coords->getHighestLevel();
 
@@ -524,17 +818,17 @@ Cell* Geometry::findNextCell(LocalCoords* coords) {
       }
 
       /* Recheck min distance */
+      level_dists[num_levels++] = dist;
       min_dist = std::min(dist, min_dist);
 
       /* Descend one level */
       if (coords->getNext() == NULL)
-	break;
+        break;
       else
- 	coords = coords->getNext();
+        coords = coords->getNext();
     }
 
     coords = coords->getHighestLevel();
-    coords->prune();
 
     /* Check for distance to nearest CMFD mesh cell boundary */
     if (_cmfd != NULL) {
@@ -543,14 +837,225 @@ Cell* Geometry::findNextCell(LocalCoords* coords) {
       min_dist = std::min(dist, min_dist);
     }
 
-    /* Move point and get next cell */
+    /* Check for distance to the boundary of this rank's spatial domain */
+    double domain_dist = std::numeric_limits<double>::infinity();
+    if (_domain_decomposed) {
+      domain_dist = minDomainBoundaryDist(coords);
+      min_dist = std::min(domain_dist, min_dist);
+    }
+
+    /* Move point at all levels */
     coords->adjustCoords(min_dist + TINY_MOVE);
 
+    /* Find the highest level whose nearest boundary may have been crossed,
+     * allowing for round-off in the distances at each level */
+    double crossed_dist = min_dist + 2 * TINY_MOVE;
+    int level = 0;
+    if (domain_dist > crossed_dist)
+      while (level < num_levels && level_dists[level] > crossed_dist)
+        level++;
+
+    /* If only a CMFD mesh cell boundary was crossed, the Cell is unchanged */
+    if (level == num_levels)
+      return cell;
+
+    LocalCoords* level_coords = coords;
+    for (int l=0; l < level; l++)
+      level_coords = level_coords->getNext();
+
+    /* Relocate the coords from that level downward, moving up a level
+     * whenever the coords have also left the Universe or Lattice */
+    while (level_coords != coords) {
+
+      level_coords->prune();
+
+      if (level_coords->getType() == LAT)
+        cell = level_coords->getLattice()->findNextLatticeCell(level_coords);
+      else
+        cell = level_coords->getUniverse()->findCell(level_coords);
+
+      if (cell != NULL)
+        return cell;
+
+      level_coords = level_coords->getPrev();
+    }
+
+    /* Relocate the coords from the root Universe */
+    coords->prune();
     return findCellContainingCoords(coords);
   }
 }
 
 
+/**
+ * @brief Finds the distance from a LocalCoords to the boundary of this
+ *        rank's spatial domain along its trajectory.
+ * @details Spatial domain boundaries need not coincide with any Surface, so
+ *          Track segments are truncated at the domain boundary when the
+ *          Geometry is decomposed into spatial domains.
+ * @param coords pointer to a LocalCoords object in the root Universe
+ * @return the distance to the domain boundary (cm)
+ */
+double Geometry::minDomainBoundaryDist(LocalCoords* coords) {
+
+  double x = coords->getX();
+  double y = coords->getY();
+  double cos_phi = cos(coords->getPhi());
+  double sin_phi = sin(coords->getPhi());
+  double dist = std::numeric_limits<double>::infinity();
+
+  if (cos_phi > 0.)
+    dist = std::min(dist, (getMaxX() - x) / cos_phi);
+  else if (cos_phi < 0.)
+    dist = std::min(dist, (getMinX() - x) / cos_phi);
+
+  if (sin_phi > 0.)
+    dist = std::min(dist, (getMaxY() - y) / sin_phi);
+  else if (sin_phi < 0.)
+    dist = std::min(dist, (getMinY() - y) / sin_phi);
+
+  return std::max(dist, 0.);
+}
+
+
+/**
+ * @brief Determines whether the segments formed across a Lattice cell may be
+ *        reused for other instances of the Lattice cell.
+ * @details The segments formed across a Lattice cell only depend on the
+ *          Universe filling it, the entry point and the azimuthal angle if
+ *          the trajectory leaves the Lattice cell before crossing any
+ *          boundary at a higher level, including the boundaries of this
+ *          rank's spatial domain. Segments are not reused with CMFD, whose
+ *          mesh surfaces are stored with each segment.
+ * @param lat_coords pointer to the LocalCoords at the lowest Lattice level
+ * @param lat_dist the distance to leave the Lattice cell (cm)
+ * @return whether the segments across the Lattice cell may be reused
+ */
+bool Geometry::isTemplateLattice(LocalCoords* lat_coords, double lat_dist) {
+
+  if (_cmfd != NULL)
+    return false;
+
+  /* Find the distance to the nearest boundary above the Lattice level */
+  LocalCoords* coords = lat_coords->getHighestLevel();
+  double upper_dist = std::numeric_limits<double>::infinity();
+
+  for (LocalCoords* curr = coords; curr != lat_coords;
+       curr = curr->getNext()) {
+    if (curr->getType() == LAT)
+      upper_dist = std::min(upper_dist,
+                            curr->getLattice()->minSurfaceDist(curr));
+    else
+      upper_dist = std::min(upper_dist, curr->getCell()->minSurfaceDist(curr));
+  }
+
+  if (_domain_decomposed)
+    upper_dist = std::min(upper_dist, minDomainBoundaryDist(coords));
+
+  /* The trajectory must leave the Lattice cell first */
+  return (lat_dist <= upper_dist + ON_SURFACE_THRESH);
+}
+
+
+/**
+ * @brief Generates the key of the segment template for a trajectory
+ *        entering a Lattice cell.
+ * @details The key identifies the Lattice, the Universe filling the Lattice
+ *          cell, the azimuthal angle and the entry point local to the
+ *          Lattice cell, rounded to SEGMENT_TEMPLATE_PRECISION. Each rounded
+ *          coordinate is split into its upper and lower 32 bits.
+ * @param lat_coords pointer to the LocalCoords at the Lattice level
+ * @param azim_index the azimuthal angle index of the trajectory
+ * @return the segment template key
+ */
+FSRKey Geometry::getSegmentTemplateKey(LocalCoords* lat_coords,
+                                       int azim_index) {
+
+  LocalCoords* local = lat_coords->getNext();
+  int64_t x = llround(local->getX() / SEGMENT_TEMPLATE_PRECISION);
+  int64_t y = llround(local->getY() / SEGMENT_TEMPLATE_PRECISION);
+
+  FSRKey key;
+  key.append(lat_coords->getLattice()->getId());
+  key.append(local->getUniverse()->getId());
+  key.append(azim_index);
+  key.append(int(x >> 32));
+  key.append(int(x & 0xFFFFFFFF));
+  key.append(int(y >> 32));
+  key.append(int(y & 0xFFFFFFFF));
+
+  return key;
+}
+
+
+/**
+ * @brief Returns the offset of an FSR among the FSRs found within the
+ *        Universe filling a template Lattice cell.
+ * @details The offset is the same for every instance of the Lattice cell
+ *          filled by the Universe, such that segment templates refer to
+ *          their FSRs by offset. New offsets are only drawn while recording
+ *          segment templates.
+ * @param universe_id the ID of the Universe filling the Lattice cell
+ * @param suffix the part of the FSR key below the level of the Lattice cell
+ * @return the offset of the FSR
+ */
+int Geometry::getTemplateFSROffset(int universe_id, const FSRKey& suffix) {
+
+  FSRKey key;
+  key.append(universe_id);
+  for (int l=0; l < suffix._length; l++)
+    key.append(suffix._path[l]);
+
+  int offset;
+
+#pragma omp critical (segment_template_offsets)
+  {
+    std::map<FSRKey, int>::iterator iter = _template_fsr_offsets.find(key);
+    if (iter != _template_fsr_offsets.end())
+      offset = iter->second;
+    else {
+      offset = _template_num_fsrs[universe_id]++;
+      _template_fsr_offsets[key] = offset;
+    }
+  }
+
+  return offset;
+}
+
+
+/**
+ * @brief Returns the FSR IDs of an instance of a template Lattice cell,
+ *        indexed by the offsets in its segment templates.
+ * @details The FSR IDs are allocated as -1 for each offset drawn so far for
+ *          the Universe filling the Lattice cell, and are filled in as the
+ *          segment templates are replayed.
+ * @param prefix the FSR key prefix of the Lattice cell instance
+ * @param universe_id the ID of the Universe filling the Lattice cell
+ * @return a pointer to the FSR IDs of the Lattice cell instance
+ */
+std::vector<int>* Geometry::getLatticeCellFSRs(const FSRKey& prefix,
+                                               int universe_id) {
+
+  std::vector<int>* fsr_ids;
+  if (_lattice_cell_fsrs.find(prefix, fsr_ids))
+    return fsr_ids;
+
+  int num_fsrs;
+
+#pragma omp critical (segment_template_offsets)
+  num_fsrs = _template_num_fsrs[universe_id];
+
+  /* Use the FSR IDs of another thread which added the instance first */
+  fsr_ids = new std::vector<int>(num_fsrs, -1);
+  if (_lattice_cell_fsrs.insert_and_get_count(prefix, fsr_ids) == -1) {
+    delete fsr_ids;
+    fsr_ids = _lattice_cell_fsrs.at(prefix);
+  }
+
+  return fsr_ids;
+}
+
+
 /**
  * @brief Find and return the ID of the flat source region that a given
  *        LocalCoords object resides within.
@@ -559,59 +1064,76 @@ Cell* Geometry::findNextCell(LocalCoords* coords) {
  */
 int Geometry::findFSRId(LocalCoords* coords) {
 
-  int fsr_id;
-  LocalCoords* curr = coords;
-  curr = coords->getLowestLevel();
-
   /* Generate unique FSR key */
-  std::string fsr_key = getFSRKey(coords);
-
-  /* If FSR has not been encountered, update FSR maps and vectors */
-  if (!_FSR_keys_map.contains(fsr_key)) {
-
-    /* Try to get a clean copy of the fsr_id, adding the FSR data
-       if necessary where -1 indicates the key was already added */
-    fsr_id = _FSR_keys_map.insert_and_get_count(fsr_key, NULL);
-    if (fsr_id == -1)
-    {
-      fsr_data volatile* fsr;
-      do {
-        fsr = _FSR_keys_map.at(fsr_key);
-      } while (fsr == NULL);
-      fsr_id = fsr->_fsr_id;
-    }
-    else {
+  FSRKey fsr_key = getFSRKey(coords);
 
-      /* Add FSR information to FSR key map and FSR_to vectors */
-      fsr_data* fsr = new fsr_data;
-      fsr->_fsr_id = fsr_id;
-      _FSR_keys_map.update(fsr_key, fsr);
-      Point* point = new Point();
-      point->setCoords(coords->getHighestLevel()->getX(),
-                       coords->getHighestLevel()->getY(),
-                       coords->getHighestLevel()->getZ());
-
-      /* Get the cell that contains coords */
-      Cell* cell = findCellContainingCoords(curr);
-      fsr->_point = point;
-      fsr->_mat_id = cell->getFillMaterial()->getId();
-
-      /* If CMFD acceleration is on, add FSR CMFD cell to FSR data */
-      if (_cmfd != NULL)
-        fsr->_cmfd_cell = _cmfd->findCmfdCell(coords->getHighestLevel());
-    }
+  /* Get the Material filling the Cell that contains coords */
+  Material* material = coords->getLowestLevel()->getCell()->getFillMaterial();
+
+  return findFSRId(fsr_key, coords, material);
+}
+
+
+/**
+ * @brief Find and return the ID of the flat source region with a given FSR
+ *        key, adding the FSR if it has not yet been encountered.
+ * @param fsr_key the FSR key
+ * @param coords a LocalCoords object pointer whose highest level lies in
+ *        the FSR
+ * @param material a pointer to the Material filling the FSR
+ * @return the FSR ID for the FSR key
+ */
+int Geometry::findFSRId(const FSRKey& fsr_key, LocalCoords* coords,
+                        Material* material) {
+
+  /* Count the lookup for this thread. Threads beyond those for which the
+   * counters were allocated are not counted. */
+  long* counts = NULL;
+  size_t index = (size_t) omp_get_thread_num() * FSR_LOOKUP_COUNT_STRIDE;
+  if (index < _fsr_lookup_counts.size()) {
+    counts = &_fsr_lookup_counts[index];
+    counts[0]++;
   }
 
-  /* If FSR has already been encountered, get the fsr id from map */
-  else {
-    fsr_data volatile* fsr;
+  /* If FSR has been encountered, get the fsr id from its data, which is
+   * only unset while the inserting thread draws the fsr id */
+  fsr_data* fsr;
+  if (_FSR_keys_map.find(fsr_key, fsr)) {
+    int fsr_id;
     do {
-      fsr = _FSR_keys_map.at(fsr_key);
-    } while (fsr == NULL);
+      fsr_id = ((fsr_data volatile*) fsr)->_fsr_id;
+    } while (fsr_id == -1);
+
+    if (counts != NULL)
+      counts[1]++;
+    return fsr_id;
+  }
 
-    fsr_id = fsr->_fsr_id;
+  /* Create the FSR data before adding it to the FSR keys map, such that
+   * its value is complete once it is visible to other threads */
+  fsr = new fsr_data;
+  Point* point = new Point();
+  point->setCoords(coords->getHighestLevel()->getX(),
+                   coords->getHighestLevel()->getY(),
+                   coords->getHighestLevel()->getZ());
+
+  fsr->_point = point;
+  fsr->_mat_id = material->getId();
+
+  /* If CMFD acceleration is on, add FSR CMFD cell to FSR data */
+  if (_cmfd != NULL)
+    fsr->_cmfd_cell = _cmfd->findCmfdCell(coords->getHighestLevel());
+
+  /* Add the FSR data, where -1 indicates another thread added the FSR
+   * first */
+  int fsr_id = _FSR_keys_map.insert_and_get_count(fsr_key, fsr);
+  if (fsr_id == -1) {
+    delete fsr;
+    return findFSRId(fsr_key, coords, material);
   }
 
+  fsr->_fsr_id = fsr_id;
+
   return fsr_id;
 }
 
@@ -625,7 +1147,7 @@ int Geometry::findFSRId(LocalCoords* coords) {
 int Geometry::getFSRId(LocalCoords* coords) {
 
   int fsr_id = 0;
-  std::string fsr_key;
+  FSRKey fsr_key;
 
   try {
     fsr_key = getFSRKey(coords);
@@ -633,7 +1155,7 @@ int Geometry::getFSRId(LocalCoords* coords) {
   }
   catch(std::exception &e) {
     log_printf(ERROR, "Could not find FSR ID with key: %s. Try creating "
-               "geometry with finer track spacing", fsr_key.c_str());
+               "geometry with finer track spacing", fsr_key.toString().c_str());
   }
 
   return fsr_id;
@@ -681,74 +1203,74 @@ Point* Geometry::getFSRCentroid(int fsr_id) {
 
 
 /**
- * @brief Generate a string FSR "key" that identifies an FSR by its
- *        unique hierarchical lattice/universe/cell structure.
+ * @brief Generate an FSR "key" that identifies an FSR by its unique
+ *        hierarchical lattice/universe/cell structure.
  * @details Since not all FSRs will reside on the absolute lowest universe
  *          level and Cells might overlap other cells, it is important to
  *          have a method for uniquely identifying FSRs. This method
- *          creates a unique FSR key by constructing a structured string
- *          that describes the hierarchy of lattices/universes/cells.
+ *          creates a unique FSR key from the path of Cells and Lattice
+ *          cells through the hierarchy of lattices/universes/cells. The
+ *          Cell at the lowest level is the Material-filled Cell of the FSR.
  * @param coords a LocalCoords object pointer
  * @return the FSR key
  */
-std::string Geometry::getFSRKey(LocalCoords* coords) {
+FSRKey Geometry::getFSRKey(LocalCoords* coords) {
+  return getFSRKeyPrefix(coords, coords->getLowestLevel());
+}
+
+
+/**
+ * @brief Generate the part of the FSR key describing the hierarchy of
+ *        lattices/universes above and including a given level.
+ * @details This is the leading part of the FSR key returned by
+ *          Geometry::getFSRKey() for any LocalCoords within the same
+ *          lattice cell or universe at the given level. The key starts with
+ *          the CMFD cell, followed by the ID of the Cell at each Universe
+ *          level and the linear index of the Lattice cell at each Lattice
+ *          level.
+ * @param coords a LocalCoords object pointer
+ * @param last the lowest level LocalCoords to describe in the key
+ * @return the leading part of the FSR key
+ */
+FSRKey Geometry::getFSRKeyPrefix(LocalCoords* coords, LocalCoords* last) {
 
-  std::stringstream key;
+  FSRKey key;
   LocalCoords* curr = coords->getHighestLevel();
-  std::ostringstream curr_level_key;
 
   /* If CMFD is on, get CMFD latice cell and write to key */
   if (_cmfd != NULL) {
-      curr_level_key << _cmfd->getLattice()->getLatX(curr->getPoint());
-      key << "CMFD = (" << curr_level_key.str() << ", ";
-      curr_level_key.str(std::string());
-      curr_level_key << _cmfd->getLattice()->getLatY(curr->getPoint());
-      key << curr_level_key.str() << ") : ";
+    Lattice* cmfd_lattice = _cmfd->getLattice();
+    key.append(cmfd_lattice->getLatX(curr->getPoint()) +
+               cmfd_lattice->getNumX() *
+               cmfd_lattice->getLatY(curr->getPoint()));
   }
+  else
+    key.append(-1);
 
-  /* Descend the linked list hierarchy until the lowest level has
+  /* Descend the linked list hierarchy until the last level has
    * been reached */
   while (curr != NULL) {
 
-    /* Clear string stream */
-    curr_level_key.str(std::string());
-
     if (curr->getType() == LAT) {
 
-      /* Write lattice ID and lattice cell to key */
-      curr_level_key << curr->getLattice()->getId();
-      key << "LAT = " << curr_level_key.str() << " (";
-      curr_level_key.str(std::string());
-      curr_level_key << curr->getLatticeX();
-      key << curr_level_key.str() << ", ";
-      curr_level_key.str(std::string());
-      curr_level_key << curr->getLatticeY();
-      key << curr_level_key.str() << ", ";
-      curr_level_key.str(std::string());
-      curr_level_key << curr->getLatticeZ();
-      key << curr_level_key.str() << ") : ";
-    }
-    else {
-      /* write universe ID to key */
-      curr_level_key << curr->getUniverse()->getId();
-      key << "UNIV = " << curr_level_key.str() << " : ";
+      /* Write the linear index of the lattice cell to key */
+      Lattice* lattice = curr->getLattice();
+      key.append(curr->getLatticeX() + lattice->getNumX() *
+                 (curr->getLatticeY() + lattice->getNumY() *
+                  curr->getLatticeZ()));
     }
+    else
+      /* Write the ID of the cell filling this universe level to key */
+      key.append(curr->getCell()->getId());
 
-    /* If lowest coords reached break; otherwise get next coords */
-    if (curr->getNext() == NULL)
+    /* If last coords reached break; otherwise get next coords */
+    if (curr == last || curr->getNext() == NULL)
       break;
     else
       curr = curr->getNext();
   }
 
-  /* clear string stream */
-  curr_level_key.str(std::string());
-
-  /* write cell id to key */
-  curr_level_key << curr->getCell()->getId();
-  key << "CELL = " << curr_level_key.str();
-
-  return key.str();
+  return key;
 }
 
 
@@ -767,8 +1289,8 @@ void Geometry::subdivideCells() {
 
   /* Compute the max radius as the distance from the center to a corner
   * of the geometry. */
-  double dx = getWidthX() / 2.0;
-  double dy = getWidthY() / 2.0;
+  double dx = (_root_universe->getMaxX() - _root_universe->getMinX()) / 2.0;
+  double dy = (_root_universe->getMaxY() - _root_universe->getMinY()) / 2.0;
   double max_radius = sqrt(dx*dx + dy*dy);
 
   /* Recursively subdivide Cells into rings and sectors */
@@ -781,8 +1303,8 @@ void Geometry::subdivideCells() {
  *        initialize CMFD.
  * @details This method is intended to be called by the user before initiating
  *          source iteration. This method first subdivides all Cells by calling
- *          the Geometry::subdivideCells() method. Then it initializes the CMFD
- *          object.
+ *          the Geometry::subdivideCells() method. Then it builds the grids of
+ *          candidate Cells used to find the Cell containing a point.
  * @brief neighbor_cells whether to use neighbor cell optimizations
  */
 void Geometry::initializeFSRs(bool neighbor_cells) {
@@ -792,6 +1314,9 @@ void Geometry::initializeFSRs(bool neighbor_cells) {
   /* Build collections of neighbor Cells for optimized ray tracing */
   if (neighbor_cells)
     _root_universe->buildNeighbors();
+
+  /* Build grids of candidate Cells for optimized ray tracing */
+  _root_universe->buildCellGrid();
 }
 
 
@@ -801,22 +1326,45 @@ void Geometry::initializeFSRs(bool neighbor_cells) {
  * @details This method starts at the beginning of a Track and finds successive
  *          intersection points with FSRs as the Track crosses through the
  *          Geometry and creates segment structs and adds them to the Track.
+ *          If an MOCKernel is provided, each segment is instead passed to the
+ *          kernel as it is formed and the Track is left unchanged, which is
+ *          used for on-the-fly ray tracing.
+ *
+ *          If segment templates are enabled, the segments formed across each
+ *          lowest level Lattice cell are recorded as a template the first
+ *          time a Track enters the Lattice cell's Universe at a given local
+ *          point along its azimuthal angle. Tracks entering any instance of
+ *          that Universe at the same local point replay the template rather
+ *          than ray tracing, finding the FSR IDs of the Lattice cell instance
+ *          by their offsets in the template.
  * @param track a pointer to a track to segmentize
+ * @param kernel an optional MOCKernel to apply to each segment
  */
-void Geometry::segmentize(Track* track) {
+void Geometry::segmentize(Track* track, MOCKernel* kernel) {
 
   /* Track starting Point coordinates and azimuthal angle */
   double x0 = track->getStart()->getX();
   double y0 = track->getStart()->getY();
   double z0 = track->getStart()->getZ();
   double phi = track->getPhi();
+  int azim_index = track->getAzimAngleIndex();
   double delta_x, delta_y;
 
   /* Length of each segment */
+  double distance;
   FP_PRECISION length;
   Material* material;
+  FSRKey fsr_key;
   int fsr_id;
-  int num_segments;
+
+  /* The distance travelled along the Track, the distance at which the Track
+   * leaves the Lattice cell it last entered, and the segment template being
+   * recorded across that Lattice cell */
+  double travelled = 0.;
+  double lat_exit = -1.;
+  segment_template* recording = NULL;
+  FSRKey template_key;
+  int prefix_length = 0;
 
   /* Use a LocalCoords for the start and end of each segment */
   LocalCoords start(x0, y0, z0);
@@ -840,6 +1388,99 @@ void Geometry::segmentize(Track* track) {
    * Geometry */
   while (curr != NULL) {
 
+    /* If the Track has left the last Lattice cell it entered, store the
+     * segments recorded across it and look for a template for the next */
+    if (_use_segment_templates && travelled > lat_exit) {
+
+      if (recording != NULL) {
+        if (_segment_templates.insert_and_get_count(template_key,
+                                                    recording) == -1)
+          delete recording;
+        recording = NULL;
+      }
+
+      /* Find the lowest level Lattice cell containing the Track */
+      LocalCoords* lat_coords = NULL;
+      for (LocalCoords* c = &end; c != NULL; c = c->getNext())
+        if (c->getType() == LAT)
+          lat_coords = c;
+
+      if (lat_coords != NULL) {
+
+        double lat_dist = lat_coords->getLattice()->minSurfaceDist(lat_coords);
+        lat_exit = travelled + lat_dist;
+
+        if (isTemplateLattice(lat_coords, lat_dist)) {
+
+          template_key = getSegmentTemplateKey(lat_coords, azim_index);
+          FSRKey prefix = getFSRKeyPrefix(&end, lat_coords);
+
+          /* Replay the segments across the Lattice cell from a template */
+          if (_segment_templates.contains(template_key)) {
+
+            segment_template* tmpl = _segment_templates.at(template_key);
+            std::vector<int>* cell_fsrs =
+              getLatticeCellFSRs(prefix, tmpl->_universe_id);
+            int num_cell_fsrs = cell_fsrs->size();
+            double x = end.getX();
+            double y = end.getY();
+
+            for (int s=0; s < tmpl->_lengths.size(); s++) {
+
+              distance = tmpl->_lengths[s];
+              length = FP_PRECISION(distance);
+              material = tmpl->_materials[s];
+
+              /* Find the FSR ID from the Lattice cell instance's FSR IDs,
+               * or else from the FSR key formed by the instance's prefix */
+              int offset = tmpl->_fsr_offsets[s];
+              fsr_id = -1;
+              if (offset < num_cell_fsrs)
+                fsr_id = (*cell_fsrs)[offset];
+
+              if (fsr_id == -1) {
+                LocalCoords point(x, y, z0);
+                fsr_key = prefix;
+                const FSRKey& suffix = tmpl->_suffixes[s];
+                for (int l=0; l < suffix._length; l++)
+                  fsr_key.append(suffix._path[l]);
+                fsr_id = findFSRId(fsr_key, &point, material);
+                if (offset < num_cell_fsrs)
+                  (*cell_fsrs)[offset] = fsr_id;
+              }
+
+              if (kernel != NULL)
+                kernel->execute(length, material, fsr_id, -1, -1);
+              else {
+                segment new_segment;
+                new_segment._material = material;
+                new_segment._length = length;
+                new_segment._region_id = fsr_id;
+                track->addSegment(&new_segment);
+              }
+
+              x += cos(phi) * distance;
+              y += sin(phi) * distance;
+              travelled += distance;
+            }
+
+            /* Find the Cell beyond the Lattice cell */
+            end.prune();
+            end.setX(x);
+            end.setY(y);
+            curr = findCellContainingCoords(&end);
+            continue;
+          }
+
+          /* Record the segments across the Lattice cell as a template */
+          recording = new segment_template;
+          Universe* universe = lat_coords->getNext()->getUniverse();
+          recording->_universe_id = universe->getId();
+          prefix_length = prefix._length;
+        }
+      }
+    }
+
     end.copyCoords(&start);
     end.setPhi(phi);
 
@@ -853,15 +1494,30 @@ void Geometry::segmentize(Track* track) {
                  "point: x = %f, y = %f", start.getX(), start.getY());
 
     /* Find the segment length, Material and FSR ID */
-    length = FP_PRECISION(end.getPoint()->distanceToPoint(start.getPoint()));
+    distance = end.getPoint()->distanceToPoint(start.getPoint());
+    length = FP_PRECISION(distance);
     material = prev->getFillMaterial();
-    fsr_id = findFSRId(&start);
+    fsr_key = getFSRKey(&start);
+    fsr_id = findFSRId(fsr_key, &start, material);
+
+    /* Add the segment to the template being recorded */
+    if (recording != NULL) {
+      recording->_lengths.push_back(distance);
+      recording->_materials.push_back(material);
+      FSRKey suffix;
+      for (int l=prefix_length; l < fsr_key._length; l++)
+        suffix.append(fsr_key._path[l]);
+      recording->_suffixes.push_back(suffix);
+      recording->_fsr_offsets.push_back(
+        getTemplateFSROffset(recording->_universe_id, suffix));
+    }
+    travelled += distance;
 
     /* Create a new Track segment */
-    segment* new_segment = new segment;
-    new_segment->_material = material;
-    new_segment->_length = length;
-    new_segment->_region_id = fsr_id;
+    segment new_segment;
+    new_segment._material = material;
+    new_segment._length = length;
+    new_segment._region_id = fsr_id;
 
     log_printf(DEBUG, "segment start x = %f, y = %f; end x = %f, y = %f",
                start.getX(), start.getY(), end.getX(), end.getY());
@@ -877,8 +1533,8 @@ void Geometry::segmentize(Track* track) {
       start.adjustCoords(-TINY_MOVE);
       end.adjustCoords(-TINY_MOVE);
 
-      new_segment->_cmfd_surface_fwd = _cmfd->findCmfdSurface(cmfd_cell, &end);
-      new_segment->_cmfd_surface_bwd =
+      new_segment._cmfd_surface_fwd = _cmfd->findCmfdSurface(cmfd_cell, &end);
+      new_segment._cmfd_surface_bwd =
         _cmfd->findCmfdSurface(cmfd_cell, &start);
 
       /* Re-nudge segments from surface */
@@ -886,8 +1542,18 @@ void Geometry::segmentize(Track* track) {
       end.adjustCoords(TINY_MOVE);
     }
 
-    /* Add the segment to the Track */
-    track->addSegment(new_segment);
+    /* Apply the kernel to the segment or add the segment to the Track */
+    if (kernel != NULL)
+      kernel->execute(length, material, fsr_id, new_segment._cmfd_surface_fwd,
+                      new_segment._cmfd_surface_bwd);
+    else
+      track->addSegment(&new_segment);
+  }
+
+  /* Store the segments recorded across the last Lattice cell */
+  if (recording != NULL) {
+    if (_segment_templates.insert_and_get_count(template_key, recording) == -1)
+      delete recording;
   }
 
   log_printf(DEBUG, "Created %d segments for Track: %s",
@@ -910,17 +1576,17 @@ void Geometry::segmentize(Track* track) {
 void Geometry::initializeFSRVectors() {
 
   /* get keys and values from map */
-  std::string *key_list = _FSR_keys_map.keys();
+  FSRKey *key_list = _FSR_keys_map.keys();
   fsr_data **value_list = _FSR_keys_map.values();
 
   /* allocate vectors */
   int num_FSRs = _FSR_keys_map.size();
-  _FSRs_to_keys = std::vector<std::string>(num_FSRs);
+  _FSRs_to_keys = std::vector<FSRKey>(num_FSRs);
 
   /* fill vectors key and material ID information */
 #pragma omp parallel for
   for (int i=0; i < num_FSRs; i++) {
-    std::string key = key_list[i];
+    FSRKey key = key_list[i];
     fsr_data* fsr = value_list[i];
     int fsr_id = fsr->_fsr_id;
     _FSRs_to_keys.at(fsr_id) = key;
@@ -941,6 +1607,193 @@ void Geometry::initializeFSRVectors() {
 }
 
 
+/**
+ * @brief Enables the reuse of segments across repeated Lattice cells.
+ * @details Segment templates formed for a previous Track laydown are
+ *          deleted. Thereafter Geometry::segmentize() records the segments
+ *          formed across each Lattice cell as a template, which is replayed
+ *          rather than ray traced for each Lattice cell entered at the same
+ *          local point along the same azimuthal angle.
+ */
+void Geometry::initializeSegmentTemplates() {
+  clearSegmentTemplates();
+  _use_segment_templates = true;
+}
+
+
+/**
+ * @brief Deletes the segment templates and disables the reuse of segments
+ *        across repeated Lattice cells.
+ */
+void Geometry::clearSegmentTemplates() {
+
+  if (_segment_templates.size() != 0) {
+    segment_template** templates = _segment_templates.values();
+
+    for (int i=0; i < _segment_templates.size(); i++)
+      delete templates[i];
+    delete[] templates;
+
+    _segment_templates.clear();
+  }
+
+  _template_fsr_offsets.clear();
+  _template_num_fsrs.clear();
+  clearLatticeCellFSRs();
+  _use_segment_templates = false;
+}
+
+
+/**
+ * @brief Deletes the FSR IDs of the template Lattice cell instances, which
+ *        must be done whenever the FSRs are renumbered.
+ */
+void Geometry::clearLatticeCellFSRs() {
+
+  if (_lattice_cell_fsrs.size() != 0) {
+    std::vector<int>** fsr_ids = _lattice_cell_fsrs.values();
+
+    for (int i=0; i < _lattice_cell_fsrs.size(); i++)
+      delete fsr_ids[i];
+    delete[] fsr_ids;
+
+    _lattice_cell_fsrs.clear();
+  }
+}
+
+
+/**
+ * @brief Resets the counts of FSR lookups, allocating counters for each
+ *        thread.
+ * @details This must not be called from within a parallel region.
+ */
+void Geometry::resetFSRLookupCounts() {
+  _fsr_lookup_counts.assign
+      ((size_t) omp_get_max_threads() * FSR_LOOKUP_COUNT_STRIDE, 0);
+}
+
+
+#ifdef MPIx
+/**
+ * @brief Merges the FSRs discovered by each rank of an MPI communicator into
+ *        a single set of FSRs with the same FSR IDs on every rank.
+ * @details Ranks which ray trace different subsets of the Tracks discover
+ *          different subsets of the FSRs in a nondeterministic order. The
+ *          FSR keys, characteristic points, Material IDs and CMFD cells are
+ *          gathered from all ranks, FSRs missing on this rank are added to
+ *          the FSR keys map and all FSRs are renumbered in the sorted order
+ *          of their keys. This must be called after segmentation and before
+ *          Geometry::initializeFSRVectors().
+ * @param comm the MPI communicator of the ranks sharing the FSRs
+ * @return a vector mapping the local FSR IDs to the synchronized FSR IDs
+ */
+std::vector<int> Geometry::synchronizeFSRs(MPI_Comm comm) {
+
+  int num_ranks;
+  MPI_Comm_size(comm, &num_ranks);
+
+  /* Get keys and values from map */
+  FSRKey* key_list = _FSR_keys_map.keys();
+  fsr_data** value_list = _FSR_keys_map.values();
+  int num_FSRs = _FSR_keys_map.size();
+
+  /* Pack the characteristic points and data of the local FSRs */
+  std::vector<double> points(3*num_FSRs);
+  std::vector<int> data(2*num_FSRs);
+
+  for (int i=0; i < num_FSRs; i++) {
+    fsr_data* fsr = value_list[i];
+    points[3*i] = fsr->_point->getX();
+    points[3*i+1] = fsr->_point->getY();
+    points[3*i+2] = fsr->_point->getZ();
+    data[2*i] = fsr->_mat_id;
+    data[2*i+1] = (_cmfd != NULL) ? fsr->_cmfd_cell : -1;
+  }
+
+  /* Gather the number of FSRs on each rank */
+  std::vector<int> counts(num_ranks);
+  MPI_Allgather(&num_FSRs, 1, MPI_INT, &counts[0], 1, MPI_INT, comm);
+
+  std::vector<int> key_counts(num_ranks), key_offsets(num_ranks);
+  std::vector<int> point_counts(num_ranks), data_counts(num_ranks);
+  std::vector<int> point_offsets(num_ranks), data_offsets(num_ranks);
+  int num_gathered = 0;
+
+  for (int r=0; r < num_ranks; r++) {
+    key_counts[r] = sizeof(FSRKey) * counts[r];
+    point_counts[r] = 3 * counts[r];
+    data_counts[r] = 2 * counts[r];
+    key_offsets[r] = sizeof(FSRKey) * num_gathered;
+    point_offsets[r] = 3 * num_gathered;
+    data_offsets[r] = 2 * num_gathered;
+    num_gathered += counts[r];
+  }
+
+  /* Gather the FSRs from all ranks, exchanging the fixed size keys as raw
+   * bytes */
+  std::vector<FSRKey> all_keys(num_gathered);
+  std::vector<double> all_points(3*num_gathered);
+  std::vector<int> all_data(2*num_gathered);
+
+  MPI_Allgatherv(key_list, sizeof(FSRKey)*num_FSRs, MPI_BYTE, &all_keys[0],
+                 &key_counts[0], &key_offsets[0], MPI_BYTE, comm);
+  MPI_Allgatherv(&points[0], 3*num_FSRs, MPI_DOUBLE, &all_points[0],
+                 &point_counts[0], &point_offsets[0], MPI_DOUBLE, comm);
+  MPI_Allgatherv(&data[0], 2*num_FSRs, MPI_INT, &all_data[0],
+                 &data_counts[0], &data_offsets[0], MPI_INT, comm);
+
+  /* Find the first gathered instance of each unique FSR key */
+  std::map<FSRKey, int> unique_keys;
+  for (int i=0; i < num_gathered; i++)
+    unique_keys.insert(std::make_pair(all_keys[i], i));
+
+  /* Number the FSRs in the sorted order of their keys */
+  std::map<FSRKey, int> global_ids;
+  int fsr_id = 0;
+  std::map<FSRKey, int>::iterator iter;
+  for (iter = unique_keys.begin(); iter != unique_keys.end(); ++iter) {
+    global_ids[iter->first] = fsr_id;
+    fsr_id++;
+  }
+
+  /* Renumber the local FSRs */
+  std::vector<int> local_to_global(num_FSRs);
+  for (int i=0; i < num_FSRs; i++) {
+    fsr_data* fsr = value_list[i];
+    int global_id = global_ids[key_list[i]];
+    local_to_global.at(fsr->_fsr_id) = global_id;
+    fsr->_fsr_id = global_id;
+  }
+
+  /* Add the FSRs discovered only by other ranks */
+  for (iter = unique_keys.begin(); iter != unique_keys.end(); ++iter) {
+
+    if (_FSR_keys_map.contains(iter->first))
+      continue;
+
+    int i = iter->second;
+    fsr_data* fsr = new fsr_data;
+    fsr->_fsr_id = global_ids[iter->first];
+    fsr->_point = new Point();
+    fsr->_point->setCoords(all_points[3*i], all_points[3*i+1],
+                           all_points[3*i+2]);
+    fsr->_mat_id = all_data[2*i];
+    fsr->_cmfd_cell = all_data[2*i+1];
+    _FSR_keys_map.insert(iter->first, fsr);
+  }
+
+  /* Delete key and value lists */
+  delete[] key_list;
+  delete[] value_list;
+
+  /* Forget the FSR IDs of the Lattice cell instances */
+  clearLatticeCellFSRs();
+
+  return local_to_global;
+}
+#endif
+
+
 /**
  * @brief Determines the fissionability of each Universe within this Geometry.
  * @details A Universe is determined fissionable if it contains a Cell
@@ -1039,7 +1892,8 @@ std::vector<int> Geometry::getSpatialDataOnGrid(std::vector<double> grid_x,
 						double zcoord,
 						const char* domain_type) {
 
-  LocalCoords* point;
+  /* Each thread reuses a LocalCoords for the points it looks up */
+  LocalCoords point;
   Cell* cell;
 
   /* Instantiate a vector to hold the domain IDs */
@@ -1055,16 +1909,13 @@ std::vector<int> Geometry::getSpatialDataOnGrid(std::vector<double> grid_x,
       for (int j=0; j < num_y; j++) {
 
 	/* Find the Cell containing this point */
-	point = new LocalCoords(grid_x[i], grid_y[j], zcoord);
-	point->setUniverse(_root_universe);
-	cell = findCellContainingCoords(point);
+	point.prune();
+	point.getPoint()->setCoords(grid_x[i], grid_y[j], zcoord);
+	point.setUniverse(_root_universe);
+	cell = findCellContainingCoords(&point);
 
 	/* Extract the ID of the domain of interest */
-	domains[i+j*num_x] = getFSRId(point);
-
-	/* Deallocate memory for LocalCoords */
-	point = point->getHighestLevel();
-	point->prune();
+	domains[i+j*num_x] = getFSRId(&point);
       }
     }
   }
@@ -1077,16 +1928,13 @@ std::vector<int> Geometry::getSpatialDataOnGrid(std::vector<double> grid_x,
       for (int j=0; j < num_y; j++) {
 
 	/* Find the Cell containing this point */
-	point = new LocalCoords(grid_x[i], grid_y[j], zcoord);
-	point->setUniverse(_root_universe);
-	cell = findCellContainingCoords(point);
+	point.prune();
+	point.getPoint()->setCoords(grid_x[i], grid_y[j], zcoord);
+	point.setUniverse(_root_universe);
+	cell = findCellContainingCoords(&point);
 
 	/* Extract the ID of the domain of interest */
 	domains[i+j*num_x] = cell->getFillMaterial()->getId();
-
-	/* Deallocate memory for LocalCoords */
-	point = point->getHighestLevel();
-	point->prune();
       }
     }
   }
@@ -1099,16 +1947,13 @@ std::vector<int> Geometry::getSpatialDataOnGrid(std::vector<double> grid_x,
       for (int j=0; j < num_y; j++) {
 
 	/* Find the Cell containing this point */
-	point = new LocalCoords(grid_x[i], grid_y[j], zcoord);
-	point->setUniverse(_root_universe);
-	cell = findCellContainingCoords(point);
+	point.prune();
+	point.getPoint()->setCoords(grid_x[i], grid_y[j], zcoord);
+	point.setUniverse(_root_universe);
+	cell = findCellContainingCoords(&point);
 
 	/* Extract the ID of the domain of interest */
 	domains[i+j*num_x] = cell->getId();
-
-	/* Deallocate memory for LocalCoords */
-	point = point->getHighestLevel();
-	point->prune();
       }
     }
   }
@@ -1224,7 +2069,7 @@ void Geometry::initializeCmfd() {
  * @brief Returns a pointer to the map that maps FSR keys to FSR IDs
  * @return pointer to _FSR_keys_map map of FSR keys to FSR IDs
  */
-ParallelHashMap<std::string, fsr_data*>& Geometry::getFSRKeysMap() {
+ParallelHashMap<FSRKey, fsr_data*>& Geometry::getFSRKeysMap() {
   return _FSR_keys_map;
 }
 
@@ -1233,7 +2078,7 @@ ParallelHashMap<std::string, fsr_data*>& Geometry::getFSRKeysMap() {
  * @brief Returns the vector that maps FSR IDs to FSR key hashes
  * @return _FSR_keys_map map of FSR keys to FSR IDs
  */
-std::vector<std::string>& Geometry::getFSRsToKeys() {
+std::vector<FSRKey>& Geometry::getFSRsToKeys() {
   return _FSRs_to_keys;
 }
 
@@ -1259,7 +2104,7 @@ bool Geometry::withinBounds(LocalCoords* coords) {
 
 /**
  * @brief Sets the centroid for an FSR
- * @details The _FSR_keys_map stores a hash of a std::string representing
+ * @details The _FSR_keys_map stores an FSRKey representing
  *          the Lattice/Cell/Universe hierarchy for a unique region
  *          and the associated FSR data. _centroid is a point that represents
  *          the numerical centroid of an FSR computed using all segments
@@ -1282,13 +2127,9 @@ void Geometry::setFSRCentroid(int fsr, Point* centroid) {
 Cell* Geometry::findCellContainingFSR(int fsr_id) {
 
   Point* point = _FSR_keys_map.at(_FSRs_to_keys[fsr_id])->_point;
-  LocalCoords* coords = new LocalCoords(point->getX(), point->getY(),
-                                        point->getZ());
-  coords->setUniverse(_root_universe);
-  Cell* cell = findCellContainingCoords(coords);
-
-  coords->prune();
-  delete coords;
+  LocalCoords coords(point->getX(), point->getY(), point->getZ());
+  coords.setUniverse(_root_universe);
+  Cell* cell = findCellContainingCoords(&coords);
 
   return cell;
 }
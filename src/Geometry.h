@@ -18,14 +18,24 @@
 #include <sys/stat.h>
 #include <sstream>
 #include <string>
+#include <map>
 #include <omp.h>
 #include <functional>
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
 #include "ParallelHashMap.h"
+#ifdef MPIx
+#include <mpi.h>
+#endif
 #endif
 
 /** Forward declaration of Cmfd class */
 class Cmfd;
 
+/** Forward declaration of MOCKernel class */
+class MOCKernel;
+
 /**
  * @struct fsr_data
  * @brief A fsr_data struct represents an FSR with a unique FSR ID
@@ -50,8 +60,10 @@ struct fsr_data {
   /** Global numerical centroid in Root Universe */
   Point* _centroid;
 
-  /** Constructor for FSR data initializes centroids and points to NULL */
+  /** Constructor for FSR data initializes centroids and points to NULL
+   *  and the FSR ID to -1 until it is assigned */
   fsr_data() {
+    _fsr_id = -1;
     _centroid = NULL;
     _point = NULL;
   }
@@ -66,6 +78,118 @@ struct fsr_data {
   }
 };
 
+/**
+ * @struct FSRKey
+ * @brief An FSRKey uniquely identifies an FSR by the path through the
+ *        nested Universes which leads to it.
+ * @details The first entry of the path is the CMFD cell, or -1 without CMFD.
+ *          It is followed by one entry for each level of LocalCoords, which
+ *          is the ID of the Cell at a Universe level and the linear index of
+ *          the Lattice cell at a Lattice level. The key has a fixed size such
+ *          that it is hashed and compared without any allocation.
+ */
+struct FSRKey {
+
+  /** The number of entries in the path */
+  int _length;
+
+  /** The path through the nested Universes, padded with -1 */
+  int _path[MAX_FSR_KEY_LENGTH];
+
+  /** Constructor for an FSRKey initializes an empty path */
+  FSRKey() {
+    _length = 0;
+    std::fill(_path, _path + MAX_FSR_KEY_LENGTH, -1);
+  }
+
+  /**
+   * @brief Appends an entry to the path of the FSRKey.
+   * @param entry the Cell ID or Lattice cell index to append
+   */
+  void append(int entry) {
+    if (_length == MAX_FSR_KEY_LENGTH)
+      log_printf(ERROR, "Unable to append to an FSR key with %d entries. "
+                 "Increase MAX_FSR_KEY_LENGTH for Geometries with more "
+                 "levels of nested Universes", MAX_FSR_KEY_LENGTH);
+    else
+      _path[_length++] = entry;
+  }
+
+  /** Returns whether two FSRKeys have the same path */
+  bool operator==(const FSRKey& other) const {
+    return _length == other._length &&
+        memcmp(_path, other._path, _length * sizeof(int)) == 0;
+  }
+
+  /** Orders FSRKeys lexicographically by their paths */
+  bool operator<(const FSRKey& other) const {
+    return std::lexicographical_compare(_path, _path + _length, other._path,
+                                        other._path + other._length);
+  }
+
+  /**
+   * @brief Converts the path of the FSRKey to a character string.
+   * @return a character string representing the FSRKey
+   */
+  std::string toString() const {
+    std::stringstream string;
+    string << "FSR key = (";
+    for (int i=0; i < _length; i++)
+      string << (i == 0 ? "" : ", ") << _path[i];
+    string << ")";
+    return string.str();
+  }
+};
+
+
+#ifndef SWIG
+namespace std {
+
+/**
+ * @brief Hashes an FSRKey with the FNV-1a hash of the entries of its path.
+ */
+template <>
+struct hash<FSRKey> {
+  size_t operator()(const FSRKey& key) const {
+    uint64_t hash = 14695981039346656037ULL;
+    for (int i=0; i < key._length; i++) {
+      hash ^= (uint32_t) key._path[i];
+      hash *= 1099511628211ULL;
+    }
+    return (size_t) (hash ^ (hash >> 32));
+  }
+};
+}
+#endif
+
+
+/**
+ * @struct segment_template
+ * @brief A segment_template struct represents the segments formed along a
+ *        trajectory across a Lattice cell, which are reused for each
+ *        instance of the Lattice cell entered at the same local point.
+ */
+struct segment_template {
+
+  /** The lengths of the segments */
+  std::vector<double> _lengths;
+
+  /** The Materials of the segments */
+  std::vector<Material*> _materials;
+
+  /** The parts of the FSR keys of the segments below the level of the
+   *  Lattice cell, which are the same for each instance of the Lattice cell */
+  std::vector<FSRKey> _suffixes;
+
+  /** The offsets of the FSRs of the segments among the FSRs found within
+   *  the Universe filling the Lattice cell */
+  std::vector<int> _fsr_offsets;
+
+  /** The ID of the Universe filling the Lattice cell */
+  int _universe_id;
+};
+
+
 void reset_auto_ids();
 
 
@@ -99,10 +223,10 @@ private:
   boundaryType _y_max_bc;
 
   /** An map of FSR key hashes to unique fsr_data structs */
-  ParallelHashMap<std::string, fsr_data*> _FSR_keys_map;
+  ParallelHashMap<FSRKey, fsr_data*> _FSR_keys_map;
 
   /** An vector of FSR key hashes indexed by FSR ID */
-  std::vector<std::string> _FSRs_to_keys;
+  std::vector<FSRKey> _FSRs_to_keys;
 
   /* The Universe at the root node in the CSG tree */
   Universe* _root_universe;
@@ -113,8 +237,64 @@ private:
   /* A map of all Material in the Geometry for optimization purposes */
   std::map<int, Material*> _all_materials;
 
+  /** Whether the Geometry is decomposed into spatial domains */
+  bool _domain_decomposed;
+
+  /** The number of spatial domains along the x-axis */
+  int _num_domains_x;
+
+  /** The number of spatial domains along the y-axis */
+  int _num_domains_y;
+
+  /** The x index of this rank's spatial domain */
+  int _domain_index_x;
+
+  /** The y index of this rank's spatial domain */
+  int _domain_index_y;
+
+  /** The ranks of the neighboring spatial domains across each face of this
+   *  rank's domain, indexed by surface (-1 for the Geometry's boundaries) */
+  int _neighbor_domains[NUM_FACES];
+
+#ifdef MPIx
+  /** The Cartesian MPI communicator of the spatial domains */
+  MPI_Comm _MPI_cart;
+#endif
+
+  /** Whether segments are reused across repeated Lattice cells */
+  bool _use_segment_templates;
+
+  /** A map of Lattice cell entry keys to the segments formed across them */
+  ParallelHashMap<FSRKey, segment_template*> _segment_templates;
+
+  /** A map of the FSR key suffixes found within each Universe filling a
+   *  template Lattice cell, led by the Universe ID, to their offsets */
+  std::map<FSRKey, int> _template_fsr_offsets;
+
+  /** The number of FSR key suffixes found within each Universe filling a
+   *  template Lattice cell, indexed by Universe ID */
+  std::map<int, int> _template_num_fsrs;
+
+  /** A map of the FSR key prefixes of template Lattice cell instances to
+   *  their FSR IDs, indexed by the offsets in the segment templates */
+  ParallelHashMap<FSRKey, std::vector<int>*> _lattice_cell_fsrs;
+
+  /** The number of FSR lookups by FSR key and the number of those which found
+   *  an FSR already in the map of FSR keys, for each thread at a stride of
+   *  FSR_LOOKUP_COUNT_STRIDE */
+  std::vector<long> _fsr_lookup_counts;
+
   Cell* findFirstCell(LocalCoords* coords);
   Cell* findNextCell(LocalCoords* coords);
+  double minDomainBoundaryDist(LocalCoords* coords);
+  FSRKey getFSRKeyPrefix(LocalCoords* coords, LocalCoords* last);
+  int findFSRId(const FSRKey& fsr_key, LocalCoords* coords,
+                Material* material);
+  bool isTemplateLattice(LocalCoords* lat_coords, double lat_dist);
+  FSRKey getSegmentTemplateKey(LocalCoords* lat_coords, int azim_index);
+  int getTemplateFSROffset(int universe_id, const FSRKey& suffix);
+  std::vector<int>* getLatticeCellFSRs(const FSRKey& prefix, int universe_id);
+  void clearLatticeCellFSRs();
 
 public:
 
@@ -136,6 +316,18 @@ public:
   boundaryType getMinYBoundaryType();
   boundaryType getMaxYBoundaryType();
   Universe* getRootUniverse();
+  bool isDomainDecomposed();
+  int getNumXDomains();
+  int getNumYDomains();
+  int getDomainIndexX();
+  int getDomainIndexY();
+  int getNeighborDomain(int surface);
+  int getNumSegmentTemplates();
+  long getNumFSRLookups();
+  long getNumFSRLookupHits();
+#ifdef MPIx
+  MPI_Comm getMPICart();
+#endif
   int getNumFSRs();
   int getNumEnergyGroups();
   int getNumMaterials();
@@ -146,14 +338,17 @@ public:
   std::map<int, Cell*> getAllMaterialCells();
   std::map<int, Universe*> getAllUniverses();
   void setRootUniverse(Universe* root_universe);
+#ifdef MPIx
+  void setDomainDecomposition(int num_domains_x, int num_domains_y);
+#endif
 
   Cmfd* getCmfd();
-  std::vector<std::string>& getFSRsToKeys();
+  std::vector<FSRKey>& getFSRsToKeys();
   int getFSRId(LocalCoords* coords);
   Point* getFSRPoint(int fsr_id);
   Point* getFSRCentroid(int fsr_id);
-  std::string getFSRKey(LocalCoords* coords);
-  ParallelHashMap<std::string, fsr_data*>& getFSRKeysMap();
+  FSRKey getFSRKey(LocalCoords* coords);
+  ParallelHashMap<FSRKey, fsr_data*>& getFSRKeysMap();
 
   /* Set parameters */
   void setCmfd(Cmfd* cmfd);
@@ -168,8 +363,14 @@ public:
   /* Other worker methods */
   void subdivideCells();
   void initializeFSRs(bool neighbor_cells=false);
-  void segmentize(Track* track);
+  void segmentize(Track* track, MOCKernel* kernel=NULL);
   void initializeFSRVectors();
+  void initializeSegmentTemplates();
+  void clearSegmentTemplates();
+  void resetFSRLookupCounts();
+#ifdef MPIx
+  std::vector<int> synchronizeFSRs(MPI_Comm comm);
+#endif
   void computeFissionability(Universe* univ=NULL);
   std::vector<int> getSpatialDataOnGrid(std::vector<double> grid_x,
 					std::vector<double> grid_y,
@@ -1,9 +1,10 @@
 #include "LocalCoords.h"
 
 /**
- * @brief Constructor sets the x and y coordinates.
+ * @brief Constructor sets the x, y and z coordinates.
  * @param x the x-coordinate
  * @param y the y-coordinate
+ * @param z the z-coordinate
  */
 LocalCoords::LocalCoords(double x, double y, double z) {
   _coords.setCoords(x, y, z);
@@ -13,13 +14,19 @@ LocalCoords::LocalCoords(double x, double y, double z) {
   _cell = NULL;
   _next = NULL;
   _prev = NULL;
+  _levels = NULL;
+  _level = 0;
 }
 
 
 /**
- * @brief Destructor.
+ * @brief Destructor frees the LocalCoords reserved for the lower nested
+ *        Universe levels if this is the highest level LocalCoords.
  */
-LocalCoords::~LocalCoords() { }
+LocalCoords::~LocalCoords() {
+  if (_level == 0)
+    delete [] _levels;
+}
 
 
 /**
@@ -153,6 +160,50 @@ LocalCoords* LocalCoords::getPrev() const {
 }
 
 
+/**
+ * @brief Return the LocalCoords at the next lower nested Universe level,
+ *        appending it to the linked list if it does not yet exist.
+ * @details The LocalCoords for the lower levels are taken from storage
+ *          which the highest level LocalCoords allocates the first time it
+ *          descends, and which is reused after the linked list is pruned.
+ *          Descending through the nested Universes therefore does not
+ *          allocate memory for each Cell crossed by a Track. A newly
+ *          appended LocalCoords is reset to reside in no Universe or Cell.
+ * @param x the x-coordinate of the next LocalCoords
+ * @param y the y-coordinate of the next LocalCoords
+ * @param z the z-coordinate of the next LocalCoords
+ * @return pointer to the next LocalCoords
+ */
+LocalCoords* LocalCoords::getNextCreate(double x, double y, double z) {
+
+  if (_next == NULL) {
+
+    if (_level + 1 >= MAX_LOCAL_COORDS_LEVELS)
+      log_printf(ERROR, "Unable to descend below level %d of the nested "
+                 "Universes since at most %d levels are supported", _level,
+                 MAX_LOCAL_COORDS_LEVELS);
+
+    /* Allocate the lower levels the first time the linked list descends */
+    if (_levels == NULL)
+      _levels = new LocalCoords[MAX_LOCAL_COORDS_LEVELS - 1];
+
+    _next = &_levels[_level];
+    _next->_phi = 0.;
+    _next->_universe = NULL;
+    _next->_lattice = NULL;
+    _next->_cell = NULL;
+    _next->_next = NULL;
+    _next->_prev = this;
+    _next->_levels = _levels;
+    _next->_level = _level + 1;
+  }
+
+  _next->_coords.setCoords(x, y, z);
+
+  return _next;
+}
+
+
 /**
  * @brief Set the type of LocalCoords (UNIV or LAT).
  * @param type the type for LocalCoords (UNIV or LAT)
@@ -362,21 +413,12 @@ void LocalCoords::updateMostLocal(Point* point) {
 
 
 /**
- * @brief Removes and frees memory for all LocalCoords beyond this one
- *        in the linked list
+ * @brief Removes all LocalCoords beyond this one from the linked list.
+ * @details The storage of the removed LocalCoords is kept by the highest
+ *          level LocalCoords and reused by LocalCoords::getNextCreate().
  */
 void LocalCoords::prune() {
 
-  LocalCoords* curr = getLowestLevel();
-  LocalCoords* next = curr->getPrev();
-
-  /* Iterate over LocalCoords beneath this one in the linked list */
-  while (curr != this) {
-    next = curr->getPrev();
-    delete curr;
-    curr = next;
-  }
-
   /* Set the next LocalCoord in the linked list to null */
   setNext(NULL);
 }
@@ -386,7 +428,8 @@ void LocalCoords::prune() {
  * @brief Copies a LocalCoords' values to this one.
  * details Given a pointer to a LocalCoords, it first prunes it and then creates
  *         a copy of the linked list of LocalCoords in the linked list below
- *         this one to give to the input LocalCoords.
+ *         this one to give to the input LocalCoords. The copy reuses the
+ *         storage reserved by the input LocalCoords for its lower levels.
  * @param coords a pointer to the LocalCoords to give the linked list copy to
  */
 void LocalCoords::copyCoords(LocalCoords* coords) {
@@ -420,19 +463,9 @@ void LocalCoords::copyCoords(LocalCoords* coords) {
 
     curr1 = curr1->getNext();
 
-    if (curr1 != NULL && curr2->getNext() == NULL) {
-      LocalCoords* new_coords = new LocalCoords(0.0, 0.0, 0.0);
-      curr2->setNext(new_coords);
-      new_coords->setPrev(curr2);
-      curr2 = new_coords;
-    }
-    else if (curr1 != NULL)
-      curr2 = curr2->getNext();
+    if (curr1 != NULL)
+      curr2 = curr2->getNextCreate(0., 0., 0.);
   }
-
-  /* Prune any remainder from the old coords linked list */
-  if (curr2 != NULL)
-    curr2->prune();
 }
 
 
@@ -79,8 +79,21 @@ private:
   /** A pointer to the LocalCoords at the next higher nested Universe level */
   LocalCoords* _prev;
 
+  /** The LocalCoords reserved for the lower nested Universe levels, which
+   *  are allocated once by and owned by the highest level LocalCoords */
+  LocalCoords* _levels;
+
+  /** The nested Universe level of this LocalCoords, zero at the highest
+   *  level */
+  int _level;
+
+  /* The lower levels are owned by the highest level LocalCoords, so a
+   * LocalCoords may not be copied by value */
+  LocalCoords(const LocalCoords& coords);
+  LocalCoords& operator=(const LocalCoords& coords);
+
 public:
-  LocalCoords(double x, double y, double z);
+  LocalCoords(double x=0., double y=0., double z=0.);
   virtual ~LocalCoords();
   coordType getType();
   Universe* getUniverse() const;
@@ -96,6 +109,7 @@ public:
   Point* getPoint();
   LocalCoords* getNext() const;
   LocalCoords* getPrev() const;
+  LocalCoords* getNextCreate(double x, double y, double z);
 
   void setType(coordType type);
   void setUniverse(Universe* universe);
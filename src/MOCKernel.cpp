@@ -17,22 +17,40 @@ MOCKernel::MOCKernel(TrackGenerator* track_generator) {
 
 /**
  * @brief Constructor for the VolumeKernel assigns default values, calls
- *        the MOCKernel constructor, and pulls references to FSR locks and FSR
- *        volumes from the provided TrackGenerator.
+ *        the MOCKernel constructor, and pulls references to FSR volumes
+ *        from the provided TrackGenerator.
  * @param track_generator the TrackGenerator used to pull relevant tracking
  *        data
  */
 VolumeKernel::VolumeKernel(TrackGenerator* track_generator) :
                            MOCKernel(track_generator) {
-  _FSR_locks = track_generator->getFSRLocks();
+  _FSR_volumes = track_generator->getFSRVolumes();
+  _quadrature = track_generator->getQuadrature();
+  _weight = 0;
+}
 
-  if (_FSR_locks == NULL)
-    log_printf(ERROR, "Unable to create a VolumeKernel without first creating "
-               "FSR locks which are normally created during Track generation");
 
+/**
+ * @brief Constructor for the CentroidKernel assigns default values, calls
+ *        the MOCKernel constructor, and pulls references to FSR volumes
+ *        from the provided TrackGenerator.
+ * @param track_generator the TrackGenerator used to pull relevant tracking
+ *        data
+ * @param centroids_x the array of FSR centroid x-coordinates to add to
+ * @param centroids_y the array of FSR centroid y-coordinates to add to
+ */
+CentroidKernel::CentroidKernel(TrackGenerator* track_generator,
+                               double* centroids_x, double* centroids_y) :
+                               MOCKernel(track_generator) {
   _FSR_volumes = track_generator->getFSRVolumes();
   _quadrature = track_generator->getQuadrature();
+  _centroids_x = centroids_x;
+  _centroids_y = centroids_y;
   _weight = 0;
+  _x = 0.;
+  _y = 0.;
+  _cos_phi = 0.;
+  _sin_phi = 0.;
 }
 
 
@@ -43,7 +61,24 @@ VolumeKernel::VolumeKernel(TrackGenerator* track_generator) :
  *        data
  */
 CounterKernel::CounterKernel(TrackGenerator* track_generator) :
-                             MOCKernel(track_generator) {}
+                             MOCKernel(track_generator) {
+  _max_optical_length = 0.;
+}
+
+
+/**
+ * @brief Constructor for the SegmentationKernel assigns default values and
+ *        calls the MOCKernel constructor
+ * @param track_generator the TrackGenerator used to pull relevant tracking
+ *        data
+ * @param segment_store the allocated SegmentStore to fill with segments
+ */
+SegmentationKernel::SegmentationKernel(TrackGenerator* track_generator,
+                                       SegmentStore* segment_store) :
+                                       MOCKernel(track_generator) {
+  _segment_store = segment_store;
+  _index = 0;
+}
 
 
 /**
@@ -73,12 +108,63 @@ void VolumeKernel::newTrack(Track* track) {
 }
 
 
+/**
+ * @brief Prepares a CentroidKernel for a new Track
+ * @details Resets the segment count, updates the weight for the new Track
+ *          and moves the position to the start of the Track
+ * @param track The new Track the MOCKernel prepares to handle
+ */
+void CentroidKernel::newTrack(Track* track) {
+
+  /* Compute the Track cross-sectional area */
+  int azim_index = track->getAzimAngleIndex();
+  _weight = _quadrature->getAzimSpacing(azim_index)
+      * _quadrature->getAzimWeight(azim_index);
+
+  /* Start at the beginning of the Track */
+  _x = track->getStart()->getX();
+  _y = track->getStart()->getY();
+  _cos_phi = cos(track->getPhi());
+  _sin_phi = sin(track->getPhi());
+
+  /* Reset the count */
+  _count = 0;
+}
+
+
+/**
+ * @brief Prepares a SegmentationKernel for a new Track
+ * @details Resets the segment count and moves the insertion point to the
+ *          new Track's offset in the SegmentStore, or to the beginning of a
+ *          SegmentStore used as a single Track buffer
+ * @param track The new Track the MOCKernel prepares to handle
+ */
+void SegmentationKernel::newTrack(Track* track) {
+  if (_segment_store->getNumTracks() == 1)
+    _index = 0;
+  else
+    _index = _segment_store->getTrackOffset(track->getUid());
+  _count = 0;
+}
+
+
 /**
  * @brief Destructor for MOCKernel
  */
 MOCKernel::~MOCKernel() {};
 
 
+/**
+ * @brief Returns the maximum optical path length of the segments counted
+ * @details The optical path length of each segment is computed before it is
+ *          split by the maximum optical path length.
+ * @return the maximum optical path length of any segment counted
+ */
+FP_PRECISION CounterKernel::getMaxOpticalLength() {
+  return _max_optical_length;
+}
+
+
 /*
  * @brief Reads and returns the current count
  * @details MOC kernels count how many times they are accessed. This value
@@ -91,6 +177,46 @@ int MOCKernel::getCount() {
 }
 
 
+/**
+ * @brief Computes the maximum optical path length of a segment across all
+ *        energy groups.
+ * @details The optical path length is computed in the same precision as in
+ *          TrackGenerator::getMaxOpticalLength() so that segments with the
+ *          maximum optical path length are not cut due to round-off.
+ * @param length segment length
+ * @param mat Material associated with the segment
+ * @return the maximum optical path length of the segment
+ */
+FP_PRECISION MOCKernel::computeOpticalLength(FP_PRECISION length,
+                                             Material* mat) {
+
+  FP_PRECISION* sigma_t = mat->getSigmaT();
+  FP_PRECISION max_tau = 0.;
+  for (int e=0; e < mat->getNumEnergyGroups(); e++)
+    max_tau = std::max(max_tau, length * sigma_t[e]);
+
+  return max_tau;
+}
+
+
+/**
+ * @brief Computes the number of segments a segment is cut into so that none
+ *        has an optical path length greater than the maximum.
+ * @param length segment length
+ * @param mat Material associated with the segment
+ * @return the number of cuts on the segment
+ */
+int MOCKernel::computeNumCuts(FP_PRECISION length, Material* mat) {
+
+  FP_PRECISION max_tau = computeOpticalLength(length, mat);
+
+  if (max_tau <= _max_tau)
+    return 1;
+
+  return (int) std::ceil(max_tau / _max_tau);
+}
+
+
 /* @brief Resets the maximum optcal path length for a segment
  * @details MOC kernels ensure that there are no segments with an optical path
  *          length greater than the maximum optical path length by splitting
@@ -114,14 +240,39 @@ void MOCKernel::setMaxOpticalLength(FP_PRECISION max_tau) {
 void VolumeKernel::execute(FP_PRECISION length, Material* mat, int id,
                            int cmfd_surface_fwd, int cmfd_surface_bwd) {
 
-  /* Set omp lock for FSRs */
-  omp_set_lock(&_FSR_locks[id]);
-
-  /* Add value to buffer */
+  /* Atomically add value to buffer */
+#pragma omp atomic update
   _FSR_volumes[id] += _weight * length;
 
-  /* Unset lock */
-  omp_unset_lock(&_FSR_locks[id]);
+  /* Increment count */
+  _count++;
+}
+
+
+/*
+ * @brief Adds segment contribution to the FSR centroid
+ * @details The CentroidKernel execute function adds the segment midpoint,
+ *          weighted by the product of the segment length and the track
+ *          weight divided by the FSR volume, to the centroid coordinates at
+ *          index id, and then advances the position to the segment end.
+ * @param length segment length
+ * @param mat Material associated with the segment
+ * @param id the FSR ID of the FSR associated with the segment
+ */
+void CentroidKernel::execute(FP_PRECISION length, Material* mat, int id,
+                             int cmfd_surface_fwd, int cmfd_surface_bwd) {
+
+  double weight = _weight * length / _FSR_volumes[id];
+
+  /* Atomically increment the FSR centroid coordinates */
+#pragma omp atomic update
+  _centroids_x[id] += weight * (_x + _cos_phi * length / 2.0);
+#pragma omp atomic update
+  _centroids_y[id] += weight * (_y + _sin_phi * length / 2.0);
+
+  /* Move to the end of the segment */
+  _x += _cos_phi * length;
+  _y += _sin_phi * length;
 
   /* Increment count */
   _count++;
@@ -142,14 +293,52 @@ void VolumeKernel::execute(FP_PRECISION length, Material* mat, int id,
 void CounterKernel::execute(FP_PRECISION length, Material* mat, int id,
                             int cmfd_surface_fwd, int cmfd_surface_bwd) {
 
+  /* Update the maximum optical path length of the unsplit segments */
+  _max_optical_length = std::max(_max_optical_length,
+                                 computeOpticalLength(length, mat));
+
   /* Determine the number of cuts on the segment */
-  FP_PRECISION* sigma_t = mat->getSigmaT();
-  double max_sigma_t = 0;
-  for (int e=0; e < mat->getNumEnergyGroups(); e++)
-    if (sigma_t[e] > max_sigma_t)
-      max_sigma_t = sigma_t[e];
+  int num_cuts = computeNumCuts(length, mat);
+
+  /* Increment count */
+  _count += num_cuts;
+}
+
+
+/*
+ * @brief Writes a segment into the SegmentStore
+ * @details The SegmentationKernel execute function writes the segment into
+ *          the SegmentStore at the current insertion point. Segments with
+ *          an optical path length greater than the maximum are split into
+ *          equal sub-segments, with the CMFD surfaces assigned to the first
+ *          and last sub-segments.
+ * @param length segment length
+ * @param mat Material associated with the segment
+ * @param id the FSR ID of the FSR associated with the segment
+ * @param cmfd_surface_fwd the CMFD surface crossed by the segment end point
+ * @param cmfd_surface_bwd the CMFD surface crossed by the segment start point
+ */
+void SegmentationKernel::execute(FP_PRECISION length, Material* mat, int id,
+                                 int cmfd_surface_fwd, int cmfd_surface_bwd) {
+
+  /* Determine the number of cuts on the segment */
+  int num_cuts = computeNumCuts(length, mat);
+  int material_index = _segment_store->getMaterialIndex(mat);
+  FP_PRECISION cut_length = length / FP_PRECISION(num_cuts);
+
+  if (_index + num_cuts > _segment_store->getNumSegments())
+    log_printf(ERROR, "Unable to write %d segments at index %ld in a "
+               "SegmentStore with %ld segments", num_cuts, _index,
+               _segment_store->getNumSegments());
 
-  int num_cuts = std::max((int) std::ceil(length * max_sigma_t / _max_tau), 1);
+  /* Write each sub-segment into the SegmentStore */
+  for (int k=0; k < num_cuts; k++) {
+    int surface_fwd = (k == num_cuts-1) ? cmfd_surface_fwd : -1;
+    int surface_bwd = (k == 0) ? cmfd_surface_bwd : -1;
+    _segment_store->setSegment(_index, cut_length, material_index, id,
+                               surface_fwd, surface_bwd);
+    _index++;
+  }
 
   /* Increment count */
   _count += num_cuts;
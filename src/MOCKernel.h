@@ -11,6 +11,7 @@
 #include "Track.h"
 #include "Geometry.h"
 #include "Quadrature.h"
+#include "SegmentStore.h"
 #ifdef SWIG
 #include "Python.h"
 #endif
@@ -46,6 +47,9 @@ protected:
   /** Maximum optical path length when forming segments */
   FP_PRECISION _max_tau;
 
+  FP_PRECISION computeOpticalLength(FP_PRECISION length, Material* mat);
+  int computeNumCuts(FP_PRECISION length, Material* mat);
+
 public:
 
   MOCKernel(TrackGenerator* track_generator);
@@ -77,9 +81,16 @@ public:
  */
 class CounterKernel: public MOCKernel {
 
+private:
+
+  /** The maximum optical path length of any segment counted, before
+   *  splitting */
+  FP_PRECISION _max_optical_length;
+
 public:
 
   CounterKernel(TrackGenerator* track_generator);
+  FP_PRECISION getMaxOpticalLength();
   void execute(FP_PRECISION length, Material* mat, int id,
                int cmfd_surface_fwd, int cmfd_surface_bwd);
 };
@@ -98,9 +109,6 @@ class VolumeKernel: public MOCKernel {
 
 private:
 
-  /** Array of FSR locks */
-  omp_lock_t* _FSR_locks;
-
   /** Pointer to array of FSR volumes */
   FP_PRECISION* _FSR_volumes;
 
@@ -120,4 +128,82 @@ public:
 };
 
 
+/**
+ * @class CentroidKernel MOCKernel.h "src/MOCKernel.h"
+ * @brief Calculates the centroids of FSRs by adding the weighted midpoints
+ *        of segments
+ * @details A CentroidKernel inherets from MOCKernel and is a kernel which
+ *          follows the position along the current Track. It adds the
+ *          midpoint of each segment, weighted by the product of the segment
+ *          length and the Track weight divided by the FSR volume, to the
+ *          centroid coordinate arrays at an input index.
+ */
+class CentroidKernel: public MOCKernel {
+
+private:
+
+  /** Pointer to array of FSR volumes */
+  FP_PRECISION* _FSR_volumes;
+
+  /** Pointers to the arrays of FSR centroid x and y coordinates */
+  double* _centroids_x;
+  double* _centroids_y;
+
+  /** The cross-sectional area of the Track used to weight segment midpoint
+   *  contributions to the centroids */
+  FP_PRECISION _weight;
+
+  /** The associated quadrature from which weights are derived */
+  Quadrature* _quadrature;
+
+  /** The position at the start of the next segment on the Track */
+  double _x;
+  double _y;
+
+  /** The direction cosines of the Track in the x-y plane */
+  double _cos_phi;
+  double _sin_phi;
+
+public:
+
+  CentroidKernel(TrackGenerator* track_generator, double* centroids_x,
+                 double* centroids_y);
+  void newTrack(Track* track);
+  void execute(FP_PRECISION length, Material* mat, int id,
+               int cmfd_surface_fwd, int cmfd_surface_bwd);
+};
+
+
+/**
+ * @class SegmentationKernel MOCKernel.h "src/MOCKernel.h"
+ * @brief Writes segments into a SegmentStore
+ * @details A SegmentationKernel inherets from MOCKernel and is a kernel which
+ *          writes each segment it handles into the arrays of a SegmentStore,
+ *          beginning at the offset of the current Track. Segments longer than
+ *          the maximum optical path length are split exactly as they are
+ *          counted by the CounterKernel, so that a SegmentStore sized by a
+ *          CounterKernel pass is filled exactly by a SegmentationKernel pass.
+ *          A SegmentStore holding a single Track is used as a buffer, with
+ *          the segments of each new Track written from its beginning.
+ */
+class SegmentationKernel: public MOCKernel {
+
+private:
+
+  /** The SegmentStore filled by the kernel */
+  SegmentStore* _segment_store;
+
+  /** The index in the SegmentStore arrays of the next segment */
+  long _index;
+
+public:
+
+  SegmentationKernel(TrackGenerator* track_generator,
+                     SegmentStore* segment_store);
+  void newTrack(Track* track);
+  void execute(FP_PRECISION length, Material* mat, int id,
+               int cmfd_surface_fwd, int cmfd_surface_bwd);
+};
+
+
 #endif /* MOCKERNEL_H_ */
@@ -20,20 +20,23 @@
 #include <math.h>
 #endif
 
-#ifdef ICPC
-/** Word-aligned memory allocation for Intel's compiler */
-#define MM_FREE(array) _mm_free(array)
+#ifdef BGXLC
+/** Word-aligned memory deallocation for IBM's compiler */
+#define MM_FREE(array) free(array)
 
-/** Word-aligned memory allocation for Intel's compiler */
-#define MM_MALLOC(size,alignment) _mm_malloc(size, alignment)
+/** Word-aligned memory allocation for IBM's compiler */
+#define MM_MALLOC(size,alignment) malloc(size)
 
 #else
+#ifdef __cplusplus
+#include <mm_malloc.h>
+#endif
 
-/** Word-aligned memory deallocation for GNU's compiler */
-#define MM_FREE(array) free(array)
+/** Aligned memory deallocation for the Intel, GNU and Clang compilers */
+#define MM_FREE(array) _mm_free(array)
 
-/** Word-aligned memory allocation for GNU's compiler */
-#define MM_MALLOC(size,alignment) malloc(size)
+/** Aligned memory allocation for the Intel, GNU and Clang compilers */
+#define MM_MALLOC(size,alignment) _mm_malloc(size, alignment)
 
 #endif
 
@@ -1,9 +1,9 @@
 /**
  * @file ParallelHashMap.h
  * @brief A thread-safe hash map supporting insertion and lookup operations
- * @details The parallel hash map is built on top of a fixed-sized hash map
- *    object and features OpenMP concurrency structures. The underlying
- *    fixed-sized hash map handles collisions with chaining.
+ * @details The parallel hash map is a lock-free open-addressing hash table
+ *    with linear probing. Entries are inserted with atomic compare-and-swap
+ *    operations and the table is resized while lookups proceed concurrently.
  * @date June 6, 2015
  * @author Geoffrey Gunow, MIT, Course 22 (geogunow@mit.edu)
  */
@@ -19,102 +19,74 @@
 
 
 /**
- * @class FixedHashMap ParallelHashMap.h "src/ParallelHashMap.h"
- * @brief A fixed-size hash map supporting insertion and lookup operations
- * @details The FixedHashMap class supports insertion and lookup operations
+ * @class ParallelHashMap ParallelHashMap.h "src/ParallelHashMap.h"
+ * @brief A thread-safe hash map supporting insertion and lookup operations
+ * @details The ParallelHashMap class supports insertion and lookup operations
  *    but not deletion as deletion is not needed in the OpenMOC application.
- *    This hash table uses chaining for collisions and does not incorporate
- *    concurrency objects except for tracking the number of entries in the
- *    table for which an atomic increment is used. This hash table is not
- *    thread safe but is used as a building block for the ParallelHashMap
- *    class. This table guarantees O(1) insertions and lookups on average.
+ *    Each key/value pair is stored in a node which is never moved or freed
+ *    until the map is cleared. The table is an array of pointers to nodes
+ *    probed linearly, such that lookups never take a lock and insertions
+ *    claim an empty slot with a single compare-and-swap. The insertion order
+ *    numbers are drawn from a monotonic counter.
+ *
+ *    When the table is half full it is replaced by a table of twice the size.
+ *    The nodes of the old table are copied into the new table by the
+ *    resizing thread while other threads insert into the new table. Each
+ *    empty slot of the old table is sealed while it is copied, such that a
+ *    key cannot be inserted into the old table once a thread has found it
+ *    absent there. Lookups search the new table and then the old table until
+ *    the copy is complete. Old tables are only freed when the map is cleared,
+ *    such that no thread ever reads freed memory.
  */
 template <class K, class V>
-class FixedHashMap {
+class ParallelHashMap {
+
+  /* a key/value pair along with the hash of the key */
   struct node {
-    node(K k_in, V v_in) : next(NULL), key(k_in), value(v_in) {}
+    node(const K& k_in, V v_in, size_t h_in)
+      : key(k_in), value(v_in), hash(h_in) {}
     K key;
-    V value;
-    node *next;
+    V volatile value;
+    size_t hash;
   };
 
-  private:
-    size_t _M;      /* table size */
-    size_t _N;      /* number of elements present in table */
-    node ** _buckets;   /* buckets of values stored in nodes */
-
-  public:
-
-    FixedHashMap(size_t M = 64);
-    virtual ~FixedHashMap();
-    bool contains(K key);
-    V& at(K key);
-    void insert(K key, V value);
-    int insert_and_get_count(K key, V value);
-    size_t size();
-    size_t bucket_count();
-    K* keys();
-    V* values();
-    void clear();
-    void print_buckets();
-};
-
-
-/**
- * @class ParallelHashMap ParallelHashMap.h "src/ParallelHashMap.h"
- * @brief A thread-safe hash map supporting insertion and lookup operations
- * @details The ParallelHashMap class is built on top of the FixedHashMap
- *    class, supporting insertion and lookup operations but not deletion as
- *    deletion is not needed in the OpenMOC application. This hash table uses
- *    chaining for collisions, as defined in FixedHashMap. It offers lock
- *    free lookups in O(1) time on average and fine-grained locking for
- *    insertions in O(1) time on average as well. Resizing is conducted
- *    periodically during inserts, although the starting table size can be
- *    chosen to limit the number of resizing operations.
- */
-template <class K, class V>
-class ParallelHashMap {
-
-  /* padded pointer to hash table to avoid false sharing */
-  struct paddedPointer {
-    volatile long pad_L1;
-    volatile long pad_L2;
-    volatile long pad_L3;
-    volatile long pad_L4;
-    volatile long pad_L5;
-    volatile long pad_L7;
-    volatile long pad_L8;
-    FixedHashMap<K,V> volatile* value;
-    volatile long pad_R1;
-    volatile long pad_R2;
-    volatile long pad_R3;
-    volatile long pad_R4;
-    volatile long pad_R5;
-    volatile long pad_R6;
-    volatile long pad_R7;
-    volatile long pad_R8;
+  /* a table of pointers to nodes and the table whose nodes it receives */
+  struct table {
+    table(size_t M_in, table* prev_in)
+      : M(M_in), prev(prev_in), next(NULL), copied(prev_in == NULL) {
+      slots = new node* volatile[M]();
+    }
+    ~table() { delete [] slots; }
+    size_t M;
+    node* volatile* slots;
+    table* prev;
+    table* volatile next;
+    volatile bool copied;
   };
 
   private:
-    FixedHashMap<K,V> *_table;
-    paddedPointer *_announce;
-    size_t _num_threads;
-    size_t _N;
-    omp_lock_t * _locks;
-    size_t _num_locks;
+    size_t _M;
+    table* volatile _table;
+    volatile size_t _N;
+    volatile int _resizing;
+    node* sealed();
+    node* find_node(const K& key, size_t key_hash);
+    node* seal(table* t, const K& key, size_t key_hash);
+    node* insert_node(const K& key, V value, bool& inserted);
     void resize();
+    void free_tables();
 
   public:
-    ParallelHashMap(size_t M = 64, size_t L = 64);
+    ParallelHashMap(size_t M = 64);
     virtual ~ParallelHashMap();
-    bool contains(K key);
-    V at(K key);
-    void update(K key, V value);
-    void insert(K key, V value);
-    int insert_and_get_count(K key, V value);
+    bool contains(const K& key);
+    bool find(const K& key, V& value);
+    V at(const K& key);
+    void update(const K& key, V value);
+    void insert(const K& key, V value);
+    int insert_and_get_count(const K& key, V value);
     size_t size();
     size_t bucket_count();
-    size_t num_locks();
     K* keys();
     V* values();
     void clear();
@@ -123,16 +95,13 @@ class ParallelHashMap {
 
 
 /**
- * @brief Constructor initializes fixed-size table of buckets filled with empty
- *      linked lists.
- * @details The constructor initializes a fixed-size hash map with the size
- *      as an input parameter. If no size is given the default size (64)
- *      is used. Buckets are filled with empty linked lists presented as
- *      NULL pointers.
- * @param M size of fixed hash map
+ * @brief Constructor initializes a table of empty slots.
+ * @details If no size is given the default size (64) is used. The size is
+ *      rounded up to the nearest power of 2.
+ * @param M initial size of the table
  */
 template <class K, class V>
-FixedHashMap<K,V>::FixedHashMap(size_t M) {
+ParallelHashMap<K,V>::ParallelHashMap(size_t M) {
 
   /* ensure M is a power of 2 */
   if ((M & (M-1)) != 0) {
@@ -143,710 +112,481 @@ FixedHashMap<K,V>::FixedHashMap(size_t M) {
     M++;
   }
 
-  /* allocate table */
   _M = M;
   _N = 0;
-  _buckets = new node*[_M]();
+  _resizing = 0;
+  _table = new table(_M, NULL);
 }
 
 
 /**
- * @brief Destructor deletes all nodes in the linked lists associated with each
- *      bucket in the fixed-size table and their pointers.
+ * @brief Destructor frees all nodes and tables.
  */
 template <class K, class V>
-FixedHashMap<K,V>::~FixedHashMap() {
-  /* for each bucket, scan through linked list and delete all nodes */
-  for (size_t i=0; i<_M; i++) {
-    node *iter_node = _buckets[i];
-    while (iter_node != NULL) {
-      node *next_node = iter_node->next;
-      delete iter_node;
-      iter_node = next_node;
-    }
-  }
-
-  /* delete all buckets (now pointers to empty linked lists) */
-  delete [] _buckets;
+ParallelHashMap<K,V>::~ParallelHashMap() {
+  free_tables();
 }
 
 
 /**
- * @brief Determine whether the fixed-size table contains a given key
- * @details The linked list in the bucket associated with the key is searched
- *       to determine whether the key is present.
- * @param key key to be searched
- * @return boolean value referring to whether the key is contained in the map
+ * @brief Returns the marker of an empty slot which has been sealed while its
+ *      table is copied into a larger table.
+ * @return the marker of a sealed slot, which is never a valid node address
  */
 template <class K, class V>
-bool FixedHashMap<K,V>::contains(K key) {
-
-  /* get hash into table assuming M is a power of 2, using fast modulus */
-  size_t key_hash = std::hash<K>()(key) & (_M-1);
-
-  /* search corresponding bucket for key */
-  node *iter_node = _buckets[key_hash];
-  while (iter_node != NULL) {
-    if (iter_node->key == key)
-      return true;
-    else
-      iter_node = iter_node->next;
-  }
-  return false;
+typename ParallelHashMap<K,V>::node* ParallelHashMap<K,V>::sealed() {
+  return reinterpret_cast<node*>(1);
 }
 
 
 /**
- * @brief Determine the value associated with a given key in the fixed-size
- *      table.
- * @details The linked list in the bucket associated with the key is searched
- *      and once the key is found, the corresponding value is returned.
- *      An exception is thrown if the key is not present in the map.
- * @param key key whose corresponding value is desired
- * @return value associated with the given key
+ * @brief Finds the node of a given key without setting any locks.
+ * @details The newest table is searched first. If its nodes are still being
+ *      copied from the previous table, the previous table is searched too.
+ *      Whether the copy is complete is read before searching the newest table
+ *      such that a node copied during the search is not missed.
+ * @param key key to be searched
+ * @param key_hash the hash of the key
+ * @return the node of the key or NULL if the key is not present
  */
 template <class K, class V>
-V& FixedHashMap<K,V>::at(K key) {
-
-  /* get hash into table assuming M is a power of 2, using fast modulus */
-  size_t key_hash = std::hash<K>()(key) & (_M-1);
+typename ParallelHashMap<K,V>::node*
+ParallelHashMap<K,V>::find_node(const K& key, size_t key_hash) {
+
+  table* t = _table;
+  while (t != NULL) {
+
+    bool copied = t->copied;
+    __sync_synchronize();
+
+    /* probe the slots from the hash until an empty slot is found */
+    size_t i = key_hash & (t->M-1);
+    while (true) {
+      node* n = t->slots[i];
+      if (n == NULL || n == sealed())
+        break;
+      if (n->hash == key_hash && n->key == key)
+        return n;
+      i = (i+1) & (t->M-1);
+    }
 
-  /* search bucket for key and return the corresponding value if found */
-  node *iter_node = _buckets[key_hash];
-  while (iter_node != NULL) {
-    if (iter_node->key == key)
-      return iter_node->value;
-    else
-      iter_node = iter_node->next;
+    if (copied)
+      break;
+    t = t->prev;
   }
 
-  /* after the bucket has been completely searched without finding the key,
-     throw an exception */
-  throw std::out_of_range("Key not present in map");
+  return NULL;
 }
 
 
 /**
- * @brief Inserts a key/value pair into the fixed-size table.
- * @details The specified key value pair is inserted into the fixed-size table.
- *      If the key already exists in the table, the pair is not inserted
- *      and the function returns.
- * @param key key of the key/value pair to be inserted
- * @param value value of the key/value pair to be inserted
+ * @brief Searches a table whose nodes are being copied into a larger table
+ *      for a key, sealing the first empty slot along the key's probe sequence.
+ * @details A key is always inserted into the first empty slot along its
+ *      probe sequence. Once that slot is sealed the key can no longer be
+ *      inserted into the old table, such that it is safe to insert it into
+ *      the new table if it was not found.
+ * @param t the table being copied
+ * @param key key to be searched
+ * @param key_hash the hash of the key
+ * @return the node of the key or NULL if the key is not present
  */
 template <class K, class V>
-void FixedHashMap<K,V>::insert(K key, V value) {
-
-  /* get hash into table using fast modulus */
-  size_t key_hash = std::hash<K>()(key) & (_M-1);
-
-  /* check to see if key already exists in map */
-  if (contains(key))
-    return;
-
-  /* create new node */
-  node *new_node = new node(key, value);
-
-  /* find where to place element in linked list */
-  node **iter_node = &_buckets[key_hash];
-  while (*iter_node != NULL)
-    iter_node = &(*iter_node)->next;
-
-  /* place element in linked list */
-  *iter_node = new_node;
-
-  /* increment counter */
-#pragma omp atomic
-  _N++;
+typename ParallelHashMap<K,V>::node*
+ParallelHashMap<K,V>::seal(table* t, const K& key, size_t key_hash) {
+
+  size_t i = key_hash & (t->M-1);
+  while (true) {
+    node* n = t->slots[i];
+    if (n == sealed())
+      return NULL;
+    if (n == NULL) {
+      if (__sync_bool_compare_and_swap(&t->slots[i], (node*) NULL, sealed()))
+        return NULL;
+      continue;
+    }
+    if (n->hash == key_hash && n->key == key)
+      return n;
+    i = (i+1) & (t->M-1);
+  }
 }
 
 
 /**
- * @brief Inserts a key/value pair into the fixed-size table and returns the
- *      order number with which it was inserted.
- * @details The specified key value pair is inserted into the fixed-size table.
- *      If the key already exists in the table, the pair is not inserted
- *      and the function returns -1.
+ * @brief Inserts a key/value pair unless the key is already present.
+ * @details The key is first searched in the table being copied, if any. The
+ *      first empty slot along the key's probe sequence in the newest table
+ *      is then claimed with a compare-and-swap. If the claim fails the slot
+ *      is reread, as another thread may have inserted the same key. If a
+ *      sealed slot is found the table is being copied and the insertion
+ *      moves on to the larger table.
  * @param key key of the key/value pair to be inserted
  * @param value value of the key/value pair to be inserted
- * @return order number in which key/value pair was inserted, -1 is returned if
- *      key was already present in map.
+ * @param inserted set to whether the key/value pair was inserted
+ * @return the node of the key
  */
 template <class K, class V>
-int FixedHashMap<K,V>::insert_and_get_count(K key, V value) {
-
-  /* get hash into table using fast modulus */
-  size_t key_hash = std::hash<K>()(key) & (_M-1);
-
-  /* check to see if key already exists in map */
-  if (contains(key))
-    return -1;
-
-  /* create new node */
-  node *new_node = new node(key, value);
-
-  /* find where to place element in linked list */
-  node **iter_node = &_buckets[key_hash];
-  while (*iter_node != NULL)
-    iter_node = &(*iter_node)->next;
-
-  /* place element in linked list */
-  *iter_node = new_node;
-
-  /* increment counter and return number */
-  size_t N;
-#pragma omp critical (node_incr)
-    N = _N++;
-
-  return (int) N;
-}
-
-
-/**
- * @brief Returns the number of key/value pairs in the fixed-size table
- * @return number of key/value pairs in the map
- */
-template <class K, class V>
-size_t FixedHashMap<K,V>::size() {
-  return _N;
-}
-
-
-/**
- * @brief Returns the number of buckets in the fixed-size table
- * @return number of buckets in the map
- */
-template <class K, class V>
-size_t FixedHashMap<K,V>::bucket_count() {
-  return _M;
-}
-
-
-/**
- * @brief Returns an array of the keys in the fixed-size table
- * @details All buckets are scanned in order to form a list of all keys
- *      present in the table and then the list is returned. WARNING: The user
- *      is responsible for freeing the allocated memory once the array is no
- *      longer needed.
- * @return an array of keys in the map whose length is the number of key/value
- *      pairs in the table.
-*/
-template <class K, class V>
-K* FixedHashMap<K,V>::keys() {
-
-  /* allocate array of keys */
-  K *key_list = new K[_N];
-
-  /* fill array with keys */
-  size_t ind = 0;
-  for (size_t i=0; i<_M; i++) {
-    node *iter_node = _buckets[i];
-    while (iter_node != NULL) {
-      key_list[ind] = iter_node->key;
-      iter_node = iter_node->next;
-      ind++;
-    }
+typename ParallelHashMap<K,V>::node*
+ParallelHashMap<K,V>::insert_node(const K& key, V value, bool& inserted) {
+
+  size_t key_hash = std::hash<K>()(key);
+  node* new_node = NULL;
+  inserted = false;
+
+  /* search the table being copied into the newest table, if any */
+  table* t = _table;
+  if (!t->copied) {
+    node* n = seal(t->prev, key, key_hash);
+    if (n != NULL)
+      return n;
   }
-  return key_list;
-}
 
-
-/**
- * @brief Returns an array of the values in the fixed-size table
- * @details All buckets are scanned in order to form a list of all values
- *      present in the table and then the list is returned. WARNING: The user
- *      is responsible for freeing the allocated memory once the array is no
- *      longer needed.
- * @return an array of values in the map whose length is the number of
- *      key/value pairs in the table.
-*/
-template <class K, class V>
-V* FixedHashMap<K,V>::values() {
-
-  /* allocate array of values */
-  V *values = new V[_N];
-
-  /* fill array with values */
-  size_t ind = 0;
-  for (size_t i=0; i<_M; i++) {
-    node *iter_node = _buckets[i];
-    while (iter_node != NULL) {
-      values[ind] = iter_node->value;
-      iter_node = iter_node->next;
-      ind++;
+  size_t i = key_hash & (t->M-1);
+  while (true) {
+    node* n = t->slots[i];
+
+    /* claim an empty slot for a new node */
+    if (n == NULL) {
+      if (new_node == NULL)
+        new_node = new node(key, value, key_hash);
+      if (__sync_bool_compare_and_swap(&t->slots[i], (node*) NULL,
+                                       new_node)) {
+        inserted = true;
+        return new_node;
+      }
+      continue;
     }
-  }
-  return values;
-}
-
 
-/**
- * @brief Clears all key/value pairs form the hash table.
- */
-template <class K, class V>
-void FixedHashMap<K,V>::clear() {
-
-  /* for each bucket, scan through linked list and delete all nodes */
-  for (size_t i=0; i<_M; i++) {
-    node *iter_node = _buckets[i];
-    while (iter_node != NULL) {
-      node *next_node = iter_node->next;
-      delete iter_node;
-      iter_node = next_node;
+    /* the key is not in this table, which is being copied */
+    if (n == sealed()) {
+      t = t->next;
+      i = key_hash & (t->M-1);
+      continue;
     }
-  }
-
-  /* reset each bucket to null */
-  for (size_t i=0; i<_M; i++)
-    _buckets[i] = NULL;
-
-  /* reset the number of entries to zero */
-  _N = 0;
-}
 
+    /* the key is already present */
+    if (n->hash == key_hash && n->key == key) {
+      delete new_node;
+      return n;
+    }
 
-/**
- * @brief Prints the contents of each bucket to the screen
- * @details All buckets are scanned and the contents of the buckets are
- *      printed, which are pointers to linked lists. If the pointer is NULL
- *      suggesting that the linked list is empty, NULL is printed to the
- *      screen.
- */
-template <class K, class V>
-void FixedHashMap<K,V>::print_buckets() {
-  log_printf(NORMAL, "Printing all buckets in the hash map...");
-  for (size_t i=0; i<_M; i++) {
-    if (_buckets[i] == NULL)
-      log_printf(NORMAL, "Bucket %d -> NULL", i);
-    else
-      log_printf(NORMAL, "Bucket %d -> %p", i, _buckets[i]);
+    i = (i+1) & (t->M-1);
   }
 }
 
 
 /**
- * @brief Constructor generates initial underlying table as a fixed-sized
- *      hash map and intializes concurrency structures.
- */
-template <class K, class V>
-ParallelHashMap<K,V>::ParallelHashMap(size_t M, size_t L) {
-
-  /* allocate table */
-  _table = new FixedHashMap<K,V>(M);
-
-  /* get number of threads and create concurrency structures */
-  _num_threads = 1;
-  _num_threads = omp_get_max_threads();
-  _num_locks = L;
-  _locks = new omp_lock_t[_num_locks];
-  for (size_t i=0; i<_num_locks; i++)
-    omp_init_lock(&_locks[i]);
-
-  _announce = new paddedPointer[_num_threads];
-}
-
-
-/**
- * @brief Destructor frees memory associated with fixed-sized hash map and
- *      concurrency structures.
+ * @brief Determine whether the parallel hash map contains a given key
+ * @param key key to be searched
+ * @return boolean value referring to whether the key is contained in the map
  */
 template <class K, class V>
-ParallelHashMap<K,V>::~ParallelHashMap() {
-  delete _table;
-  delete [] _locks;
-  delete [] _announce;
+bool ParallelHashMap<K,V>::contains(const K& key) {
+  return find_node(key, std::hash<K>()(key)) != NULL;
 }
 
 
 /**
- * @brief Determine whether the parallel hash map contains a given key
- * @details First the thread accessing the table announces its presence and
- *      which table it is reading. Then the linked list in the bucket
- *      associated with the key is searched without setting any locks
- *      to determine whether the key is present. When the thread has
- *      finished accessing the table, the announcement is reset to NULL.
- *      The announcement ensures that the data in the map is not freed
- *      during a resize until all threads have finished accessing the map.
+ * @brief Determine the value associated with a given key if it is present.
+ * @details This combines ParallelHashMap::contains() and
+ *      ParallelHashMap::at() in a single search of the table.
  * @param key key to be searched
+ * @param value set to the value associated with the key if it is present
  * @return boolean value referring to whether the key is contained in the map
  */
 template <class K, class V>
-bool ParallelHashMap<K,V>::contains(K key) {
-
-  /* get thread ID */
-  size_t tid = 0;
-  tid = omp_get_thread_num();
-
-  /* get pointer to table, announce it will be searched,
-     and ensure consistency */
-  FixedHashMap<K,V> *table_ptr;
-  do {
-    table_ptr = _table;
-    _announce[tid].value = table_ptr;
-#pragma omp flush(_announce)
-  } while (table_ptr != _table);
+bool ParallelHashMap<K,V>::find(const K& key, V& value) {
 
-  /* see if current table contains the thread */
-  bool present = table_ptr->contains(key);
+  node* n = find_node(key, std::hash<K>()(key));
+  if (n == NULL)
+    return false;
 
-  /* reset table announcement to not searching */
-  _announce[tid].value = NULL;
-
-  return present;
+  value = n->value;
+  return true;
 }
 
 
 /**
  * @brief Determine the value associated with a given key.
- * @details This function follows the same algorithm as <contains> except that
- *      the value associated with the searched key is returned.
- *      First the thread accessing the table acquires the lock corresponding
- *      with the associated bucket based on the key. Then the linked list
- *      in the bucket is searched for the key. An exception is thrown if the
- *      key is not found. When the thread has finished accessing the table,
- *      it releases the lock.
+ * @details An exception is thrown if the key is not found.
  * @param key key to be searched
  * @return value associated with the key
  */
 template <class K, class V>
-V ParallelHashMap<K,V>::at(K key) {
-  /* get thread ID */
-  size_t tid = 0;
-  tid = omp_get_thread_num();
-
-  /* get pointer to table, announce it will be searched */
-  FixedHashMap<K,V> *table_ptr;
-  do {
-    table_ptr = _table;
-    _announce[tid].value = table_ptr;
-#pragma omp flush(_announce)
-  } while (table_ptr != _table);
-
-  /* get value associated with the key in the underlying table */
-  V value = table_ptr->at(key);
-
-  /* reset table announcement to not searching */
-  _announce[tid].value = NULL;
-
-  return value;
+V ParallelHashMap<K,V>::at(const K& key) {
+
+  node* n = find_node(key, std::hash<K>()(key));
+  if (n == NULL)
+    throw std::out_of_range("Key not present in map");
+
+  return n->value;
 }
 
 
 /**
  * @brief Insert a given key/value pair into the parallel hash map.
- * @details First the underlying table is checked to determine if a resize
- *      should be conducted. Then, the table is checked to see if it
- *      already contains the key. If so, the key/value pair is not inserted
- *      and the function returns. Otherwise, the lock of the associated
- *      bucket is acquired and the key/value pair is added to the bucket.
+ * @details If the key is already present, the key/value pair is not inserted
+ *      and the function returns.
  * @param key key of the key/value pair to be inserted
  * @param value value of the key/value pair to be inserted
  */
 template <class K, class V>
-void ParallelHashMap<K,V>::insert(K key, V value) {
-  /* check if resize needed */
-  if (2*_table->size() > _table->bucket_count())
-    resize();
-
-  /* check to see if key is already contained in the table */
-  if (contains(key))
-    return;
-
-  /* get lock hash */
-  size_t lock_hash = (std::hash<K>()(key) & (_table->bucket_count() - 1))
-    % _num_locks;
-
-  /* acquire lock */
-  omp_set_lock(&_locks[lock_hash]);
-
-  /* insert value */
-  _table->insert(key, value);
-
-  /* release lock */
-  omp_unset_lock(&_locks[lock_hash]);
+void ParallelHashMap<K,V>::insert(const K& key, V value) {
+  insert_and_get_count(key, value);
 }
 
 
 /**
  * @brief Updates the value associated with a key in the parallel hash map.
- * @details The thread first acquires the lock for the bucket associated with
- *      the key is acquired, then the linked list in the bucket is searched
- *      for the key. If the key is not found, an exception is returned. When
- *      the key is found, the value is updated and the lock is released.
+ * @details If the key is not found, an exception is thrown.
  * @param key the key of the key/value pair to be updated
  * @param value the new value for the key/value pair
  */
 template <class K, class V>
-void ParallelHashMap<K,V>::update(K key, V value) {
-
-  /* get lock hash */
-  size_t lock_hash = (std::hash<K>()(key) & (_table->bucket_count() - 1))
-    % _num_locks;
-
-  /* acquire lock */
-  omp_set_lock(&_locks[lock_hash]);
+void ParallelHashMap<K,V>::update(const K& key, V value) {
 
-  /* insert value */
-  _table->at(key) = value;
+  node* n = find_node(key, std::hash<K>()(key));
+  if (n == NULL)
+    throw std::out_of_range("Key not present in map");
 
-  /* release lock */
-  omp_unset_lock(&_locks[lock_hash]);
+  n->value = value;
 }
 
 
 /**
  * @brief Insert a given key/value pair into the parallel hash map and return
       the order number.
- * @details First the underlying table is checked to determine if a resize
- *      should be conducted. Then, the table is checked to see if it
- *      already contains the key. If so, the key/value pair is not inserted
- *      and the function returns. Otherwise, the lock of the associated
- *      bucket is acquired and the key/value pair is added to the bucket.
+ * @details First the table is checked to determine if a resize should be
+ *      conducted. If the key is already present, the key/value pair is not
+ *      inserted and the function returns -1. Otherwise the order number is
+ *      drawn from a monotonic counter once the key/value pair is inserted.
  * @param key key of the key/value pair to be inserted
  * @param value value of the key/value pair to be inserted
  * @return order number in which the key/value pair was inserted, -1 if it
  *      already exists
  */
 template <class K, class V>
-int ParallelHashMap<K,V>::insert_and_get_count(K key, V value) {
+int ParallelHashMap<K,V>::insert_and_get_count(const K& key, V value) {
 
   /* check if resize needed */
-  if (2*_table->size() > _table->bucket_count())
+  if (2*(_N+1) > _table->M)
     resize();
 
-  /* check to see if key is already contained in the table */
-  if (contains(key))
+  bool inserted;
+  insert_node(key, value, inserted);
+  if (!inserted)
     return -1;
 
-  /* get lock hash */
-  size_t lock_hash = (std::hash<K>()(key) & (_table->bucket_count() - 1))
-    % _num_locks;
-
-  /* acquire lock */
-  omp_set_lock(&_locks[lock_hash]);
-
-  /* insert value */
-  int N =_table->insert_and_get_count(key, value);
-
-  /* release lock */
-  omp_unset_lock(&_locks[lock_hash]);
+  /* increment counter and return number */
+  size_t N;
+#pragma omp atomic capture
+  N = _N++;
 
-  return N;
+  return (int) N;
 }
 
 
 /**
- * @brief Resizes the underlying table to twice its current capacity.
- * @details In a thread-safe manner, this procedure resizes the underlying
- *    FixedHashMap table to twice its current capacity using locks and the
- *    announce array. First, all locks are set in order to block inserts and
- *    prevent deadlock. A new table is allocated of twice the size and all
- *    key/value pairs from the old table, then the pointer is switched to the
- *    new table and locks are released. Finally the memory needs to be freed.
- *    To prevent threads currently reading the table from encountering
- *    segmentation faults, the resizing threads waits for the announce array
- *    to be free of references to the old table before freeing the memory.
+ * @brief Resizes the table to twice its current capacity.
+ * @details A single thread resizes the table at a time. It publishes a new
+ *    table of twice the size, which receives all later insertions, and then
+ *    copies the nodes of the old table into it, sealing its empty slots.
+ *    Other threads which find the table half full while a copy is in
+ *    progress continue to insert into the new table. They only wait for the
+ *    copy to complete if the new table becomes three quarters full.
  */
 template <class K, class V>
 void ParallelHashMap<K,V>::resize() {
 
-  /* acquire all locks in order */
-  for (size_t i=0; i<_num_locks; i++)
-    omp_set_lock(&_locks[i]);
-
-  /* recheck if resize needed */
-  if (2*_table->size() < _table->bucket_count()) {
-    /* release locks */
-    for (size_t i=0; i<_num_locks; i++)
-      omp_unset_lock(&_locks[i]);
-
-    return;
-  }
+  while (true) {
 
-  /* allocate new hash map of double the size */
-  FixedHashMap<K,V> *new_map =
-    new FixedHashMap<K,V>(2*_table->bucket_count());
+    /* recheck if resize needed */
+    table* old_table = _table;
+    if (2*(_N+1) <= old_table->M)
+      return;
 
-  /* get keys, values, and number of elements */
-  K *key_list = _table->keys();
-  V *value_list = _table->values();
+    if (__sync_bool_compare_and_swap(&_resizing, 0, 1))
+      break;
 
-  /* insert key/value pairs into new hash map */
-  for (size_t i=0; i<_table->size(); i++)
-    new_map->insert(key_list[i], value_list[i]);
-
-  /* save pointer of old table */
-  FixedHashMap<K,V> *old_table = _table;
-
-  /* reassign pointer */
-  _table = new_map;
-#pragma omp flush(_table)
+    /* leave the resize to the thread copying the table, unless the new table
+     * is nearly full */
+    if (4*_N <= 3*old_table->M)
+      return;
+  }
 
-  /* release all locks */
-  for (size_t i=0; i<_num_locks; i++)
-    omp_unset_lock(&_locks[i]);
+  table* old_table = _table;
+  if (2*(_N+1) <= old_table->M) {
+    _resizing = 0;
+    return;
+  }
 
-  /* delete key and value list */
-  delete [] key_list;
-  delete [] value_list;
+  /* allocate and publish new table of double the size */
+  table* new_table = new table(2*old_table->M, old_table);
+  old_table->next = new_table;
+  __sync_synchronize();
+  _table = new_table;
+  __sync_synchronize();
+
+  /* copy the nodes of the old table, sealing its empty slots */
+  for (size_t i=0; i < old_table->M; i++) {
+
+    node* n = old_table->slots[i];
+    while (n == NULL) {
+      if (__sync_bool_compare_and_swap(&old_table->slots[i], (node*) NULL,
+                                       sealed()))
+        n = sealed();
+      else
+        n = old_table->slots[i];
+    }
 
-  /* wait for all threads to stop reading from the old table */
-  for (size_t i=0; i<_num_threads; i++)
-    while (_announce[i].value == old_table)
+    if (n == sealed())
       continue;
 
-  /* free memory associated with old table */
-  delete old_table;
+    /* place the node in the first empty slot along its probe sequence */
+    size_t j = n->hash & (new_table->M-1);
+    while (!__sync_bool_compare_and_swap(&new_table->slots[j], (node*) NULL,
+                                         n))
+      j = (j+1) & (new_table->M-1);
+  }
+
+  /* allow lookups to skip the old table */
+  __sync_synchronize();
+  new_table->copied = true;
+  __sync_synchronize();
+  _resizing = 0;
 }
 
 
 /**
- * @brief Returns the number of key/value pairs in the underlying table
+ * @brief Returns the number of key/value pairs in the table
  * @return number of key/value pairs in the map
  */
 template <class K, class V>
 size_t ParallelHashMap<K,V>::size() {
-  return _table->size();
+  return _N;
 }
 
 
 /**
- * @brief Returns the number of buckets in the underlying table
- * @return number of buckets in the map
+ * @brief Returns the number of slots in the table
+ * @return number of slots in the map
  */
 template <class K, class V>
 size_t ParallelHashMap<K,V>::bucket_count() {
-  return _table->bucket_count();
-}
-
-
-/**
- * @brief Returns the number of locks in the parallel hash map
- * @return number of locks in the map
- */
-template <class K, class V>
-size_t ParallelHashMap<K,V>::num_locks() {
-  return _num_locks;
+  return _table->M;
 }
 
 
 /**
- * @brief Returns an array of the keys in the underlying table
- * @details All buckets are scanned in order to form a list of all keys
- *      present in the table and then the list is returned. Threads
- *      announce their presence to ensure table memory is not freed
- *      during access. WARNING: The user is responsible for freeing the
- *      allocated memory once the array is no longer needed.
+ * @brief Returns an array of the keys in the table
+ * @details All slots are scanned in order to form a list of all keys
+ *      present in the table and then the list is returned. This must not be
+ *      called while keys are being inserted. WARNING: The user is responsible
+ *      for freeing the allocated memory once the array is no longer needed.
  * @return an array of keys in the map whose length is the number of key/value
  *      pairs in the table.
  */
 template <class K, class V>
 K* ParallelHashMap<K,V>::keys() {
 
-  /* get thread ID */
-  size_t tid = 0;
-  tid = omp_get_thread_num();
-
-  /* get pointer to table, announce it will be searched */
-  FixedHashMap<K,V> *table_ptr;
-  do {
-    table_ptr = _table;
-    _announce[tid].value = table_ptr;
-#pragma omp flush(_announce)
-  } while (table_ptr != _table);
-
-  /* get key list */
-  K* key_list = table_ptr->keys();
-
-  /* reset table announcement to not searching */
-  _announce[tid].value = NULL;
+  /* allocate array of keys */
+  K *key_list = new K[_N];
 
+  /* fill array with keys */
+  table* t = _table;
+  size_t ind = 0;
+  for (size_t i=0; i < t->M; i++) {
+    node* n = t->slots[i];
+    if (n != NULL && n != sealed()) {
+      key_list[ind] = n->key;
+      ind++;
+    }
+  }
   return key_list;
 }
 
 
 /**
- * @brief Returns an array of the values in the underlying table
- * @details All buckets are scanned in order to form a list of all values
- *      present in the table and then the list is returned. Threads
- *      announce their presence to ensure table memory is not freed
- *      during access. WARNING: The user is responsible for freeing the
- *      allocated memory once the array is no longer needed.
- * @return an array of values in the map whose length is the number of key/value
- *      pairs in the table.
+ * @brief Returns an array of the values in the table
+ * @details All slots are scanned in order to form a list of all values
+ *      present in the table and then the list is returned, in the same order
+ *      as the keys returned by ParallelHashMap::keys(). This must not be
+ *      called while keys are being inserted. WARNING: The user is responsible
+ *      for freeing the allocated memory once the array is no longer needed.
+ * @return an array of values in the map whose length is the number of
+ *      key/value pairs in the table.
  */
 template <class K, class V>
 V* ParallelHashMap<K,V>::values() {
 
-  /* get thread ID */
-  size_t tid = 0;
-  tid = omp_get_thread_num();
+  /* allocate array of values */
+  V *value_list = new V[_N];
+
+  /* fill array with values */
+  table* t = _table;
+  size_t ind = 0;
+  for (size_t i=0; i < t->M; i++) {
+    node* n = t->slots[i];
+    if (n != NULL && n != sealed()) {
+      value_list[ind] = n->value;
+      ind++;
+    }
+  }
+  return value_list;
+}
 
-  /* get pointer to table, announce it will be searched */
-  FixedHashMap<K,V> *table_ptr;
-  do {
-    table_ptr = _table;
-    _announce[tid].value = table_ptr;
-#pragma omp flush(_announce)
-  } while (table_ptr != _table);
 
-  /* get value list */
-  V* value_list = table_ptr->values();
+/**
+ * @brief Frees all nodes and all tables of the map.
+ * @details Every node is present in the newest table once all copies have
+ *      completed, so the nodes are freed from the newest table only.
+ */
+template <class K, class V>
+void ParallelHashMap<K,V>::free_tables() {
 
-  /* reset table announcement to not searching */
-  _announce[tid].value = NULL;
+  table* t = _table;
+  for (size_t i=0; i < t->M; i++) {
+    node* n = t->slots[i];
+    if (n != NULL && n != sealed())
+      delete n;
+  }
 
-  return value_list;
+  while (t != NULL) {
+    table* prev = t->prev;
+    delete t;
+    t = prev;
+  }
 }
 
 
 /**
  * @brief Clears all key/value pairs form the hash table.
+ * @details This must not be called concurrently with any other operation.
  */
 template <class K, class V>
 void ParallelHashMap<K,V>::clear() {
-
-  /* acquire all locks in order */
-  for (size_t i=0; i<_num_locks; i++)
-    omp_set_lock(&_locks[i]);
-
-  /* clear underlying fixed table */
-  _table->clear();
-
-  /* release all locks in order */
-  for (size_t i=0; i<_num_locks; i++)
-    omp_unset_lock(&_locks[i]);
+  free_tables();
+  _N = 0;
+  _table = new table(_M, NULL);
 }
 
 
 /**
- * @brief Prints the contents of each bucket to the screen
- * @details All buckets are scanned and the contents of the buckets are
- *      printed, which are pointers to linked lists. If the pointer is NULL
- *      suggesting that the linked list is empty, NULL is printed to the
- *      screen. Threads announce their presence to ensure table memory is
- *      not freed during access.
+ * @brief Prints the contents of each slot to the screen
+ * @details All slots are scanned and the contents of the slots are
+ *      printed, which are pointers to nodes. If the pointer is NULL
+ *      suggesting that the slot is empty, NULL is printed to the screen.
  */
 template <class K, class V>
 void ParallelHashMap<K,V>::print_buckets() {
-
-  /* get thread ID */
-  size_t tid = 0;
-  tid = omp_get_thread_num();
-
-  /* get pointer to table, announce it will be searched */
-  FixedHashMap<K,V> *table_ptr;
-  do {
-    table_ptr = _table;
-    _announce[tid].value = table_ptr;
-#pragma omp flush(_announce)
-  } while (table_ptr != _table);
-
-  /* print buckets */
-  table_ptr->print_buckets();
-
-  /* reset table announcement to not searching */
-  _announce[tid].value = NULL;
+  log_printf(NORMAL, "Printing all buckets in the hash map...");
+  table* t = _table;
+  for (size_t i=0; i < t->M; i++) {
+    if (t->slots[i] == NULL)
+      log_printf(NORMAL, "Bucket %d -> NULL", i);
+    else
+      log_printf(NORMAL, "Bucket %d -> %p", i, t->slots[i]);
+  }
 }
 
 #endif
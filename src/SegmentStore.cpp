@@ -0,0 +1,585 @@
+#include "SegmentStore.h"
+
+
+/**
+ * @brief Constructor initializes an empty SegmentStore for some Tracks.
+ * @param num_tracks the number of Tracks whose segments will be stored
+ */
+SegmentStore::SegmentStore(int num_tracks) {
+
+  if (num_tracks <= 0)
+    log_printf(ERROR, "Unable to create a SegmentStore for %d Tracks",
+               num_tracks);
+
+  _num_tracks = num_tracks;
+  _num_segments = 0;
+  _max_num_segments = 0;
+  _lengths = NULL;
+  _material_indices = NULL;
+  _region_ids = NULL;
+  _cmfd_surfaces_fwd = NULL;
+  _cmfd_surfaces_bwd = NULL;
+  _num_materials = 0;
+  _materials = NULL;
+  _compressed = false;
+  _packed_lengths = NULL;
+  _length_scales = NULL;
+  _packed_material_indices = NULL;
+  _region_id_deltas = NULL;
+  _escaped_region_ids = NULL;
+  _escape_offsets = NULL;
+  _cmfd_crossings = NULL;
+  _crossing_offsets = NULL;
+
+  /* Initialize the number of segments on each Track to zero */
+  _track_offsets = new long[_num_tracks+1];
+  for (int i=0; i <= _num_tracks; i++)
+    _track_offsets[i] = 0;
+}
+
+
+/**
+ * @brief Destructor deletes the segment arrays and Material table.
+ */
+SegmentStore::~SegmentStore() {
+
+  delete [] _track_offsets;
+  deleteSegmentArrays();
+
+  if (_packed_lengths != NULL)
+    delete [] _packed_lengths;
+
+  if (_length_scales != NULL)
+    delete [] _length_scales;
+
+  if (_packed_material_indices != NULL)
+    delete [] _packed_material_indices;
+
+  if (_region_id_deltas != NULL)
+    delete [] _region_id_deltas;
+
+  if (_escaped_region_ids != NULL)
+    delete [] _escaped_region_ids;
+
+  if (_escape_offsets != NULL)
+    delete [] _escape_offsets;
+
+  if (_cmfd_crossings != NULL)
+    delete [] _cmfd_crossings;
+
+  if (_crossing_offsets != NULL)
+    delete [] _crossing_offsets;
+
+  if (_materials != NULL)
+    delete [] _materials;
+}
+
+
+/**
+ * @brief Deletes the uncompressed segment arrays.
+ */
+void SegmentStore::deleteSegmentArrays() {
+
+  if (_lengths != NULL)
+    delete [] _lengths;
+
+  if (_material_indices != NULL)
+    delete [] _material_indices;
+
+  if (_region_ids != NULL)
+    delete [] _region_ids;
+
+  if (_cmfd_surfaces_fwd != NULL)
+    delete [] _cmfd_surfaces_fwd;
+
+  if (_cmfd_surfaces_bwd != NULL)
+    delete [] _cmfd_surfaces_bwd;
+
+  _lengths = NULL;
+  _material_indices = NULL;
+  _region_ids = NULL;
+  _cmfd_surfaces_fwd = NULL;
+  _cmfd_surfaces_bwd = NULL;
+}
+
+
+/**
+ * @brief Returns the number of Tracks in the SegmentStore.
+ * @return the number of Tracks
+ */
+int SegmentStore::getNumTracks() {
+  return _num_tracks;
+}
+
+
+/**
+ * @brief Returns the total number of segments across all Tracks.
+ * @return the total number of segments
+ */
+long SegmentStore::getNumSegments() {
+  return _num_segments;
+}
+
+
+/**
+ * @brief Returns the maximum number of segments on any Track.
+ * @return the maximum number of segments on a Track
+ */
+int SegmentStore::getMaxNumSegments() {
+  return _max_num_segments;
+}
+
+
+/**
+ * @brief Returns the number of bytes used to store the segments.
+ * @return the number of bytes in the segment arrays and Track offsets
+ */
+long SegmentStore::getNumBytes() {
+
+  if (!_compressed)
+    return getNumUncompressedBytes();
+
+  long num_escapes = _escape_offsets[_num_tracks];
+  long num_crossings = _crossing_offsets[_num_tracks];
+
+  long num_bytes = 3 * (_num_tracks + 1) * sizeof(long);
+  num_bytes += _num_tracks * sizeof(double);
+  num_bytes += _num_segments * (2 * sizeof(unsigned short) + sizeof(short));
+  num_bytes += num_escapes * sizeof(int);
+  num_bytes += num_crossings * sizeof(cmfdCrossing);
+  return num_bytes;
+}
+
+
+/**
+ * @brief Returns the number of bytes used to store the segments without
+ *        compression.
+ * @return the number of bytes in the uncompressed segment arrays and Track
+ *         offsets
+ */
+long SegmentStore::getNumUncompressedBytes() {
+  long num_bytes = (_num_tracks + 1) * sizeof(long);
+  num_bytes += _num_segments * (sizeof(FP_STORAGE) + 4 * sizeof(int));
+  return num_bytes;
+}
+
+
+/**
+ * @brief Returns whether the segments have been compressed.
+ * @return whether the segments are decoded with decodeTrack(...)
+ */
+bool SegmentStore::isCompressed() {
+  return _compressed;
+}
+
+
+/**
+ * @brief Returns the number of Materials in the Material table.
+ * @return the number of Materials
+ */
+int SegmentStore::getNumMaterials() {
+  return _num_materials;
+}
+
+
+/**
+ * @brief Returns the index of a Material in the Material table.
+ * @param material a pointer to the Material of interest
+ * @return the Material's index in the Material table
+ */
+int SegmentStore::getMaterialIndex(Material* material) {
+
+  std::map<Material*, int>::iterator iter;
+  iter = _material_indices_map.find(material);
+
+  if (iter == _material_indices_map.end())
+    log_printf(ERROR, "Unable to find Material ID = %d in the SegmentStore's "
+               "Material table", material->getId());
+
+  return iter->second;
+}
+
+
+/**
+ * @brief Returns the FSR ID of the first segment on a Track.
+ * @param track_uid the UID of the Track of interest
+ * @return the FSR ID of the Track's first segment
+ */
+int SegmentStore::getFirstRegionId(int track_uid) {
+
+  long start = _track_offsets[track_uid];
+
+  if (!_compressed)
+    return _region_ids[start];
+
+  /* The first FSR ID is stored as a difference from zero */
+  short delta = _region_id_deltas[start];
+  if (delta == REGION_ID_ESCAPE)
+    return _escaped_region_ids[_escape_offsets[track_uid]];
+  else
+    return delta;
+}
+
+
+/**
+ * @brief Returns the FSR ID of the last segment on a Track.
+ * @details The FSR IDs of a compressed Track are accumulated from their
+ *          differences without decoding the rest of the segments.
+ * @param track_uid the UID of the Track of interest
+ * @return the FSR ID of the Track's last segment
+ */
+int SegmentStore::getLastRegionId(int track_uid) {
+
+  long end = _track_offsets[track_uid+1];
+
+  if (!_compressed)
+    return _region_ids[end-1];
+
+  long escape = _escape_offsets[track_uid];
+  int region_id = 0;
+
+  for (long s=_track_offsets[track_uid]; s < end; s++) {
+    short delta = _region_id_deltas[s];
+    if (delta == REGION_ID_ESCAPE)
+      region_id = _escaped_region_ids[escape++];
+    else
+      region_id += delta;
+  }
+
+  return region_id;
+}
+
+
+/**
+ * @brief Allocates a buffer into which the segments of any Track of a
+ *        compressed SegmentStore may be decoded.
+ * @details The buffer is a SegmentStore for a single Track sized for the
+ *          longest Track, which shares this SegmentStore's Material table.
+ *          It is deleted by the caller.
+ * @return a pointer to the buffer, or NULL if the SegmentStore is not
+ *         compressed
+ */
+SegmentStore* SegmentStore::createTrackBuffer() {
+
+  if (!_compressed)
+    return NULL;
+
+  SegmentStore* buffer = new SegmentStore(1);
+
+  buffer->_num_materials = _num_materials;
+  buffer->_materials = new Material*[_num_materials];
+  std::copy(_materials, _materials + _num_materials, buffer->_materials);
+  buffer->_material_indices_map = _material_indices_map;
+
+  buffer->setNumSegments(0, _max_num_segments);
+  buffer->allocate();
+
+  return buffer;
+}
+
+
+/**
+ * @brief Builds the table of Materials referenced by the segments.
+ * @param materials a std::map of Material IDs and Material pointers
+ */
+void SegmentStore::setMaterials(std::map<int, Material*> materials) {
+
+  if (_materials != NULL)
+    delete [] _materials;
+
+  _material_indices_map.clear();
+  _num_materials = materials.size();
+  _materials = new Material*[_num_materials];
+
+  std::map<int, Material*>::iterator iter;
+  int index = 0;
+
+  for (iter = materials.begin(); iter != materials.end(); ++iter) {
+    _materials[index] = iter->second;
+    _material_indices_map[iter->second] = index;
+    index++;
+  }
+}
+
+
+/**
+ * @brief Registers the number of segments on a Track prior to allocation.
+ * @param track_uid the UID of the Track of interest
+ * @param num_segments the number of segments on the Track
+ */
+void SegmentStore::setNumSegments(int track_uid, int num_segments) {
+
+  if (track_uid < 0 || track_uid >= _num_tracks)
+    log_printf(ERROR, "Unable to set the number of segments for Track %d "
+               "in a SegmentStore with %d Tracks", track_uid, _num_tracks);
+
+  /* Store the count one past the Track to be summed into offsets */
+  _track_offsets[track_uid+1] = num_segments;
+}
+
+
+/**
+ * @brief Computes each Track's offset from the number of segments on each
+ *        Track and allocates the segment arrays.
+ */
+void SegmentStore::allocate() {
+
+  /* Compute the offsets with a prefix sum over the segment counts */
+  _track_offsets[0] = 0;
+  for (int i=0; i < _num_tracks; i++)
+    _track_offsets[i+1] += _track_offsets[i];
+
+  _num_segments = _track_offsets[_num_tracks];
+
+  _max_num_segments = 0;
+  for (int i=0; i < _num_tracks; i++)
+    _max_num_segments = std::max(_max_num_segments,
+                                 int(_track_offsets[i+1] - _track_offsets[i]));
+
+  try {
+    _lengths = new FP_STORAGE[_num_segments];
+    _material_indices = new int[_num_segments];
+    _region_ids = new int[_num_segments];
+    _cmfd_surfaces_fwd = new int[_num_segments];
+    _cmfd_surfaces_bwd = new int[_num_segments];
+  }
+  catch (std::exception &e) {
+    log_printf(ERROR, "Unable to allocate memory for %ld segments in the "
+               "SegmentStore", _num_segments);
+  }
+}
+
+
+/**
+ * @brief Compresses the filled segment arrays and deletes them.
+ * @details Each segment length is quantized to an integer number of
+ *          increments of its Track's longest segment length divided by
+ *          MAX_PACKED_LENGTH, as described in packLengths(...). The FSR ID of
+ *          each segment is stored as a 16-bit difference from the previous
+ *          segment's FSR ID, with REGION_ID_ESCAPE marking FSR IDs which are
+ *          read from a side table. The CMFD surfaces are only stored for the
+ *          segments which cross the CMFD mesh.
+ */
+void SegmentStore::compress() {
+
+  if (_compressed)
+    return;
+
+  if (_num_materials > USHRT_MAX + 1)
+    log_printf(ERROR, "Unable to compress the segments for %d Materials "
+               "which exceed the range of a 16-bit Material index",
+               _num_materials);
+
+  _escape_offsets = new long[_num_tracks+1];
+  _crossing_offsets = new long[_num_tracks+1];
+  _escape_offsets[0] = 0;
+  _crossing_offsets[0] = 0;
+
+  /* Count the escaped FSR IDs and CMFD crossings on each Track */
+#pragma omp parallel for schedule(guided)
+  for (int t=0; t < _num_tracks; t++) {
+
+    int num_escapes = 0;
+    int num_crossings = 0;
+    int region_id = 0;
+
+    for (long s=_track_offsets[t]; s < _track_offsets[t+1]; s++) {
+      long delta = long(_region_ids[s]) - region_id;
+      if (delta <= REGION_ID_ESCAPE || delta > SHRT_MAX)
+        num_escapes++;
+      if (_cmfd_surfaces_fwd[s] != -1 || _cmfd_surfaces_bwd[s] != -1)
+        num_crossings++;
+      region_id = _region_ids[s];
+    }
+
+    _escape_offsets[t+1] = num_escapes;
+    _crossing_offsets[t+1] = num_crossings;
+  }
+
+  /* Compute the side table offsets with prefix sums over the counts */
+  for (int t=0; t < _num_tracks; t++) {
+    _escape_offsets[t+1] += _escape_offsets[t];
+    _crossing_offsets[t+1] += _crossing_offsets[t];
+  }
+
+  try {
+    _packed_lengths = new unsigned short[_num_segments];
+    _length_scales = new double[_num_tracks];
+    _packed_material_indices = new unsigned short[_num_segments];
+    _region_id_deltas = new short[_num_segments];
+    _escaped_region_ids = new int[_escape_offsets[_num_tracks]];
+    _cmfd_crossings = new cmfdCrossing[_crossing_offsets[_num_tracks]];
+  }
+  catch (std::exception &e) {
+    log_printf(ERROR, "Unable to allocate memory to compress %ld segments "
+               "in the SegmentStore", _num_segments);
+  }
+
+  /* Encode the segments of each Track */
+#pragma omp parallel for schedule(guided)
+  for (int t=0; t < _num_tracks; t++) {
+
+    long start = _track_offsets[t];
+    long end = _track_offsets[t+1];
+    long escape = _escape_offsets[t];
+    long crossing = _crossing_offsets[t];
+    int region_id = 0;
+
+    packLengths(t, &_lengths[start]);
+
+    for (long s=start; s < end; s++) {
+
+      _packed_material_indices[s] = _material_indices[s];
+
+      long delta = long(_region_ids[s]) - region_id;
+      if (delta <= REGION_ID_ESCAPE || delta > SHRT_MAX) {
+        _region_id_deltas[s] = REGION_ID_ESCAPE;
+        _escaped_region_ids[escape++] = _region_ids[s];
+      }
+      else
+        _region_id_deltas[s] = delta;
+      region_id = _region_ids[s];
+
+      if (_cmfd_surfaces_fwd[s] != -1 || _cmfd_surfaces_bwd[s] != -1) {
+        _cmfd_crossings[crossing]._index = s - start;
+        _cmfd_crossings[crossing]._cmfd_surface_fwd = _cmfd_surfaces_fwd[s];
+        _cmfd_crossings[crossing]._cmfd_surface_bwd = _cmfd_surfaces_bwd[s];
+        crossing++;
+      }
+    }
+  }
+
+  deleteSegmentArrays();
+  _compressed = true;
+}
+
+
+/**
+ * @brief Quantizes the lengths of the segments on a Track.
+ * @details The length of one increment is the Track's longest segment length
+ *          divided by MAX_PACKED_LENGTH. The increments are rounded from the
+ *          Track's cumulative length at each segment's end point, such that
+ *          the rounding errors do not accumulate along the Track. Each
+ *          segment is given at least one increment so that no segment, and
+ *          no FSR crossed only by short segments, is left with a zero length.
+ * @param track_uid the UID of the Track of interest
+ * @param lengths the lengths of the segments on the Track (cm)
+ */
+void SegmentStore::packLengths(int track_uid, FP_STORAGE* lengths) {
+
+  long start = _track_offsets[track_uid];
+  int num_segments = _track_offsets[track_uid+1] - start;
+
+  /* Find the length of one quantized increment on this Track */
+  double max_length = 0.;
+  for (int i=0; i < num_segments; i++)
+    max_length = std::max(max_length, double(lengths[i]));
+  double scale = (max_length > 0.) ? max_length / MAX_PACKED_LENGTH : 1.;
+  _length_scales[track_uid] = scale;
+
+  double cumulative_length = 0.;
+  long cumulative_increments = 0;
+
+  for (int i=0; i < num_segments; i++) {
+
+    /* Round the cumulative length to find this segment's increments */
+    cumulative_length += lengths[i];
+    long increments = std::max(lround(cumulative_length / scale),
+                               cumulative_increments + 1);
+    _packed_lengths[start+i] = increments - cumulative_increments;
+    cumulative_increments = increments;
+  }
+}
+
+
+/**
+ * @brief Rebuilds the Material table and sets the Material of each segment
+ *        to the Material filling its FSR.
+ * @details This is used when the Materials filling the FSRs are changed
+ *          between simulations.
+ * @param materials a std::map of Material IDs and Material pointers
+ * @param region_materials the Material filling each FSR, indexed by FSR ID
+ * @param num_regions the number of FSRs
+ */
+void SegmentStore::updateMaterials(std::map<int, Material*> materials,
+                                   Material** region_materials,
+                                   int num_regions) {
+
+  setMaterials(materials);
+
+  if (_compressed && _num_materials > USHRT_MAX + 1)
+    log_printf(ERROR, "Unable to store the segments for %d Materials "
+               "which exceed the range of a 16-bit Material index",
+               _num_materials);
+
+  /* Find the index into the Material table of each FSR's Material */
+  std::vector<int> region_indices(num_regions);
+  for (int r=0; r < num_regions; r++)
+    region_indices[r] = getMaterialIndex(region_materials[r]);
+
+#pragma omp parallel for schedule(guided)
+  for (int t=0; t < _num_tracks; t++) {
+
+    long escape = (_compressed) ? _escape_offsets[t] : 0;
+    int region_id = 0;
+
+    for (long s=_track_offsets[t]; s < _track_offsets[t+1]; s++) {
+
+      /* Decode the FSR ID of a compressed segment */
+      if (_compressed) {
+        short delta = _region_id_deltas[s];
+        if (delta == REGION_ID_ESCAPE)
+          region_id = _escaped_region_ids[escape++];
+        else
+          region_id += delta;
+
+        _packed_material_indices[s] = region_indices[region_id];
+      }
+      else
+        _material_indices[s] = region_indices[_region_ids[s]];
+    }
+  }
+}
+
+
+/**
+ * @brief Scales the lengths of the segments in an FSR on a range of Tracks.
+ * @details The lengths of the compressed Tracks crossing the FSR are decoded,
+ *          scaled and quantized anew.
+ * @param region_id the ID of the FSR whose segments are scaled
+ * @param factor the factor by which to scale the segment lengths
+ * @param first_track_uid the UID of the first Track in the range
+ * @param last_track_uid the UID one past the last Track in the range
+ */
+void SegmentStore::scaleLengths(int region_id, double factor,
+                                int first_track_uid, int last_track_uid) {
+
+#pragma omp parallel
+  {
+    SegmentStore* buffer = createTrackBuffer();
+
+#pragma omp for schedule(guided)
+    for (int t=first_track_uid; t < last_track_uid; t++) {
+
+      long start, end;
+      SegmentStore* store = getTrackSegments(t, buffer, &start, &end);
+      FP_STORAGE* lengths = store->_lengths;
+      int* region_ids = store->_region_ids;
+      bool scaled = false;
+
+      for (long s=start; s < end; s++) {
+        if (region_ids[s] == region_id) {
+          lengths[s] *= factor;
+          scaled = true;
+        }
+      }
+
+      /* Quantize the decoded lengths of a compressed Track anew */
+      if (_compressed && scaled)
+        packLengths(t, &lengths[start]);
+    }
+
+    if (buffer != NULL)
+      delete buffer;
+  }
+}
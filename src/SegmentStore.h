@@ -0,0 +1,316 @@
+/**
+ * @file SegmentStore.h
+ * @brief The SegmentStore class.
+ * @date October 15, 2026
+ */
+
+#ifndef SEGMENTSTORE_H_
+#define SEGMENTSTORE_H_
+
+#ifdef __cplusplus
+#ifdef SWIG
+#include "Python.h"
+#endif
+#include "Material.h"
+#include "constants.h"
+#include "log.h"
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <limits.h>
+#include <math.h>
+#endif
+
+
+/**
+ * @struct cmfdCrossing
+ * @brief A cmfdCrossing records the CMFD mesh surfaces crossed by one
+ *        segment of a compressed SegmentStore.
+ */
+struct cmfdCrossing {
+
+  /** The index of the segment within its Track */
+  int _index;
+
+  /** The CMFD mesh surface crossed by the segment's end point */
+  int _cmfd_surface_fwd;
+
+  /** The CMFD mesh surface crossed by the segment's start point */
+  int _cmfd_surface_bwd;
+};
+
+
+/**
+ * @class SegmentStore SegmentStore.h "src/SegmentStore.h"
+ * @brief A SegmentStore holds the segments for all Tracks in contiguous
+ *        structure-of-arrays storage.
+ * @details Each segment attribute (length, Material index, FSR ID and CMFD
+ *          surfaces) is stored in its own flat array, and the segments for
+ *          each Track occupy a contiguous range of these arrays beginning at
+ *          the Track's offset, indexed by Track UID. A SegmentStore is filled
+ *          in two passes: the number of segments on each Track is first
+ *          registered with setNumSegments(...), after which allocate()
+ *          computes the offsets and allocates the arrays to be filled with
+ *          setSegment(...).
+ *
+ *          A filled SegmentStore may be compressed with compress(), after
+ *          which the segments of each Track are decoded with decodeTrack(...)
+ *          into a SegmentStore buffer rather than being read from the arrays.
+ *          The segment lengths are quantized to 16-bit increments of each
+ *          Track's cumulative length, the Material indices are stored in
+ *          16 bits, the FSR IDs are delta encoded in 16 bits with the IDs
+ *          which do not fit in a side table, and the CMFD surfaces of the few
+ *          segments which cross the CMFD mesh are kept in another side table.
+ */
+class SegmentStore {
+
+private:
+
+  /** The number of Tracks */
+  int _num_tracks;
+
+  /** The total number of segments across all Tracks */
+  long _num_segments;
+
+  /** The maximum number of segments on any Track */
+  int _max_num_segments;
+
+  /** The offset of the first segment of each Track, indexed by Track UID,
+   *  with the total number of segments in the last entry */
+  long* _track_offsets;
+
+  /** The length of each segment (cm) */
+  FP_STORAGE* _lengths;
+
+  /** The index into the Material table of each segment */
+  int* _material_indices;
+
+  /** The FSR ID of each segment */
+  int* _region_ids;
+
+  /** The CMFD mesh surface crossed by each segment's end point */
+  int* _cmfd_surfaces_fwd;
+
+  /** The CMFD mesh surface crossed by each segment's start point */
+  int* _cmfd_surfaces_bwd;
+
+  /** The number of Materials in the Material table */
+  int _num_materials;
+
+  /** The table of Materials referenced by the segment Material indices */
+  Material** _materials;
+
+  /** A mapping of Material pointers to their index in the Material table */
+  std::map<Material*, int> _material_indices_map;
+
+  /** Whether the segments have been compressed */
+  bool _compressed;
+
+  /** The quantized increment of each segment's length (compressed) */
+  unsigned short* _packed_lengths;
+
+  /** The length of one quantized increment on each Track (compressed) */
+  double* _length_scales;
+
+  /** The index into the Material table of each segment (compressed) */
+  unsigned short* _packed_material_indices;
+
+  /** The difference of each segment's FSR ID from the previous segment's
+   *  FSR ID on the Track, or REGION_ID_ESCAPE (compressed) */
+  short* _region_id_deltas;
+
+  /** The FSR IDs of the escaped segments (compressed) */
+  int* _escaped_region_ids;
+
+  /** The offset of each Track's first escaped FSR ID (compressed) */
+  long* _escape_offsets;
+
+  /** The CMFD surfaces of the segments which cross the CMFD mesh
+   *  (compressed) */
+  cmfdCrossing* _cmfd_crossings;
+
+  /** The offset of each Track's first CMFD crossing (compressed) */
+  long* _crossing_offsets;
+
+  void deleteSegmentArrays();
+  void packLengths(int track_uid, FP_STORAGE* lengths);
+
+public:
+  SegmentStore(int num_tracks);
+  virtual ~SegmentStore();
+
+  int getNumTracks();
+  long getNumSegments();
+  int getMaxNumSegments();
+  long getNumBytes();
+  long getNumUncompressedBytes();
+  bool isCompressed();
+  int getNumMaterials();
+  int getMaterialIndex(Material* material);
+  int getFirstRegionId(int track_uid);
+  int getLastRegionId(int track_uid);
+  SegmentStore* createTrackBuffer();
+
+  /**
+   * @brief Returns the offset of a Track's first segment in the arrays.
+   * @param track_uid the UID of the Track of interest
+   * @return the offset of the Track's first segment
+   */
+  inline long getTrackOffset(int track_uid) {
+    return _track_offsets[track_uid];
+  }
+
+  /**
+   * @brief Returns the number of segments on a Track.
+   * @param track_uid the UID of the Track of interest
+   * @return the number of segments on the Track
+   */
+  inline int getNumSegments(int track_uid) {
+    return _track_offsets[track_uid+1] - _track_offsets[track_uid];
+  }
+
+  /**
+   * @brief Returns the array of segment lengths.
+   * @return a pointer to the segment lengths
+   */
+  inline FP_STORAGE* getLengths() {
+    return _lengths;
+  }
+
+  /**
+   * @brief Returns the array of segment Material indices.
+   * @return a pointer to the segment Material indices
+   */
+  inline int* getMaterialIndices() {
+    return _material_indices;
+  }
+
+  /**
+   * @brief Returns the array of segment FSR IDs.
+   * @return a pointer to the segment FSR IDs
+   */
+  inline int* getRegionIds() {
+    return _region_ids;
+  }
+
+  /**
+   * @brief Returns the array of CMFD surfaces crossed by segment end points.
+   * @return a pointer to the forward CMFD surfaces
+   */
+  inline int* getCmfdSurfacesFwd() {
+    return _cmfd_surfaces_fwd;
+  }
+
+  /**
+   * @brief Returns the array of CMFD surfaces crossed by segment start points.
+   * @return a pointer to the backward CMFD surfaces
+   */
+  inline int* getCmfdSurfacesBwd() {
+    return _cmfd_surfaces_bwd;
+  }
+
+  /**
+   * @brief Returns the table of Materials indexed by segment Material index.
+   * @return a pointer to the Material table
+   */
+  inline Material** getMaterials() {
+    return _materials;
+  }
+
+  /**
+   * @brief Sets the attributes of a segment in the arrays.
+   * @param index the index of the segment in the arrays
+   * @param length the segment length (cm)
+   * @param material_index the segment's index in the Material table
+   * @param region_id the segment's FSR ID
+   * @param cmfd_surface_fwd the CMFD surface crossed by the end point
+   * @param cmfd_surface_bwd the CMFD surface crossed by the start point
+   */
+  inline void setSegment(long index, FP_PRECISION length, int material_index,
+                         int region_id, int cmfd_surface_fwd,
+                         int cmfd_surface_bwd) {
+    _lengths[index] = length;
+    _material_indices[index] = material_index;
+    _region_ids[index] = region_id;
+    _cmfd_surfaces_fwd[index] = cmfd_surface_fwd;
+    _cmfd_surfaces_bwd[index] = cmfd_surface_bwd;
+  }
+
+  /**
+   * @brief Decodes the segments of a Track in a compressed SegmentStore.
+   * @details The segments are written to the beginning of the arrays of a
+   *          SegmentStore buffer allocated for the longest Track.
+   * @param track_uid the UID of the Track of interest
+   * @param buffer the SegmentStore into which the segments are decoded
+   * @return the number of segments on the Track
+   */
+  inline int decodeTrack(int track_uid, SegmentStore* buffer) {
+
+    long start = _track_offsets[track_uid];
+    int num_segments = _track_offsets[track_uid+1] - start;
+    double scale = _length_scales[track_uid];
+    int* escaped_region_ids = &_escaped_region_ids[_escape_offsets[track_uid]];
+    int region_id = 0;
+
+    for (int i=0; i < num_segments; i++) {
+      short delta = _region_id_deltas[start+i];
+      if (delta == REGION_ID_ESCAPE)
+        region_id = *escaped_region_ids++;
+      else
+        region_id += delta;
+
+      buffer->_lengths[i] = scale * _packed_lengths[start+i];
+      buffer->_material_indices[i] = _packed_material_indices[start+i];
+      buffer->_region_ids[i] = region_id;
+      buffer->_cmfd_surfaces_fwd[i] = -1;
+      buffer->_cmfd_surfaces_bwd[i] = -1;
+    }
+
+    /* Scatter the CMFD surfaces of the segments which cross the mesh */
+    for (long c=_crossing_offsets[track_uid];
+         c < _crossing_offsets[track_uid+1]; c++) {
+      int index = _cmfd_crossings[c]._index;
+      buffer->_cmfd_surfaces_fwd[index] = _cmfd_crossings[c]._cmfd_surface_fwd;
+      buffer->_cmfd_surfaces_bwd[index] = _cmfd_crossings[c]._cmfd_surface_bwd;
+    }
+
+    return num_segments;
+  }
+
+  /**
+   * @brief Finds the segments of a Track in the arrays.
+   * @details The segments of a compressed SegmentStore are decoded into the
+   *          beginning of the arrays of a buffer from createTrackBuffer().
+   * @param track_uid the UID of the Track of interest
+   * @param buffer the buffer into which compressed segments are decoded
+   * @param start the index of the Track's first segment in the returned
+   *        SegmentStore
+   * @param end the index one past the Track's last segment in the returned
+   *        SegmentStore
+   * @return the SegmentStore whose arrays hold the Track's segments
+   */
+  inline SegmentStore* getTrackSegments(int track_uid, SegmentStore* buffer,
+                                        long* start, long* end) {
+    if (_compressed) {
+      *start = 0;
+      *end = decodeTrack(track_uid, buffer);
+      return buffer;
+    }
+
+    *start = _track_offsets[track_uid];
+    *end = _track_offsets[track_uid+1];
+    return this;
+  }
+
+  void setMaterials(std::map<int, Material*> materials);
+  void setNumSegments(int track_uid, int num_segments);
+  void allocate();
+  void compress();
+  void updateMaterials(std::map<int, Material*> materials,
+                       Material** region_materials, int num_regions);
+  void scaleLengths(int region_id, double factor, int first_track_uid,
+                    int last_track_uid);
+};
+
+
+#endif /* SEGMENTSTORE_H_ */
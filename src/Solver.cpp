@@ -23,6 +23,7 @@ Solver::Solver(TrackGenerator* track_generator) {
   _tracks = NULL;
   _boundary_flux = NULL;
   _start_flux = NULL;
+  _boundary_flux_offsets = NULL;
 
   _scalar_flux = NULL;
   _old_scalar_flux = NULL;
@@ -39,6 +40,11 @@ Solver::Solver(TrackGenerator* track_generator) {
   _num_iterations = 0;
   setConvergenceThreshold(1E-5);
   _user_fluxes = false;
+  _initial_fluxes = NULL;
+  _num_initial_fluxes = 0;
+  _initial_k_eff = 1.0;
+  _initial_track_fluxes = NULL;
+  _num_initial_track_fluxes = 0;
 
   _timer = new Timer();
 }
@@ -62,6 +68,9 @@ Solver::~Solver() {
   if (_start_flux != NULL)
     delete [] _start_flux;
 
+  if (_boundary_flux_offsets != NULL)
+    delete [] _boundary_flux_offsets;
+
   if (_scalar_flux != NULL && !_user_fluxes)
     delete [] _scalar_flux;
 
@@ -77,6 +86,12 @@ Solver::~Solver() {
   if (_exp_evaluator != NULL)
     delete _exp_evaluator;
 
+  if (_initial_fluxes != NULL)
+    delete [] _initial_fluxes;
+
+  if (_initial_track_fluxes != NULL)
+    delete [] _initial_track_fluxes;
+
   if (_timer != NULL)
     delete _timer;
 }
@@ -197,6 +212,21 @@ bool Solver::isUsingDoublePrecision() {
 }
 
 
+/**
+ * @brief Returns whether the solver stores segment lengths, angular fluxes
+ *        and reduced sources in single precision while computing in double
+ *        floating point precision.
+ * @return true if using mixed precision
+ */
+bool Solver::isUsingMixedPrecision() {
+#ifdef MIXED
+  return true;
+#else
+  return false;
+#endif
+}
+
+
 /**
  * @brief Returns whether the Solver uses linear interpolation to
  *        compute exponentials.
@@ -207,6 +237,16 @@ bool Solver::isUsingExponentialInterpolation() {
 }
 
 
+/**
+ * @brief Returns whether the Solver uses a polynomial approximation to
+ *        compute exponentials.
+ * @return true if using a polynomial approximation to compute exponentials
+ */
+bool Solver::isUsingExponentialPolynomial() {
+  return _exp_evaluator->isUsingPolynomial();
+}
+
+
 /**
  * @brief Returns the source for some energy group for a flat source region
  * @details This is a helper routine used by the openmoc.process module.
@@ -305,8 +345,17 @@ FP_PRECISION Solver::getFlux(int fsr_id, int group) {
  * @param track_id The Track's unique ID
  * @param fwd Whether the direction of the angular flux along the track is
  *        forward (True) or backward (False)
+ * @return a pointer to the incoming angular flux, or NULL if the boundary
+ *         fluxes are stored along the Track cycles and the direction enters
+ *         through a vacuum boundary
  */
-FP_PRECISION* Solver::getBoundaryFlux(int track_id, bool fwd) {
+FP_STORAGE* Solver::getBoundaryFlux(int track_id, bool fwd) {
+
+  if (_boundary_flux_offsets != NULL) {
+    long offset = _boundary_flux_offsets[2*track_id + !fwd];
+    return (offset == -1) ? NULL : &_boundary_flux[offset];
+  }
+
   return &_boundary_flux(track_id, !fwd, 0, 0);
 }
 
@@ -418,6 +467,93 @@ void Solver::setFixedSourceByMaterial(Material* material, int group,
 }
 
 
+/**
+ * @brief Sets an initial guess for the eigenvalue and FSR scalar fluxes with
+ *        which to start the next eigenvalue calculation.
+ * @details The guess is copied in double precision so that a solution from
+ *          a Solver built with any floating point precision may be used to
+ *          start this Solver. For example, a few loosely converged source
+ *          iterations in a single precision build may be continued in the
+ *          openmoc.double module built alongside it:
+ *
+ * @code
+ *          single_solver.computeEigenvalue(max_iters)
+ *          fluxes = single_solver.getFluxes(num_FSRs * num_groups)
+ *          track_fluxes = single_solver.getTrackFluxes(num_track_fluxes)
+ *          double_solver.setInitialGuess(single_solver.getKeff(), fluxes)
+ *          double_solver.setInitialTrackFluxes(track_fluxes)
+ *          double_solver.computeEigenvalue(max_iters)
+ * @endcode
+ *
+ *          The guess is used by each call to computeEigenvalue(...) until
+ *          clearInitialGuess() is called.
+ * @param k_eff the initial guess for the eigenvalue
+ * @param initial_fluxes the FSR scalar fluxes indexed by FSR and group
+ * @param num_fluxes the number of flux values (# FSRs x # groups)
+ */
+void Solver::setInitialGuess(double k_eff, double* initial_fluxes,
+                             int num_fluxes) {
+
+  if (k_eff <= 0.)
+    log_printf(ERROR, "Unable to set an initial eigenvalue guess of %f "
+               "which is not positive", k_eff);
+
+  clearInitialGuess();
+
+  _initial_k_eff = k_eff;
+  _num_initial_fluxes = num_fluxes;
+  _initial_fluxes = new double[num_fluxes];
+  memcpy(_initial_fluxes, initial_fluxes, num_fluxes * sizeof(double));
+}
+
+
+/**
+ * @brief Sets an initial guess for the Track angular fluxes with which to
+ *        start the next eigenvalue calculation.
+ * @details The Track angular fluxes start from zero unless they are given
+ *          here, such as from getTrackFluxes(...) of a Solver with the same
+ *          Tracks. Without them the boundary fluxes of a reflective problem
+ *          are slow to recover and the eigenvalue may converge early to a
+ *          biased value. The guess is only used together with an initial
+ *          guess for the FSR scalar fluxes from setInitialGuess(...).
+ * @param initial_track_fluxes the Track angular fluxes indexed by Track,
+ *        direction, polar angle and group
+ * @param num_track_fluxes the number of angular flux values
+ *        (2 x # Tracks x # polar angles / 2 x # groups)
+ */
+void Solver::setInitialTrackFluxes(double* initial_track_fluxes,
+                                   int num_track_fluxes) {
+
+  if (_initial_track_fluxes != NULL)
+    delete [] _initial_track_fluxes;
+
+  _num_initial_track_fluxes = num_track_fluxes;
+  _initial_track_fluxes = new double[num_track_fluxes];
+  memcpy(_initial_track_fluxes, initial_track_fluxes,
+         num_track_fluxes * sizeof(double));
+}
+
+
+/**
+ * @brief Clears the initial guess such that each eigenvalue calculation
+ *        starts from a flat scalar flux and an eigenvalue of one.
+ */
+void Solver::clearInitialGuess() {
+
+  if (_initial_fluxes != NULL)
+    delete [] _initial_fluxes;
+
+  if (_initial_track_fluxes != NULL)
+    delete [] _initial_track_fluxes;
+
+  _initial_fluxes = NULL;
+  _num_initial_fluxes = 0;
+  _initial_k_eff = 1.0;
+  _initial_track_fluxes = NULL;
+  _num_initial_track_fluxes = 0;
+}
+
+
 /**
  * @brief Set the maximum allowable optical length for a track segment
  * @param max_optical_length The max optical length
@@ -457,6 +593,15 @@ void Solver::useExponentialIntrinsic() {
 }
 
 
+/**
+ * @brief Informs the Solver to use a table-free polynomial approximation
+ *        to compute the exponential in the transport equation.
+ */
+void Solver::useExponentialPolynomial() {
+  _exp_evaluator->usePolynomial();
+}
+
+
 /**
  * @brief Initializes new ExpEvaluator object to compute exponentials.
  */
@@ -476,8 +621,9 @@ void Solver::initializeExpEvaluator() {
 
     /* Initialize exponential interpolation table */
     _exp_evaluator->setMaxOpticalLength(max_tau);
-    _exp_evaluator->initialize();
   }
+
+  _exp_evaluator->initialize();
 }
 
 
@@ -959,7 +1105,7 @@ void Solver::computeEigenvalue(int max_iters, solverMode mode,
   FP_PRECISION residual = 0.;
 
   /* An initial guess for the eigenvalue */
-  _k_eff = 1.0;
+  _k_eff = _initial_k_eff;
 
   /* Initialize data structures */
   initializeFSRs();
@@ -970,10 +1116,15 @@ void Solver::computeEigenvalue(int max_iters, solverMode mode,
   initializeSourceArrays();
   initializeCmfd();
 
-  /* Set scalar flux to unity for each region */
-  flattenFSRFluxes(1.0);
+  /* Set scalar flux to unity or to the initial guess for each region */
+  if (_initial_fluxes != NULL)
+    loadFSRFluxes();
+  else
+    flattenFSRFluxes(1.0);
   storeFSRFluxes();
   zeroTrackFluxes();
+  if (_initial_fluxes != NULL && _initial_track_fluxes != NULL)
+    loadTrackFluxes();
 
   /* Source iteration loop */
   for (int i=0; i < max_iters; i++) {
@@ -985,7 +1136,9 @@ void Solver::computeEigenvalue(int max_iters, solverMode mode,
     /* Solve CMFD diffusion problem and update MOC flux */
     if (_cmfd != NULL && _cmfd->isFluxUpdateOn()) {
       _k_eff = _cmfd->computeKeff(i);
-      _cmfd->updateBoundaryFlux(_tracks, _boundary_flux, _tot_num_tracks);
+      _cmfd->updateBoundaryFlux(_tracks, _track_generator->getSegmentStore(),
+                                _boundary_flux, _tot_num_tracks,
+                                _boundary_flux_offsets);
     }
     else
       computeKeff();
@@ -1043,8 +1196,8 @@ void Solver::printTimerReport() {
   log_printf(RESULT, "%s%1.4E sec", msg_string.c_str(), time_per_iter);
 
   /* Time per segment */
-  int num_segments = _track_generator->getNumSegments();
-  int num_integrations = 2 * _num_polar_2 * _num_groups * num_segments;
+  long num_segments = _track_generator->getNumSegments();
+  long num_integrations = 2L * _num_polar_2 * _num_groups * num_segments;
   double time_per_integration = (time_per_iter / num_integrations);
   msg_string = "Time per segment integration";
   msg_string.resize(REPORT_WIDTH, '.');
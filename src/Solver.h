@@ -137,8 +137,14 @@ protected:
   /** The angular fluxes for each Track for all energy groups, polar angles,
    *  and azimuthal angles. This array stores the boundary fluxes for a
    *  a Track along both "forward" and "reverse" directions. */
-  FP_PRECISION* _boundary_flux;
-  FP_PRECISION* _start_flux;
+  FP_STORAGE* _boundary_flux;
+  FP_STORAGE* _start_flux;
+
+  /** The offset of the incoming angular flux of each Track direction in the
+   *  boundary flux array, or -1 if the direction enters through a vacuum
+   *  boundary, when the boundary fluxes are stored in a single buffer along
+   *  the Track cycles, or NULL for two angular fluxes per Track */
+  long* _boundary_flux_offsets;
 
   /** The scalar flux for each energy group in each FSR */
   FP_PRECISION* _scalar_flux;
@@ -159,7 +165,7 @@ protected:
   std::map< std::pair<Material*, int>, FP_PRECISION > _fix_src_material_map;
 
   /** Ratios of source to total cross-section for each FSR and energy group */
-  FP_PRECISION* _reduced_sources;
+  FP_STORAGE* _reduced_sources;
 
   /** The current iteration's approximation to k-effective */
   FP_PRECISION _k_eff;
@@ -176,6 +182,23 @@ protected:
   /** Indicator of whether the flux array is defined by the user */
   bool _user_fluxes;
 
+  /** An optional initial guess for the FSR scalar fluxes in each energy
+   *  group with which to start an eigenvalue calculation */
+  double* _initial_fluxes;
+
+  /** The number of values in the initial guess for the FSR scalar fluxes */
+  int _num_initial_fluxes;
+
+  /** The initial guess for the eigenvalue */
+  double _initial_k_eff;
+
+  /** An optional initial guess for the Track angular fluxes */
+  double* _initial_track_fluxes;
+
+  /** The number of values in the initial guess for the Track angular
+   *  fluxes */
+  int _num_initial_track_fluxes;
+
   /** A timer to record timing data for a simulation */
   Timer* _timer;
 
@@ -200,12 +223,16 @@ public:
   FP_PRECISION getConvergenceThreshold();
   FP_PRECISION getMaxOpticalLength();
   bool isUsingDoublePrecision();
+  bool isUsingMixedPrecision();
   bool isUsingExponentialInterpolation();
+  bool isUsingExponentialPolynomial();
 
   virtual FP_PRECISION getFSRSource(int fsr_id, int group);
   virtual FP_PRECISION getFlux(int fsr_id, int group);
   virtual void getFluxes(FP_PRECISION* out_fluxes, int num_fluxes) = 0;
-  virtual FP_PRECISION* getBoundaryFlux(int track_id, bool fwd);
+  virtual void getTrackFluxes(double* out_track_fluxes,
+                              int num_track_fluxes) = 0;
+  virtual FP_STORAGE* getBoundaryFlux(int track_id, bool fwd);
 
   virtual void setTrackGenerator(TrackGenerator* track_generator);
   virtual void setConvergenceThreshold(FP_PRECISION threshold);
@@ -214,10 +241,16 @@ public:
   void setFixedSourceByCell(Cell* cell, int group, FP_PRECISION source);
   void setFixedSourceByMaterial(Material* material, int group,
                                 FP_PRECISION source);
+  void setInitialGuess(double k_eff, double* initial_fluxes,
+                       int num_fluxes);
+  void setInitialTrackFluxes(double* initial_track_fluxes,
+                             int num_track_fluxes);
+  void clearInitialGuess();
   void setMaxOpticalLength(FP_PRECISION max_optical_length);
   void setExpPrecision(FP_PRECISION precision);
   void useExponentialInterpolation();
   void useExponentialIntrinsic();
+  void useExponentialPolynomial();
 
   virtual void initializeExpEvaluator();
   virtual void initializeMaterials(solverMode mode=FORWARD);
@@ -252,6 +285,18 @@ public:
    */
   virtual void flattenFSRFluxes(FP_PRECISION value) = 0;
 
+  /**
+   * @brief Set the scalar flux for each FSR and energy group to the initial
+   *        guess given by setInitialGuess(...).
+   */
+  virtual void loadFSRFluxes() = 0;
+
+  /**
+   * @brief Set each Track's boundary fluxes to the initial guess given by
+   *        setInitialTrackFluxes(...).
+   */
+  virtual void loadTrackFluxes() = 0;
+
   /**
    * @brief Stores the current scalar fluxes in the old scalar flux array.
    */
@@ -438,6 +438,21 @@ inline int Plane::intersection(Point* point, double angle, Point* points) {
 }
 
 
+/**
+ * @brief Finds the minimum distance to this Plane.
+ * @details Finds the distance along the trajectory of a LocalCoords to this
+ *          Plane without computing the intersection Point. If the trajectory
+ *          will not intersect the Plane, returns INFINITY.
+ * @param coords a pointer to a localcoords object
+ * @return the minimum distance to the Plane
+ */
+double Plane::getMinDistance(LocalCoords* coords) {
+  double phi = coords->getPhi();
+  return planeDistance(_A, _B, _C, _D, coords->getX(), coords->getY(),
+                       coords->getZ(), cos(phi), sin(phi));
+}
+
+
 /**
  * @brief Converts this Plane's attributes to a character array.
  * @details The character array returned conatins the type of Plane (ie,
@@ -971,6 +986,23 @@ int ZCylinder::intersection(Point* point, double angle, Point* points) {
 }
 
 
+/**
+ * @brief Finds the minimum distance to this ZCylinder.
+ * @details Finds the distance along the trajectory of a LocalCoords to the
+ *          nearest intersection with this ZCylinder without computing the
+ *          intersection Points. If the trajectory will not intersect the
+ *          ZCylinder, returns INFINITY.
+ * @param coords a pointer to a localcoords object
+ * @return the minimum distance to the ZCylinder
+ */
+double ZCylinder::getMinDistance(LocalCoords* coords) {
+  double phi = coords->getPhi();
+  return zcylinderDistance(_center.getX(), _center.getY(), _radius * _radius,
+                           coords->getX(), coords->getY(), cos(phi),
+                           sin(phi));
+}
+
+
 /**
  * @brief Converts this ZCylinder's attributes to a character array.
  * @details The character array returned conatins the type of Plane (ie,
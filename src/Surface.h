@@ -170,7 +170,7 @@ public:
 
   bool isPointOnSurface(Point* point);
   bool isCoordOnSurface(LocalCoords* coord);
-  double getMinDistance(LocalCoords* coords);
+  virtual double getMinDistance(LocalCoords* coords);
 
   /**
    * @brief Converts this Surface's attributes to a character array.
@@ -210,6 +210,9 @@ protected:
   /** The Plane is a friend of class Zcylinder */
   friend class ZCylinder;
 
+  /** The Plane is a friend of class Cell */
+  friend class Cell;
+
 public:
 
   Plane(const double A, const double B, const double C, const double D,
@@ -228,6 +231,7 @@ public:
 
   double evaluate(const Point* point) const;
   int intersection(Point* point, double angle, Point* points);
+  double getMinDistance(LocalCoords* coords);
 
   std::string toString();
 };
@@ -340,6 +344,9 @@ private:
   /** The ZCylinder is a friend of the Plane class */
   friend class Plane;
 
+  /** The ZCylinder is a friend of the Cell class */
+  friend class Cell;
+
 public:
   ZCylinder(const double x, const double y, const double radius,
             const int id=0, const char* name="");
@@ -356,6 +363,7 @@ public:
 
   double evaluate(const Point* point) const;
   int intersection(Point* point, double angle, Point* points);
+  double getMinDistance(LocalCoords* coords);
 
   std::string toString();
 };
@@ -396,4 +404,73 @@ inline double ZCylinder::evaluate(const Point* point) const {
 }
 
 
+/**
+ * @brief Finds the distance from a point along a trajectory in the x-y plane
+ *        to a Plane with the given coefficients.
+ * @param A the coefficient multiplying x in the Plane's equation
+ * @param B the coefficient multiplying y in the Plane's equation
+ * @param C the coefficient multiplying z in the Plane's equation
+ * @param D the constant coefficient in the Plane's equation
+ * @param x the x-coordinate of the point
+ * @param y the y-coordinate of the point
+ * @param z the z-coordinate of the point
+ * @param cos_phi the cosine of the trajectory's angle with the x-axis
+ * @param sin_phi the sine of the trajectory's angle with the x-axis
+ * @return the distance to the Plane, or INFINITY if it is not intersected
+ */
+inline double planeDistance(double A, double B, double C, double D, double x,
+                            double y, double z, double cos_phi,
+                            double sin_phi) {
+
+  /* The trajectory and plane are parallel */
+  double slope = A * cos_phi + B * sin_phi;
+  if (fabs(slope) < 1.e-10)
+    return INFINITY;
+
+  double dist = - (A * x + B * y + C * z + D) / slope;
+  if (dist > 0.)
+    return dist;
+  else
+    return INFINITY;
+}
+
+
+/**
+ * @brief Finds the distance from a point along a trajectory in the x-y plane
+ *        to a ZCylinder with the given center and radius.
+ * @param x0 the x-coordinate of the ZCylinder's center
+ * @param y0 the y-coordinate of the ZCylinder's center
+ * @param radius2 the square of the ZCylinder's radius
+ * @param x the x-coordinate of the point
+ * @param y the y-coordinate of the point
+ * @param cos_phi the cosine of the trajectory's angle with the x-axis
+ * @param sin_phi the sine of the trajectory's angle with the x-axis
+ * @return the distance to the nearest intersection with the ZCylinder, or
+ *         INFINITY if it is not intersected
+ */
+inline double zcylinderDistance(double x0, double y0, double radius2,
+                                double x, double y, double cos_phi,
+                                double sin_phi) {
+
+  /* Solve |p + t u - c|^2 = r^2 for the distance t along the unit vector u */
+  double dx = x - x0;
+  double dy = y - y0;
+  double b = dx * cos_phi + dy * sin_phi;
+  double discr = b * b - (dx * dx + dy * dy - radius2);
+
+  /* There are no intersections */
+  if (discr < 0.)
+    return INFINITY;
+
+  /* Return the nearest intersection ahead of the point */
+  double root = sqrt(discr);
+  if (-b - root > 0.)
+    return -b - root;
+  else if (-b + root > 0.)
+    return -b + root;
+  else
+    return INFINITY;
+}
+
+
 #endif /* SURFACE_H_ */
@@ -25,6 +25,26 @@ TrackGenerator::TrackGenerator(Geometry* geometry, int num_azim,
   _max_optical_length = std::numeric_limits<FP_PRECISION>::max();
   _FSR_volumes = NULL;
   _FSR_locks = NULL;
+  _segment_store = NULL;
+  _segment_compression = false;
+  _segment_memory_budget = 0.;
+  _num_otf_segments = 0;
+  _max_num_segments = 0;
+  _track_scheduling = AZIMUTHAL_SCHEDULING;
+  _schedule_num_threads = 0;
+  _schedule_tracks = NULL;
+  _schedule_offsets = NULL;
+  _num_track_cycles = 0;
+  _track_cycles = NULL;
+  _track_cycle_offsets = NULL;
+  _interface_exits = NULL;
+  _interface_entries = NULL;
+  _interface_offsets = NULL;
+  _angular_decomposed = false;
+  _num_angle_ranks = 1;
+  _angle_rank = 0;
+  _num_modules_x = 0;
+  _num_modules_y = 0;
   _timer = new Timer();
 }
 
@@ -53,11 +73,24 @@ TrackGenerator::~TrackGenerator() {
   if (_FSR_volumes != NULL)
     delete [] _FSR_volumes;
 
+  deleteSegmentStore();
+  deleteTrackSchedule();
+  deleteTrackCycles();
+  deleteInterfaceFluxes();
+
   if (_quadrature != NULL && !_user_quadrature)
     delete _quadrature;
 
   if (_timer != NULL)
     delete _timer;
+
+#ifdef MPIx
+  /* Communicators may not be freed once MPI has been finalized */
+  int finalized;
+  MPI_Finalized(&finalized);
+  if (_angular_decomposed && !finalized)
+    MPI_Comm_free(&_MPI_angles);
+#endif
 }
 
 /**
@@ -96,12 +129,18 @@ Geometry* TrackGenerator::getGeometry() {
 
 /**
  * @brief Return the array of FSR locks for atomic FSR operations.
+ * @details The locks are only created upon the first request following
+ *          Track generation since the TrackGenerator and the lock-free flux
+ *          accumulation schemes in the CPUSolver do not need them.
  * @return an array of FSR locks
  */
 omp_lock_t* TrackGenerator::getFSRLocks() {
-  if (_FSR_locks == NULL)
+  if (!_contains_tracks)
     log_printf(ERROR, "Unable to return the TrackGenerator's FSR locks "
-               "since they have not yet been created");
+               "since Tracks have not yet been generated");
+
+  if (_FSR_locks == NULL)
+    initializeFSRLocks();
 
   return _FSR_locks;
 }
@@ -126,6 +165,22 @@ int TrackGenerator::getNumTracks() {
 }
 
 
+/**
+ * @brief Return the number of Tracks held for a given azimuthal angle.
+ * @details This is the number of Tracks on the x- and y-axes, or zero for
+ *          the azimuthal angles of other ranks with angular decomposition.
+ * @param azim An azimuthal angle index
+ * @return The number of Tracks for the azimuthal angle
+ */
+int TrackGenerator::getNumAzimTracks(int azim) {
+  if (!_contains_tracks)
+    log_printf(ERROR, "Unable to return the number of Tracks for azimuthal "
+               "angle %d since Tracks have not yet been generated.", azim);
+
+  return _num_tracks[azim];
+}
+
+
 /**
  * @brief Return the number of tracks on the x-axis for a given azimuthal angle.
  * @param azim An azimuthal angle index
@@ -156,24 +211,35 @@ int TrackGenerator::getNumY(int azim) {
 }
 
 
+/**
+ * @brief Return the contiguous storage of all Track segments.
+ * @details The SegmentStore is the only storage of the explicit segments.
+ *          It is filled by ray tracing when the Tracks are generated, or from
+ *          the Track file when they are imported.
+ * @return a pointer to the SegmentStore, or NULL if it has not been built
+ */
+SegmentStore* TrackGenerator::getSegmentStore() {
+  return _segment_store;
+}
+
+
 /**
  * @brief Return the total number of Track segments across the Geometry.
  * @return the total number of Track segments
  */
-int TrackGenerator::getNumSegments() {
+long TrackGenerator::getNumSegments() {
   if (!_contains_tracks)
     log_printf(ERROR, "Unable to return the total number of segments since "
                "Tracks have not yet been generated.");
 
-  int num_segments = 0;
+  /* Segments formed on-the-fly are only counted */
+  if (_segment_formation == OTF_2D)
+    return _num_otf_segments;
 
-  for (int i=0; i < _num_azim_2; i++) {
-#pragma omp parallel for reduction(+:num_segments)
-    for (int j=0; j < _num_tracks[i]; j++)
-      num_segments += _tracks[i][j].getNumSegments();
-  }
+  if (_segment_store == NULL)
+    return 0;
 
-  return num_segments;
+  return _segment_store->getNumSegments();
 }
 
 
@@ -284,6 +350,13 @@ void TrackGenerator::calculateFSRVolumes() {
   /* Create volume calculator and calculate new FSR volumes */
   VolumeCalculator volume_calculator(this);
   volume_calculator.execute();
+
+#ifdef MPIx
+  /* Sum the volumes contributed by the azimuthal angles of each rank */
+  if (_angular_decomposed)
+    MPI_Allreduce(MPI_IN_PLACE, _FSR_volumes, num_FSRs, MPI_FP_PRECISION,
+                  MPI_SUM, _MPI_angles);
+#endif
 }
 
 
@@ -304,6 +377,9 @@ void TrackGenerator::resetFSRVolumes() {
 
 /**
  * @brief Computes and returns the volume of an FSR.
+ * @details With angular decomposition the volume is summed over the
+ *          azimuthal angles of all ranks, so every rank must call this
+ *          routine for the same FSR.
  * @param fsr_id the ID for the FSR of interest
  * @return the FSR volume
  */
@@ -317,23 +393,47 @@ FP_PRECISION TrackGenerator::getFSRVolume(int fsr_id) {
     log_printf(ERROR, "Unable to get the volume for FSR %d since the FSR IDs "
                "lie in the range (0, %d)", fsr_id, _geometry->getNumFSRs());
 
-  segment* curr_segment;
+  else if (_segment_formation == OTF_2D)
+    log_printf(ERROR, "Unable to get the volume for FSR %d since segments "
+               "are formed on-the-fly", fsr_id);
+
   FP_PRECISION volume = 0;
 
   /* Calculate the FSR's "volume" by accumulating the total length of *
    * all Track segments multipled by the Track "widths" for the FSR.  */
-  for (int i=0; i < _num_azim_2; i++) {
-#pragma omp parallel for reduction(+:volume) private(curr_segment)
-    for (int j=0; j < _num_tracks[i]; j++) {
-      for (int s=0; s < _tracks[i][j].getNumSegments(); s++) {
-        curr_segment = _tracks[i][j].getSegment(s);
-        if (curr_segment->_region_id == fsr_id)
-          volume += curr_segment->_length * _quadrature->getAzimWeight(i)
-            * _quadrature->getAzimSpacing(i);
+#pragma omp parallel
+  {
+    SegmentStore* buffer = _segment_store->createTrackBuffer();
+
+    for (int i=0; i < _num_azim_2; i++) {
+#pragma omp for reduction(+:volume)
+      for (int j=0; j < _num_tracks[i]; j++) {
+
+        long start, end;
+        SegmentStore* store = _segment_store->getTrackSegments
+            (_tracks[i][j].getUid(), buffer, &start, &end);
+        FP_STORAGE* lengths = store->getLengths();
+        int* region_ids = store->getRegionIds();
+
+        for (long s=start; s < end; s++) {
+          if (region_ids[s] == fsr_id)
+            volume += lengths[s] * _quadrature->getAzimWeight(i)
+              * _quadrature->getAzimSpacing(i);
+        }
       }
     }
+
+    if (buffer != NULL)
+      delete buffer;
   }
 
+#ifdef MPIx
+  /* Sum the volume contributed by the azimuthal angles of each rank */
+  if (_angular_decomposed)
+    MPI_Allreduce(MPI_IN_PLACE, &volume, 1, MPI_FP_PRECISION, MPI_SUM,
+                  _MPI_angles);
+#endif
+
   return volume;
 }
 
@@ -343,38 +443,30 @@ FP_PRECISION TrackGenerator::getFSRVolume(int fsr_id) {
  *        in the Geomtry.
  * @details The maximum optical length is recomputed, updated, and returned.
  *          This value determines when segments must be split during ray
- *          tracing.
+ *          tracing. Segments formed on-the-fly are ray traced to find it.
  * @return The maximum optical length of any segment in the Geometry
  */
 FP_PRECISION TrackGenerator::getMaxOpticalLength() {
 
   FP_PRECISION max_optical_length = 0.;
 
-#pragma omp parallel
-  {
-    segment* curr_segment;
-    FP_PRECISION length;
-    Material* material;
-    FP_PRECISION* sigma_t;
+  if (_segment_formation == OTF_2D)
+    max_optical_length = countSegments();
 
-    /* Iterate over all tracks, segments, groups to find max optical length */
-    for (int i=0; i < _num_azim_2; i++) {
-#pragma omp for reduction(max:max_optical_length)
-      for (int j=0; j < _num_tracks[i]; j++) {
-        for (int s=0; s < _tracks[i][j].getNumSegments(); s++) {
-          curr_segment = _tracks[i][j].getSegment(s);
-          length = curr_segment->_length;
-          material = curr_segment->_material;
-          sigma_t = material->getSigmaT();
-
-          for (int e=0; e < material->getNumEnergyGroups(); e++)
-            max_optical_length = std::max(max_optical_length,
-                                          length*sigma_t[e]);
-        }
-      }
-    }
+  /* Traverse the stored segments with CounterKernels */
+  else {
+    SegmentCounter counter(this);
+    counter.execute();
+    max_optical_length = counter.getMaxOpticalLength();
   }
 
+#ifdef MPIx
+  /* Find the maximum over the azimuthal angles of all ranks */
+  if (_angular_decomposed)
+    MPI_Allreduce(MPI_IN_PLACE, &max_optical_length, 1, MPI_FP_PRECISION,
+                  MPI_MAX, _MPI_angles);
+#endif
+
   /* Update maximum optical path length */
   _max_optical_length = max_optical_length;
 
@@ -392,6 +484,221 @@ FP_PRECISION TrackGenerator::retrieveMaxOpticalLength() {
 }
 
 
+/**
+ * @brief Returns the memory budget for explicitly stored segments.
+ * @return the segment memory budget (MB), or zero if there is no budget
+ */
+double TrackGenerator::getSegmentMemoryBudget() {
+  return _segment_memory_budget;
+}
+
+
+/**
+ * @brief Returns whether the SegmentStore is compressed once it is filled.
+ * @return whether the segments are stored compressed
+ */
+bool TrackGenerator::isUsingSegmentCompression() {
+  return _segment_compression;
+}
+
+
+/**
+ * @brief Returns the maximum number of segments on any Track.
+ * @details The maximum is found when the SegmentStore is built or, for
+ *          on-the-fly ray tracing, when the segments are counted.
+ * @return the maximum number of segments on a Track
+ */
+int TrackGenerator::getMaxNumSegments() {
+  return _max_num_segments;
+}
+
+
+/**
+ * @brief Returns the schedule by which the Tracks are distributed among
+ *        threads.
+ * @return the Track scheduling
+ */
+trackSchedulingType TrackGenerator::getTrackScheduling() {
+  return _track_scheduling;
+}
+
+
+/**
+ * @brief Returns the number of threads for which the Track schedule was
+ *        built.
+ * @return the number of threads, or zero if the schedule has not been built
+ */
+int TrackGenerator::getTrackScheduleNumThreads() {
+  return _schedule_num_threads;
+}
+
+
+/**
+ * @brief Returns the UIDs of the Tracks assigned to each thread.
+ * @details The Tracks assigned to thread t are those between
+ *          getTrackScheduleOffsets()[t] and getTrackScheduleOffsets()[t+1].
+ * @return an array of Track UIDs grouped by thread
+ */
+int* TrackGenerator::getTrackSchedule() {
+
+  if (_schedule_tracks == NULL)
+    log_printf(ERROR, "Unable to return the Track schedule since it has "
+               "not yet been initialized");
+
+  return _schedule_tracks;
+}
+
+
+/**
+ * @brief Returns the offset of each thread's Tracks in the Track schedule.
+ * @return an array of the offsets with the number of Tracks in the last entry
+ */
+int* TrackGenerator::getTrackScheduleOffsets() {
+
+  if (_schedule_offsets == NULL)
+    log_printf(ERROR, "Unable to return the Track schedule offsets since "
+               "the schedule has not yet been initialized");
+
+  return _schedule_offsets;
+}
+
+
+/**
+ * @brief Returns the number of Track cycles.
+ * @return the number of Track cycles, or zero if they have not been built
+ */
+int TrackGenerator::getNumTrackCycles() {
+  return _num_track_cycles;
+}
+
+
+/**
+ * @brief Returns the Track directions of each Track cycle.
+ * @details The Track directions of cycle c are those between
+ *          getTrackCycleOffsets()[c] and getTrackCycleOffsets()[c+1], each
+ *          encoded as twice the Track's UID plus one for the reverse
+ *          direction.
+ * @return an array of the encoded Track directions grouped by cycle
+ */
+int* TrackGenerator::getTrackCycles() {
+
+  if (_track_cycles == NULL)
+    log_printf(ERROR, "Unable to return the Track cycles since they have "
+               "not yet been initialized");
+
+  return _track_cycles;
+}
+
+
+/**
+ * @brief Returns the offset of each Track cycle in the Track cycles array.
+ * @return an array of the offsets with the number of Track directions in the
+ *         last entry
+ */
+int* TrackGenerator::getTrackCycleOffsets() {
+
+  if (_track_cycle_offsets == NULL)
+    log_printf(ERROR, "Unable to return the Track cycle offsets since the "
+               "Track cycles have not yet been initialized");
+
+  return _track_cycle_offsets;
+}
+
+
+/**
+ * @brief Returns the boundary angular fluxes holding the outgoing flux of
+ *        each Track direction leaving through a face of this rank's spatial
+ *        domain.
+ * @details The interface exits are grouped by face as given by the interface
+ *          offsets and are only sent to neighbors across INTERFACE faces.
+ *          Each is encoded as twice the UID of the Track whose boundary flux
+ *          holds the outgoing flux plus one for its reverse direction.
+ * @return the interface exits, or NULL if the Geometry is not decomposed
+ */
+int* TrackGenerator::getInterfaceExits() {
+  return _interface_exits;
+}
+
+
+/**
+ * @brief Returns the boundary angular fluxes receiving the incoming flux for
+ *        each of the interface exits.
+ * @details The angular flux leaving a domain through one face enters the
+ *          neighboring domain through its opposite face. Since all domains
+ *          share the same Track laydown, the neighbor's flux is received by
+ *          the Track direction to which the exit's flux would be transferred
+ *          with PERIODIC boundary conditions.
+ * @return the interface entries, or NULL if the Geometry is not decomposed
+ */
+int* TrackGenerator::getInterfaceEntries() {
+  return _interface_entries;
+}
+
+
+/**
+ * @brief Returns the offset of each face's interface exits and entries.
+ * @details The offsets are indexed by surface (SURFACE_X_MIN, SURFACE_Y_MIN,
+ *          SURFACE_X_MAX and SURFACE_Y_MAX) with the total number of
+ *          interface exits in the last entry.
+ * @return the interface offsets, or NULL if the Geometry is not decomposed
+ */
+int* TrackGenerator::getInterfaceOffsets() {
+  return _interface_offsets;
+}
+
+
+/**
+ * @brief Returns whether the azimuthal angles are decomposed across MPI
+ *        ranks.
+ * @return true if the azimuthal angles are decomposed, false otherwise
+ */
+bool TrackGenerator::isAngularDecomposed() {
+  return _angular_decomposed;
+}
+
+
+/**
+ * @brief Returns whether this rank holds the Tracks of an azimuthal angle.
+ * @details With angular decomposition, each pair of complementary azimuthal
+ *          angles, which are coupled by reflective boundary conditions, is
+ *          assigned to the ranks in turn. Otherwise all azimuthal angles are
+ *          held.
+ * @param azim An azimuthal angle index
+ * @return whether the Tracks of the azimuthal angle are held by this rank
+ */
+bool TrackGenerator::containsAzim(int azim) {
+  int azim_pair = std::min(azim, _num_azim_2 - azim - 1);
+  return (azim_pair % _num_angle_ranks == _angle_rank);
+}
+
+
+/**
+ * @brief Returns whether the Tracks are laid down cyclically across modules
+ *        with segments reused across repeated Lattice cells.
+ * @return true if modular ray tracing is used, false otherwise
+ */
+bool TrackGenerator::isModularRayTracing() {
+  return (_num_modules_x > 0);
+}
+
+
+#ifdef MPIx
+/**
+ * @brief Returns the MPI communicator of the ranks decomposing the
+ *        azimuthal angles.
+ * @return the MPI communicator
+ */
+MPI_Comm TrackGenerator::getMPIAngles() {
+
+  if (!_angular_decomposed)
+    log_printf(ERROR, "Unable to return the MPI communicator since the "
+               "azimuthal angles are not decomposed across ranks");
+
+  return _MPI_angles;
+}
+#endif
+
+
 /**
  * @brief Sets the number of shared memory OpenMP threads to use (>0).
  * @param num_threads the number of threads
@@ -428,6 +735,167 @@ void TrackGenerator::setTracksFilenameSuffix(char* suffix) {
 }
 
 
+/**
+ * @brief Sets the type of ray tracing used for segment formation.
+ * @details Explicit segments are formed once when the Tracks are generated
+ *          and stored for all transport sweeps. On-the-fly segments are
+ *          instead formed by ray tracing each Track during each transport
+ *          sweep, trading computation for the memory to store the segments.
+ *          This must be set before the Tracks are generated.
+ * @param segmentation_type the segmentation type (EXPLICIT_2D or OTF_2D)
+ */
+void TrackGenerator::setSegmentFormation(segmentationType segmentation_type) {
+
+  if (segmentation_type != EXPLICIT_2D && segmentation_type != OTF_2D)
+    log_printf(ERROR, "Unable to set the segment formation to %d since only "
+               "EXPLICIT_2D and OTF_2D segmentation are supported",
+               segmentation_type);
+
+  _segment_formation = segmentation_type;
+  resetStatus();
+}
+
+
+/**
+ * @brief Sets the schedule by which the Tracks are distributed among threads.
+ * @details With AZIMUTHAL_SCHEDULING (the default), the Tracks of each
+ *          azimuthal angle are divided evenly by count among the threads
+ *          with a barrier between azimuthal angles. STATIC_SCHEDULING and
+ *          WORK_STEALING_SCHEDULING instead distribute the Tracks of all
+ *          azimuthal angles weighted by their number of segments, without
+ *          a barrier until the end of the traversal.
+ * @param track_scheduling the Track scheduling (AZIMUTHAL_SCHEDULING,
+ *        STATIC_SCHEDULING or WORK_STEALING_SCHEDULING)
+ */
+void TrackGenerator::setTrackScheduling(trackSchedulingType track_scheduling) {
+
+  if (track_scheduling != AZIMUTHAL_SCHEDULING &&
+      track_scheduling != STATIC_SCHEDULING &&
+      track_scheduling != WORK_STEALING_SCHEDULING)
+    log_printf(ERROR, "Unable to set the Track scheduling to %d since only "
+               "AZIMUTHAL_SCHEDULING, STATIC_SCHEDULING and "
+               "WORK_STEALING_SCHEDULING are supported", track_scheduling);
+
+  _track_scheduling = track_scheduling;
+}
+
+
+/**
+ * @brief Sets the number of modules along each axis for modular ray tracing.
+ * @details The Geometry is divided into a uniform grid of modules, such as
+ *          the cells of its pin or assembly Lattice. The number of Tracks
+ *          along each axis is rounded up to a multiple of the number of
+ *          modules such that the Tracks are laid down cyclically in every
+ *          module. Each Track then enters each module at one of the same few
+ *          local points, and the segments formed across each lowest level
+ *          Lattice cell are ray traced once per Universe, entry point and
+ *          azimuthal angle and replayed for every other instance. Modular ray
+ *          tracing is not used with CMFD acceleration. Setting zero modules
+ *          disables modular ray tracing.
+ *
+ *          Small modules alias with coarse azimuthal quadratures. With pin
+ *          cell modules, the Tracks cross every pin at the same few offsets,
+ *          and on the C5G7 benchmark with 4 azimuthal angles k_eff is about
+ *          800 pcm off. Use assembly modules or a finer azimuthal quadrature
+ *          such that the Tracks sample each module densely:
+ *
+ * @code
+ *          track_generator.setModularRayTracing(3, 3)
+ * @endcode
+ *
+ * @param num_modules_x the number of modules along the x-axis
+ * @param num_modules_y the number of modules along the y-axis
+ */
+void TrackGenerator::setModularRayTracing(int num_modules_x,
+                                          int num_modules_y) {
+
+  if (num_modules_x < 0 || num_modules_y < 0)
+    log_printf(ERROR, "Unable to set %d x %d modules for modular ray tracing "
+               "since the number of modules must be non-negative",
+               num_modules_x, num_modules_y);
+
+  if ((num_modules_x == 0) != (num_modules_y == 0))
+    log_printf(ERROR, "Unable to set %d x %d modules for modular ray tracing "
+               "since modules are required along both axes",
+               num_modules_x, num_modules_y);
+
+  _num_modules_x = num_modules_x;
+  _num_modules_y = num_modules_y;
+  resetStatus();
+}
+
+
+#ifdef MPIx
+/**
+ * @brief Decomposes the azimuthal angles across the MPI ranks.
+ * @details The pairs of complementary azimuthal angles, which are coupled
+ *          by reflective boundary conditions, are assigned to the ranks in
+ *          MPI_COMM_WORLD in turn. Each rank generates and sweeps only the
+ *          Tracks and segments of its own azimuthal angles, while holding
+ *          the scalar fluxes of all FSRs which are summed across ranks after
+ *          each transport sweep. The FSRs are numbered consistently across
+ *          ranks once the Tracks are segmentized, and Track files are not
+ *          used. This method must be called before Tracks are generated:
+ *
+ * @code
+ *          track_generator.setAngularDecomposition()
+ * @endcode
+ */
+void TrackGenerator::setAngularDecomposition() {
+
+  if (_angular_decomposed)
+    MPI_Comm_free(&_MPI_angles);
+
+  MPI_Comm_dup(MPI_COMM_WORLD, &_MPI_angles);
+  MPI_Comm_size(_MPI_angles, &_num_angle_ranks);
+  MPI_Comm_rank(_MPI_angles, &_angle_rank);
+  _angular_decomposed = true;
+
+  /* Only report log messages from the first rank */
+  log_set_ranks(_MPI_angles);
+}
+#endif
+
+
+/**
+ * @brief Sets a memory budget for explicitly stored segments.
+ * @details If the estimated memory to store all segments explicitly exceeds
+ *          the budget when the Tracks are generated, segments are formed
+ *          on-the-fly during each transport sweep instead.
+ * @param megabytes the segment memory budget (MB), or zero for no budget
+ */
+void TrackGenerator::setSegmentMemoryBudget(double megabytes) {
+
+  if (megabytes < 0.)
+    log_printf(ERROR, "Unable to set a negative segment memory budget of "
+               "%f MB", megabytes);
+
+  _segment_memory_budget = megabytes;
+  resetStatus();
+}
+
+
+/**
+ * @brief Sets whether the SegmentStore streamed by the Track traversals is
+ *        compressed.
+ * @details A compressed SegmentStore quantizes the segment lengths and
+ *          stores the Material indices and FSR IDs in 16 bits, with the CMFD
+ *          surfaces and the FSR IDs which do not fit in side tables. Each
+ *          Track's segments are decoded into a thread buffer before they are
+ *          traversed. The bytes per segment before and after compression are
+ *          reported when the SegmentStore is built.
+ * @param compress whether to compress the SegmentStore
+ */
+void TrackGenerator::setSegmentCompression(bool compress) {
+
+  _segment_compression = compress;
+
+  /* Rebuild the SegmentStore which owns the segments with the new setting */
+  if (_segment_store != NULL && _segment_store->isCompressed() != compress)
+    initializeSegmentStore();
+}
+
+
 /**
  * @brief Set the number of azimuthal angles in \f$ [0, 2\pi] \f$.
  * @param num_azim the number of azimuthal angles in \f$ 2\pi \f$
@@ -572,16 +1040,19 @@ void TrackGenerator::retrieveTrackCoords(double* coords, int length_coords) {
  */
 void TrackGenerator::retrieveSegmentCoords(double* coords, int length_coords) {
 
+  if (_segment_formation == OTF_2D)
+    log_printf(ERROR, "Unable to retrieve segment coordinates since segments "
+               "are formed on-the-fly");
+
   if (length_coords != NUM_VALUES_PER_RETRIEVED_SEGMENT*getNumSegments())
     log_printf(ERROR, "Unable to retrieve the Track segment coordinates since "
-               "the TrackGenerator contains %d segments with %d values per "
+               "the TrackGenerator contains %ld segments with %d values per "
                "segment but an array of length %d was input", getNumSegments(),
                NUM_VALUES_PER_RETRIEVED_SEGMENT, length_coords);
 
-  segment* curr_segment = NULL;
   double x0, x1, y0, y1, z;
   double phi;
-  segment* segments;
+  SegmentStore* buffer = _segment_store->createTrackBuffer();
 
   int counter = 0;
 
@@ -595,19 +1066,22 @@ void TrackGenerator::retrieveSegmentCoords(double* coords, int length_coords) {
       z = _tracks[i][j].getStart()->getZ();
       phi = _tracks[i][j].getPhi();
 
-      segments = _tracks[i][j].getSegments();
+      long start, end;
+      SegmentStore* store = _segment_store->getTrackSegments
+          (_tracks[i][j].getUid(), buffer, &start, &end);
+      FP_STORAGE* lengths = store->getLengths();
+      int* region_ids = store->getRegionIds();
 
-      for (int s=0; s < _tracks[i][j].getNumSegments(); s++) {
-        curr_segment = &segments[s];
+      for (long s=start; s < end; s++) {
 
-        coords[counter] = curr_segment->_region_id;
+        coords[counter] = region_ids[s];
 
         coords[counter+1] = x0;
         coords[counter+2] = y0;
         coords[counter+3] = z;
 
-        x1 = x0 + cos(phi) * curr_segment->_length;
-        y1 = y0 + sin(phi) * curr_segment->_length;
+        x1 = x0 + cos(phi) * lengths[s];
+        y1 = y0 + sin(phi) * lengths[s];
 
         coords[counter+4] = x1;
         coords[counter+5] = y1;
@@ -621,6 +1095,9 @@ void TrackGenerator::retrieveSegmentCoords(double* coords, int length_coords) {
     }
   }
 
+  if (buffer != NULL)
+    delete buffer;
+
     return;
 }
 
@@ -640,6 +1117,24 @@ void TrackGenerator::generateTracks(bool store, bool neighbor_cells) {
     log_printf(ERROR, "Unable to generate Tracks since no Geometry "
                "has been set for the TrackGenerator");
 
+  if (_segment_formation == OTF_2D && _geometry->getCmfd() != NULL)
+    log_printf(ERROR, "Unable to form segments on-the-fly with CMFD "
+               "acceleration which requires explicit segments");
+
+  if (_angular_decomposed && _geometry->isDomainDecomposed())
+    log_printf(ERROR, "Unable to generate Tracks for azimuthal angles "
+               "decomposed across ranks in a Geometry decomposed into "
+               "spatial domains");
+
+  if (isModularRayTracing() && _geometry->getCmfd() != NULL)
+    log_printf(ERROR, "Unable to use modular ray tracing with CMFD "
+               "acceleration which requires the CMFD surfaces of each "
+               "segment");
+
+  if (_angular_decomposed && _num_azim_2/2 < _num_angle_ranks)
+    log_printf(ERROR, "Unable to decompose %d pairs of azimuthal angles "
+               "across %d ranks", _num_azim_2/2, _num_angle_ranks);
+
   /* Check for valid quadrature */
   if (_quadrature != NULL) {
     if (_quadrature->getNumAzimAngles() != 2*_num_azim_2) {
@@ -681,6 +1176,12 @@ void TrackGenerator::generateTracks(bool store, bool neighbor_cells) {
     delete [] _tracks;
   }
 
+  /* Delete the SegmentStore, schedule and cycles for previously generated
+   * Tracks */
+  deleteSegmentStore();
+  deleteTrackSchedule();
+  deleteTrackCycles();
+
   /* Initialize the CMFD object */
   if (_geometry->getCmfd() != NULL)
     _geometry->initializeCmfd();
@@ -717,8 +1218,9 @@ void TrackGenerator::generateTracks(bool store, bool neighbor_cells) {
     try {
       initializeTracks();
       recalibrateTracksToOrigin();
+      initializeTrackUids();
       segmentize();
-      if (store)
+      if (store && _segment_formation == EXPLICIT_2D && !_angular_decomposed)
 	dumpTracksToFile();
     }
     catch (std::exception &e) {
@@ -727,6 +1229,8 @@ void TrackGenerator::generateTracks(bool store, bool neighbor_cells) {
   }
   else {
 
+    initializeTrackUids();
+
     /* Determine azimuthal spacings */
     for (int i = 0; i < _num_azim_2/2; i++) {
 
@@ -742,11 +1246,17 @@ void TrackGenerator::generateTracks(bool store, bool neighbor_cells) {
   /* Precompute quadrature weights */
   _quadrature->precomputeWeights(false);
 
-  /* Initialize the track boundary conditions and set the track UIDs */
+  /* Initialize the track boundary conditions */
   initializeBoundaryConditions();
   initializeTrackCycleIndices(PERIODIC);
-  initializeTrackUids();
-  initializeFSRLocks();
+  initializeInterfaceFluxes();
+
+  /* Delete FSR locks from a previous Geometry, if they exist */
+  if (_FSR_locks != NULL) {
+    delete [] _FSR_locks;
+    _FSR_locks = NULL;
+  }
+
   initializeVolumes();
 
   _timer->stopTimer();
@@ -819,12 +1329,27 @@ void TrackGenerator::initializeTrackFileDirectory() {
                   << _z_coord << "_" << _tracks_filename_suffix;
   }
 
+  /* Each spatial domain stores the Tracks of its own domain */
+  if (_geometry->isDomainDecomposed())
+    test_filename << "_" << _geometry->getNumXDomains() << "x"
+                  << _geometry->getNumYDomains() << "_domains_"
+                  << _geometry->getDomainIndexX() << "_"
+                  << _geometry->getDomainIndexY();
+
+  /* Modular ray tracing lays down a different number of Tracks */
+  if (isModularRayTracing())
+    test_filename << "_" << _num_modules_x << "x" << _num_modules_y
+                  << "_modules";
+
   test_filename << ".data";
   _tracks_filename = test_filename.str();
 
   /* Check to see if a Track file exists for this geometry, number of azimuthal
-   * angles, and track spacing, and if so, import the ray tracing data */
-  if ((!stat(_tracks_filename.c_str(), &buffer))) {
+   * angles, and track spacing, and if so, import the ray tracing data. Track
+   * files are not used when segments are formed on-the-fly, nor when the
+   * FSRs are numbered across the ranks decomposing the azimuthal angles. */
+  if (_segment_formation == EXPLICIT_2D && !_angular_decomposed &&
+      (!stat(_tracks_filename.c_str(), &buffer))) {
     if (readTracksFromFile()) {
       _use_input_file = true;
       _contains_tracks = true;
@@ -874,8 +1399,17 @@ void TrackGenerator::initializeTracks() {
     _num_x[i] = (int) (fabs(width_x / _azim_spacing * sin(phi))) + 1;
     _num_y[i] = (int) (fabs(width_y / _azim_spacing * cos(phi))) + 1;
 
-    /* Total number of Tracks */
-    _num_tracks[i] = _num_x[i] + _num_y[i];
+    /* Lay down the same number of Tracks across each module */
+    if (isModularRayTracing()) {
+      _num_x[i] = _num_modules_x *
+          ((_num_x[i] + _num_modules_x - 1) / _num_modules_x);
+      _num_y[i] = _num_modules_y *
+          ((_num_y[i] + _num_modules_y - 1) / _num_modules_y);
+    }
+
+    /* Total number of Tracks, which are only held for this rank's azimuthal
+     * angles with angular decomposition */
+    _num_tracks[i] = containsAzim(i) ? _num_x[i] + _num_y[i] : 0;
 
     /* Effective/actual angle (not the angle we desire, but close) */
     phi = atan((width_y * _num_x[i]) / (width_x * _num_y[i]));
@@ -906,6 +1440,8 @@ void TrackGenerator::initializeTracks() {
 
     /* Tracks for azimuthal angle i */
     _tracks[i] = new Track[_num_tracks[i]];
+    if (_num_tracks[i] == 0)
+      continue;
 
     /* Compute start points for Tracks starting on x-axis */
     for (int j = 0; j < _num_x[i]; j++) {
@@ -1108,7 +1644,10 @@ void TrackGenerator::initializeTrackCycleIndices(boundaryType bc) {
 void TrackGenerator::initializeTrackUids() {
 
   /* Allocate memory for the 1D tracks array */
-  _tracks_array = new Track*[getNumTracks()];
+  int num_tracks = 0;
+  for (int a=0; a < _num_azim_2; a++)
+    num_tracks += _num_tracks[a];
+  _tracks_array = new Track*[num_tracks];
 
   /* Loop over all tracks and assign UIDs */
   int uid = 0;
@@ -1308,34 +1847,156 @@ void TrackGenerator::initializeBoundaryConditions() {
 }
 
 
+/**
+ * @brief Estimates the memory required to store all segments explicitly.
+ * @details A sample of the Tracks for each azimuthal angle is ray traced
+ *          with CounterKernels and the number of segments is extrapolated to
+ *          all Tracks. Each explicit segment is only stored in the
+ *          SegmentStore streamed by the transport sweep.
+ * @return the estimated memory for explicit segments (MB)
+ */
+double TrackGenerator::estimateSegmentMemory() {
+
+  double num_segments = 0.;
+
+  for (int i=0; i < _num_azim_2; i++) {
+
+    if (_num_tracks[i] == 0)
+      continue;
+
+    long num_sampled_segments = 0;
+    int num_sampled_tracks = 0;
+
+#pragma omp parallel for reduction(+:num_sampled_segments,num_sampled_tracks)
+    for (int j=0; j < _num_tracks[i]; j+=SEGMENT_MEMORY_SAMPLE_STRIDE) {
+      CounterKernel kernel(this);
+      _geometry->segmentize(&_tracks[i][j], &kernel);
+      num_sampled_segments += kernel.getCount();
+      num_sampled_tracks++;
+    }
+
+    num_segments += double(num_sampled_segments) * _num_tracks[i]
+        / num_sampled_tracks;
+  }
+
+  double bytes_per_segment = sizeof(FP_STORAGE) + 4 * sizeof(int);
+  if (_segment_compression)
+    bytes_per_segment = 2 * sizeof(unsigned short) + sizeof(short);
+
+  return num_segments * bytes_per_segment / 1.E6;
+}
+
+
+/**
+ * @brief Counts the segments formed by on-the-fly ray tracing.
+ * @details All Tracks are ray traced with CounterKernels to find the total
+ *          and maximum number of segments on each Track, accounting for
+ *          segments split by the maximum optical path length.
+ * @return the maximum optical path length of any segment before splitting
+ */
+FP_PRECISION TrackGenerator::countSegments() {
+
+  SegmentCounter counter(this);
+  counter.execute();
+
+  _num_otf_segments = counter.getNumSegments();
+  _max_num_segments = counter.getMaxNumSegments();
+
+  return counter.getMaxOpticalLength();
+}
+
+
 /**
  * @brief Generate segments for each Track across the Geometry.
+ * @details If the estimated memory to store the segments explicitly exceeds
+ *          the segment memory budget, segments are formed on-the-fly instead.
+ *          On-the-fly segments are counted, which also discovers the FSRs,
+ *          but are not stored. Explicit segments are ray traced directly into
+ *          the SegmentStore by initializeSegmentStore().
  */
 void TrackGenerator::segmentize() {
 
   log_printf(NORMAL, "Ray tracing for track segmentation...");
 
-  /* This section loops over all Track and segmentizes each one if the
-   * Tracks were not read in from an input file */
-  if (!_use_input_file) {
+  _geometry->resetFSRLookupCounts();
 
-    /* Loop over all Tracks */
-    for (int i=0; i < _num_azim_2; i++) {
-#pragma omp parallel for
-      for (int j=0; j < _num_tracks[i]; j++) {
-        _geometry->segmentize(&_tracks[i][j]);
+  /* Reuse the segments across repeated Lattice cells for modular ray
+   * tracing */
+  if (isModularRayTracing())
+    _geometry->initializeSegmentTemplates();
+  else
+    _geometry->clearSegmentTemplates();
+
+  /* Form segments on-the-fly if they would exceed the memory budget */
+  if (_segment_formation == EXPLICIT_2D && _segment_memory_budget > 0.) {
+
+    double segment_memory = estimateSegmentMemory();
+
+    if (segment_memory > _segment_memory_budget) {
+      if (_geometry->getCmfd() != NULL)
+        log_printf(WARNING, "Explicit segments require an estimated %.2f "
+                   "MB which exceeds the %.2f MB budget, but are stored "
+                   "since CMFD requires explicit segments", segment_memory,
+                   _segment_memory_budget);
+      else {
+        log_printf(NORMAL, "Explicit segments require an estimated %.2f MB "
+                   "which exceeds the %.2f MB budget, forming segments "
+                   "on-the-fly", segment_memory, _segment_memory_budget);
+        _segment_formation = OTF_2D;
       }
     }
   }
 
-  _geometry->initializeFSRVectors();
-
   _contains_tracks = true;
 
+  /* Ray trace all Tracks into the SegmentStore */
+  if (_segment_formation == EXPLICIT_2D)
+    initializeSegmentStore();
+
+  /* Ray trace all Tracks to count the segments formed on-the-fly */
+  else {
+    countSegments();
+
+#ifdef MPIx
+    /* Merge the FSRs discovered by the ranks sharing the azimuthal angles */
+    if (_angular_decomposed)
+      synchronizeFSRs();
+#endif
+  }
+
+  if (isModularRayTracing())
+    log_printf(INFO, "Formed %d segment templates across repeated lattice "
+               "cells", _geometry->getNumSegmentTemplates());
+
+  /* Report how many FSR lookups found an FSR already in the map */
+  long num_lookups = _geometry->getNumFSRLookups();
+  if (num_lookups > 0)
+    log_printf(INFO, "Found %.1f%% of %ld FSR lookups already in the map of "
+               "FSR keys", 100. * _geometry->getNumFSRLookupHits() /
+               num_lookups, num_lookups);
+
+  _geometry->initializeFSRVectors();
+
   return;
 }
 
 
+#ifdef MPIx
+/**
+ * @brief Synchronizes the FSRs across the ranks decomposing the azimuthal
+ *        angles.
+ * @details Each rank only ray traces the Tracks of its own azimuthal angles
+ *          and therefore discovers a subset of the FSRs. The Geometry merges
+ *          the FSRs from all ranks such that each rank holds all FSRs with
+ *          the same FSR IDs. This must be called after the FSRs have been
+ *          discovered and before any segments are stored with their FSR IDs.
+ */
+void TrackGenerator::synchronizeFSRs() {
+  _geometry->synchronizeFSRs(_MPI_angles);
+}
+#endif
+
+
 /**
  * @brief Writes all Track and segment data to a "*.tracks" binary file.
  * @details Storing Tracks in a binary file saves time by eliminating ray
@@ -1362,6 +2023,12 @@ void TrackGenerator::dumpTracksToFile() {
   fwrite(&string_length, sizeof(int), 1, out);
   fwrite(geometry_to_string.c_str(), sizeof(char)*string_length, 1, out);
 
+  /* Write the Track file format, which identifies the layout of the data */
+  int magic = TRACK_FILE_MAGIC;
+  int version = TRACK_FILE_VERSION;
+  fwrite(&magic, sizeof(int), 1, out);
+  fwrite(&version, sizeof(int), 1, out);
+
   /* Write ray tracing metadata to the Track file */
   int num_azim = 2 * _num_azim_2;
   fwrite(&num_azim, sizeof(int), 1, out);
@@ -1375,15 +2042,14 @@ void TrackGenerator::dumpTracksToFile() {
   double phi;
   int azim_angle_index;
   int num_segments;
-  std::vector<segment*> _segments;
   Cmfd* cmfd = _geometry->getCmfd();
 
-  segment* curr_segment;
   double length;
   int material_id;
   int region_id;
   int cmfd_surface_fwd;
   int cmfd_surface_bwd;
+  SegmentStore* buffer = _segment_store->createTrackBuffer();
 
   /* Loop over all Tracks */
   for (int i=0; i < _num_azim_2; i++) {
@@ -1399,7 +2065,11 @@ void TrackGenerator::dumpTracksToFile() {
       z1 = curr_track->getEnd()->getZ();
       phi = curr_track->getPhi();
       azim_angle_index = curr_track->getAzimAngleIndex();
-      num_segments = curr_track->getNumSegments();
+
+      long start, end;
+      SegmentStore* store = _segment_store->getTrackSegments
+          (curr_track->getUid(), buffer, &start, &end);
+      num_segments = end - start;
 
       /* Write data for this Track to the Track file */
       fwrite(&x0, sizeof(double), 1, out);
@@ -1413,13 +2083,13 @@ void TrackGenerator::dumpTracksToFile() {
       fwrite(&num_segments, sizeof(int), 1, out);
 
       /* Loop over all segments for this Track */
-      for (int s=0; s < num_segments; s++) {
+      for (long s=start; s < end; s++) {
 
         /* Get data for this segment */
-        curr_segment = curr_track->getSegment(s);
-        length = curr_segment->_length;
-        material_id = curr_segment->_material->getId();
-        region_id = curr_segment->_region_id;
+        length = store->getLengths()[s];
+        material_id =
+            store->getMaterials()[store->getMaterialIndices()[s]]->getId();
+        region_id = store->getRegionIds()[s];
 
         /* Write data for this segment to the Track file */
         fwrite(&length, sizeof(double), 1, out);
@@ -1428,8 +2098,8 @@ void TrackGenerator::dumpTracksToFile() {
 
         /* Write CMFD-related data for the Track if needed */
         if (cmfd != NULL) {
-          cmfd_surface_fwd = curr_segment->_cmfd_surface_fwd;
-          cmfd_surface_bwd = curr_segment->_cmfd_surface_bwd;
+          cmfd_surface_fwd = store->getCmfdSurfacesFwd()[s];
+          cmfd_surface_bwd = store->getCmfdSurfacesBwd()[s];
           fwrite(&cmfd_surface_fwd, sizeof(int), 1, out);
           fwrite(&cmfd_surface_bwd, sizeof(int), 1, out);
         }
@@ -1437,11 +2107,14 @@ void TrackGenerator::dumpTracksToFile() {
     }
   }
 
+  if (buffer != NULL)
+    delete buffer;
+
   /* Get FSR vector maps */
-  ParallelHashMap<std::string, fsr_data*>& FSR_keys_map =
+  ParallelHashMap<FSRKey, fsr_data*>& FSR_keys_map =
       _geometry->getFSRKeysMap();
-  std::vector<std::string>& FSRs_to_keys = _geometry->getFSRsToKeys();
-  std::string fsr_key;
+  std::vector<FSRKey>& FSRs_to_keys = _geometry->getFSRsToKeys();
+  FSRKey fsr_key;
   int fsr_id;
   double x, y, z;
 
@@ -1450,15 +2123,13 @@ void TrackGenerator::dumpTracksToFile() {
   fwrite(&num_FSRs, sizeof(int), 1, out);
 
   /* Write FSR vector maps to file */
-  std::string* fsr_key_list = FSR_keys_map.keys();
+  FSRKey* fsr_key_list = FSR_keys_map.keys();
   fsr_data** fsr_data_list = FSR_keys_map.values();
   for (int i=0; i < num_FSRs; i++) {
 
     /* Write key to file from FSR_keys_map */
     fsr_key = fsr_key_list[i];
-    string_length = fsr_key.length() + 1;
-    fwrite(&string_length, sizeof(int), 1, out);
-    fwrite(fsr_key.c_str(), sizeof(char)*string_length, 1, out);
+    fwrite(&fsr_key, sizeof(FSRKey), 1, out);
 
     /* Write data to file from FSR_keys_map */
     fsr_id = fsr_data_list[i]->_fsr_id;
@@ -1472,9 +2143,7 @@ void TrackGenerator::dumpTracksToFile() {
 
     /* Write data to file from FSRs_to_keys */
     fsr_key = FSRs_to_keys.at(i);
-    string_length = fsr_key.length() + 1;
-    fwrite(&string_length, sizeof(int), 1, out);
-    fwrite(fsr_key.c_str(), sizeof(char)*string_length, 1, out);
+    fwrite(&fsr_key, sizeof(FSRKey), 1, out);
   }
 
   /* Write cmfd_fsrs vector of vectors to file */
@@ -1516,6 +2185,8 @@ void TrackGenerator::dumpTracksToFile() {
  * @brief Reads Tracks in from a "*.tracks" binary file.
  * @details Storing Tracks in a binary file saves time by eliminating ray
  *          tracing for Track segmentation in commonly simulated geometries.
+ *          Track files for a different Geometry, or written in another
+ *          format version, are rejected such that the Tracks are regenerated.
  * @return true if able to read Tracks in from a file; false otherwise
  */
 bool TrackGenerator::readTracksFromFile() {
@@ -1532,6 +2203,8 @@ bool TrackGenerator::readTracksFromFile() {
     delete [] _tracks;
   }
 
+  deleteSegmentStore();
+
   int ret;
   FILE* in;
   in = fopen(_tracks_filename.c_str(), "r");
@@ -1544,10 +2217,29 @@ bool TrackGenerator::readTracksFromFile() {
 
   /* Check if our Geometry is exactly the same as the Geometry in the
    * Track file for this number of azimuthal angles and track spacing */
-  if (_geometry->toString().compare(std::string(geometry_to_string)) != 0)
+  bool same_geometry =
+      (_geometry->toString().compare(std::string(geometry_to_string)) == 0);
+  delete [] geometry_to_string;
+
+  if (!same_geometry) {
+    fclose(in);
     return false;
+  }
 
-  delete [] geometry_to_string;
+  /* Check that the Track file was written in the current format, since the
+   * FSR keys and segments are read as raw binary data */
+  int magic = 0;
+  int version = 0;
+  ret = fread(&magic, sizeof(int), 1, in);
+  ret = fread(&version, sizeof(int), 1, in);
+
+  if (magic != TRACK_FILE_MAGIC || version != TRACK_FILE_VERSION) {
+    log_printf(WARNING, "Regenerating the Tracks since the Track file %s is "
+               "not in the current format (version %d)",
+               _tracks_filename.c_str(), TRACK_FILE_VERSION);
+    fclose(in);
+    return false;
+  }
 
   log_printf(NORMAL, "Importing ray tracing data from file...");
 
@@ -1578,12 +2270,25 @@ bool TrackGenerator::readTracksFromFile() {
   int material_id;
   int region_id;
 
-  int cmfd_surface_fwd;
-  int cmfd_surface_bwd;
-  segment curr_segment;
+  int cmfd_surface_fwd = -1;
+  int cmfd_surface_bwd = -1;
 
   std::map<int, Material*> materials = _geometry->getAllMaterials();
 
+  /* The segments are read into the SegmentStore once the Tracks have been
+   * read, from the position of each Track's segments in the Track file */
+  int num_tracks = 0;
+  for (int i=0; i < _num_azim_2; i++)
+    num_tracks += _num_tracks[i];
+
+  SegmentStore* segment_store = new SegmentStore(num_tracks);
+  segment_store->setMaterials(materials);
+  std::vector<long> segment_positions(num_tracks);
+  long segment_bytes = sizeof(double) + 2 * sizeof(int);
+  if (cmfd != NULL)
+    segment_bytes += 2 * sizeof(int);
+  int uid = 0;
+
   /* Loop over Tracks */
   for (int i=0; i < _num_azim_2; i++) {
     _tracks[i] = new Track[_num_tracks[i]];
@@ -1608,42 +2313,24 @@ bool TrackGenerator::readTracksFromFile() {
       if (azim_angle_index < _num_azim_2 / 2)
         _quadrature->setPhi(phi, azim_angle_index);
 
-      /* Loop over all segments in this Track */
-      for (int s=0; s < num_segments; s++) {
-
-        /* Import data for this segment from Track file */
-        ret = fread(&length, sizeof(double), 1, in);
-        ret = fread(&material_id, sizeof(int), 1, in);
-        ret = fread(&region_id, sizeof(int), 1, in);
-
-        /* Initialize segment with the data */
-        curr_segment._length = length;
-        curr_segment._material = materials[material_id];
-        curr_segment._region_id = region_id;
-
-        /* Import CMFD-related data if needed */
-        if (cmfd != NULL) {
-          ret = fread(&cmfd_surface_fwd, sizeof(int), 1, in);
-          ret = fread(&cmfd_surface_bwd, sizeof(int), 1, in);
-          curr_segment._cmfd_surface_fwd = cmfd_surface_fwd;
-          curr_segment._cmfd_surface_bwd = cmfd_surface_bwd;
-        }
-
-        /* Add this segment to the Track */
-        curr_track->addSegment(&curr_segment);
-      }
+      /* Skip over the segments in this Track, numbering the Tracks in the
+       * order of their UIDs */
+      segment_store->setNumSegments(uid, num_segments);
+      segment_positions[uid] = ftell(in);
+      fseek(in, num_segments * segment_bytes, SEEK_CUR);
+      uid++;
     }
   }
 
   /* Create FSR vector maps */
-  ParallelHashMap<std::string, fsr_data*>& FSR_keys_map =
+  ParallelHashMap<FSRKey, fsr_data*>& FSR_keys_map =
       _geometry->getFSRKeysMap();
-  std::vector<std::string>& FSRs_to_keys =
+  std::vector<FSRKey>& FSRs_to_keys =
       _geometry->getFSRsToKeys();
   FSR_keys_map.clear();
   FSRs_to_keys.clear();
   int num_FSRs;
-  std::string fsr_key;
+  FSRKey fsr_key;
   int fsr_key_id;
   double x, y, z;
 
@@ -1654,10 +2341,7 @@ bool TrackGenerator::readTracksFromFile() {
   for (int fsr_id=0; fsr_id < num_FSRs; fsr_id++) {
 
     /* Read key for FSR_keys_map */
-    ret = fread(&string_length, sizeof(int), 1, in);
-    char* char_buffer1 = new char[string_length];
-    ret = fread(char_buffer1, sizeof(char)*string_length, 1, in);
-    fsr_key = std::string(char_buffer1);
+    ret = fread(&fsr_key, sizeof(FSRKey), 1, in);
 
     /* Read data from file for FSR_keys_map */
     ret = fread(&fsr_key_id, sizeof(int), 1, in);
@@ -1672,10 +2356,7 @@ bool TrackGenerator::readTracksFromFile() {
     FSR_keys_map.insert(fsr_key, fsr);
 
     /* Read data from file for FSR_to_keys */
-    ret = fread(&string_length, sizeof(int), 1, in);
-    char* char_buffer2 = new char[string_length];
-    ret = fread(char_buffer2, sizeof(char)*string_length, 1, in);
-    fsr_key = std::string(char_buffer2);
+    ret = fread(&fsr_key, sizeof(FSRKey), 1, in);
     FSRs_to_keys.push_back(fsr_key);
   }
 
@@ -1701,6 +2382,35 @@ bool TrackGenerator::readTracksFromFile() {
     cmfd->setCellFSRs(&cell_fsrs);
   }
 
+  /* Import the segments of each Track into the SegmentStore */
+  segment_store->allocate();
+
+  for (int t=0; t < num_tracks; t++) {
+
+    fseek(in, segment_positions[t], SEEK_SET);
+    long offset = segment_store->getTrackOffset(t);
+
+    for (int s=0; s < segment_store->getNumSegments(t); s++) {
+
+      /* Import data for this segment from Track file */
+      ret = fread(&length, sizeof(double), 1, in);
+      ret = fread(&material_id, sizeof(int), 1, in);
+      ret = fread(&region_id, sizeof(int), 1, in);
+
+      /* Import CMFD-related data if needed */
+      if (cmfd != NULL) {
+        ret = fread(&cmfd_surface_fwd, sizeof(int), 1, in);
+        ret = fread(&cmfd_surface_bwd, sizeof(int), 1, in);
+      }
+
+      int material_index =
+          segment_store->getMaterialIndex(materials[material_id]);
+      segment_store->setSegment(offset + s, length, material_index,
+                                region_id, cmfd_surface_fwd,
+                                cmfd_surface_bwd);
+    }
+  }
+
   /* Inform the rest of the class methods that Tracks have been initialized */
   if (ret)
     _contains_tracks = true;
@@ -1708,6 +2418,8 @@ bool TrackGenerator::readTracksFromFile() {
   /* Close the Track file */
   fclose(in);
 
+  installSegmentStore(segment_store);
+
   return true;
 }
 
@@ -1732,15 +2444,16 @@ void TrackGenerator::correctFSRVolume(int fsr_id, FP_PRECISION fsr_volume) {
   log_printf(INFO, "Correcting FSR %d volume from %f to %f",
              fsr_id, curr_volume, fsr_volume);
 
-  int num_segments, azim_index;
   double dx_eff, d_eff;
   double volume, corr_factor;
-  segment* curr_segment;
-  segment* segments;
 
   /* Correct volume separately for each azimuthal angle */
   for (int i=0; i < _num_azim_2; i++) {
 
+    /* Skip the azimuthal angles of other ranks */
+    if (_num_tracks[i] == 0)
+      continue;
+
     /* Initialize volume to zero for this azimuthal angle */
     volume = 0;
 
@@ -1749,18 +2462,27 @@ void TrackGenerator::correctFSRVolume(int fsr_id, FP_PRECISION fsr_volume) {
     d_eff = (dx_eff * sin(_tracks[i][0].getPhi()));
 
     /* Compute the current estimated volume of the FSR for this angle */
-#pragma omp parallel for  private(num_segments, segments, curr_segment) \
-  reduction(+:volume)
-    for (int j=0; j < _num_tracks[i]; j++) {
+#pragma omp parallel
+    {
+      SegmentStore* buffer = _segment_store->createTrackBuffer();
+
+#pragma omp for reduction(+:volume)
+      for (int j=0; j < _num_tracks[i]; j++) {
 
-      num_segments = _tracks[i][j].getNumSegments();
-      segments = _tracks[i][j].getSegments();
+        long start, end;
+        SegmentStore* store = _segment_store->getTrackSegments
+            (_tracks[i][j].getUid(), buffer, &start, &end);
+        FP_STORAGE* lengths = store->getLengths();
+        int* region_ids = store->getRegionIds();
 
-      for (int s=0; s < num_segments; s++) {
-        curr_segment = &segments[s];
-        if (curr_segment->_region_id == fsr_id)
-          volume += curr_segment->_length * d_eff;
+        for (long s=start; s < end; s++) {
+          if (region_ids[s] == fsr_id)
+            volume += lengths[s] * d_eff;
+        }
       }
+
+      if (buffer != NULL)
+        delete buffer;
     }
 
     /* Compute correction factor to the volume */
@@ -1769,19 +2491,11 @@ void TrackGenerator::correctFSRVolume(int fsr_id, FP_PRECISION fsr_volume) {
     log_printf(DEBUG, "Volume correction factor for FSR %d and azim "
                "angle %d is %f", fsr_id, i, corr_factor);
 
-    /* Correct the length of each segment which crosses the FSR */
-#pragma omp parallel for  private(num_segments, segments, curr_segment)
-    for (int j=0; j < _num_tracks[i]; j++) {
-
-      num_segments = _tracks[i][j].getNumSegments();
-      segments = _tracks[i][j].getSegments();
-
-      for (int s=0; s < num_segments; s++) {
-        curr_segment = &segments[s];
-        if (curr_segment->_region_id == fsr_id)
-          curr_segment->_length *= corr_factor;
-      }
-    }
+    /* Correct the length of each segment which crosses the FSR, where the
+     * UIDs of the Tracks for this angle follow those of the previous angles */
+    int first_uid = _tracks[i][0].getUid();
+    _segment_store->scaleLengths(fsr_id, corr_factor, first_uid,
+                                 first_uid + _num_tracks[i]);
   }
 }
 
@@ -1792,68 +2506,55 @@ void TrackGenerator::correctFSRVolume(int fsr_id, FP_PRECISION fsr_volume) {
  *          by weighting the average x and y values of each segment in the
  *          FSR by the segment's length and azimuthal weight. The numerical
  *          centroid fomula can be found in R. Ferrer et. al. "Linear Source
- *          Approximation in CASMO 5", PHYSOR 2012.
+ *          Approximation in CASMO 5", PHYSOR 2012. The segments are
+ *          traversed by a CentroidCalculator, such that the centroids are
+ *          also found when segments are formed on-the-fly.
  */
 void TrackGenerator::generateFSRCentroids() {
 
   int num_FSRs = _geometry->getNumFSRs();
-  FP_PRECISION* FSR_volumes = getFSRVolumes();
+
+  /* Compute the FSR volumes which weight the segments, if necessary */
+  getFSRVolumes();
 
   /* Create array of centroids and initialize to origin */
   Point** centroids = new Point*[num_FSRs];
+  double* centroids_x = new double[num_FSRs];
+  double* centroids_y = new double[num_FSRs];
 #pragma omp parallel for
   for (int r=0; r < num_FSRs; r++) {
     centroids[r] = new Point();
     centroids[r]->setCoords(0.0, 0.0, 0.0);
+    centroids_x[r] = 0.0;
+    centroids_y[r] = 0.0;
   }
 
-  /* Generate the fsr centroids */
-  for (int i=0; i < _num_azim_2; i++) {
-    FP_PRECISION azim_weight = _quadrature->getAzimWeight(i)
-            * _quadrature->getAzimSpacing(i);
-
-#pragma omp parallel for
-    for (int j=0; j < _num_tracks[i]; j++) {
-
-      int num_segments = _tracks[i][j].getNumSegments();
-      segment* segments = _tracks[i][j].getSegments();
-      double x = _tracks[i][j].getStart()->getX();
-      double y = _tracks[i][j].getStart()->getY();
-      double z = _tracks[i][j].getStart()->getZ();
-      double phi = _tracks[i][j].getPhi();
-
-      for (int s=0; s < num_segments; s++) {
-        segment* curr_segment = &segments[s];
-        int fsr = curr_segment->_region_id;
-        double volume = FSR_volumes[fsr];
-
-        /* Set FSR mutual exclusion lock */
-        omp_set_lock(&_FSR_locks[fsr]);
-
-        centroids[fsr]->setX(centroids[fsr]->getX() + azim_weight *
-                             (x + cos(phi) * curr_segment->_length / 2.0) *
-                             curr_segment->_length / FSR_volumes[fsr]);
-        centroids[fsr]->setY(centroids[fsr]->getY() + azim_weight *
-                             (y + sin(phi) * curr_segment->_length / 2.0) *
-                             curr_segment->_length / FSR_volumes[fsr]);
-        centroids[fsr]->setZ(z);
-
-        /* Release FSR mutual exclusion lock */
-        omp_unset_lock(&_FSR_locks[fsr]);
-
-        x += cos(phi) * curr_segment->_length;
-        y += sin(phi) * curr_segment->_length;
-      }
-    }
+  /* Generate the FSR centroids from the segments */
+  CentroidCalculator centroid_calculator(this, centroids_x, centroids_y);
+  centroid_calculator.execute();
+
+#ifdef MPIx
+  /* Sum the centroids contributed by the azimuthal angles of each rank */
+  if (_angular_decomposed) {
+    MPI_Allreduce(MPI_IN_PLACE, centroids_x, num_FSRs, MPI_DOUBLE, MPI_SUM,
+                  _MPI_angles);
+    MPI_Allreduce(MPI_IN_PLACE, centroids_y, num_FSRs, MPI_DOUBLE, MPI_SUM,
+                  _MPI_angles);
   }
+#endif
 
   /* Set the centroid for the FSR */
 #pragma omp parallel for
-  for (int r=0; r < num_FSRs; r++)
+  for (int r=0; r < num_FSRs; r++) {
+    centroids[r]->setX(centroids_x[r]);
+    centroids[r]->setY(centroids_y[r]);
     _geometry->setFSRCentroid(r, centroids[r]);
+  }
 
   /* Delete temporary array of FSR volumes and centroids */
   delete [] centroids;
+  delete [] centroids_x;
+  delete [] centroids_y;
 }
 
 
@@ -1862,7 +2563,8 @@ void TrackGenerator::generateFSRCentroids() {
  *        maximum optical length for the problem.
  * @details This routine is needed so that all segment lengths fit
  *          within the exponential interpolation table used in the MOC
- *          transport sweep.
+ *          transport sweep. The segments are split by the MOCKernels, which
+ *          for explicit segments rebuild the SegmentStore from the old one.
  * @param max_optical_length the maximum optical length
  */
 void TrackGenerator::splitSegments(FP_PRECISION max_optical_length) {
@@ -1871,126 +2573,558 @@ void TrackGenerator::splitSegments(FP_PRECISION max_optical_length) {
     log_printf(ERROR, "Unable to split segments since "
 	       "tracks have not yet been generated");
 
-#pragma omp parallel
-  {
+  _max_optical_length = max_optical_length;
 
-    int num_cuts, min_num_cuts;
-    segment* curr_segment;
+  /* Segments formed on-the-fly are split by the MOCKernels during sweeps */
+  if (_segment_formation == OTF_2D)
+    countSegments();
+  else
+    initializeSegmentStore();
+}
 
-    FP_PRECISION length, tau;
-    int fsr_id;
-    Material* material;
-    FP_PRECISION* sigma_t;
-    int num_groups;
-    int cmfd_surface_fwd, cmfd_surface_bwd;
 
-    /* Iterate over all Tracks */
-    for (int i=0; i < _num_azim_2; i++) {
-#pragma omp for
-      for (int j=0; j < _num_tracks[i]; j++) {
-        for (int s=0; s < _tracks[i][j].getNumSegments(); s+=min_num_cuts) {
-
-          /* Extract data from this segment to compute it optical length */
-          curr_segment = _tracks[i][j].getSegment(s);
-          material = curr_segment->_material;
-          length = curr_segment->_length;
-          fsr_id = curr_segment->_region_id;
-          cmfd_surface_fwd = curr_segment->_cmfd_surface_fwd;
-          cmfd_surface_bwd = curr_segment->_cmfd_surface_bwd;
-
-          /* Compute number of segments to split this segment into */
-          min_num_cuts = 1;
-          num_groups = material->getNumEnergyGroups();
-          sigma_t = material->getSigmaT();
-
-          for (int g=0; g < num_groups; g++) {
-            tau = length * sigma_t[g];
-            num_cuts = ceil(tau / max_optical_length);
-            min_num_cuts = std::max(num_cuts, min_num_cuts);
-          }
+/**
+ * @brief Initialize track segments with pointers to FSR Materials.
+ * @details This is called by the Solver at simulation time. This
+ *          initialization is necessary since Materials in each FSR
+ *          may be interchanged by the user in between different
+ *          simulations. This method links each stored segment and fsr_data
+ *          struct with the current Material found in each FSR.
+ */
+void TrackGenerator::initializeSegments() {
 
-          /* If the segment does not need subdivisions, go to next segment */
-          if (min_num_cuts == 1)
-            continue;
+  if (!_contains_tracks)
+    log_printf(ERROR, "Unable to initialize segments since "
+	       "tracks have not yet been generated");
+
+  /* Get all of the Materials from the Geometry */
+  std::map<int, Material*> materials = _geometry->getAllMaterials();
+
+  /* Get the mappings of FSR to keys to fsr_data to update Materials */
+  ParallelHashMap<FSRKey, fsr_data*>& FSR_keys_map =
+      _geometry->getFSRKeysMap();
+  std::vector<FSRKey>& FSRs_to_keys = _geometry->getFSRsToKeys();
+  int num_FSRs = _geometry->getNumFSRs();
+  Material** FSR_materials = new Material*[num_FSRs];
 
-          /* Split the segment into sub-segments */
-          for (int k=0; k < min_num_cuts; k++) {
+  /* Set the Material for each FSR */
+#pragma omp parallel for
+  for (int r=0; r < num_FSRs; r++) {
+    FSR_materials[r] = _geometry->findFSRMaterial(r);
+    FSR_keys_map.at(FSRs_to_keys.at(r))->_mat_id = FSR_materials[r]->getId();
+  }
 
-            /* Create a new Track segment */
-            segment* new_segment = new segment;
-            new_segment->_material = material;
-            new_segment->_length = length / FP_PRECISION(min_num_cuts);
-            new_segment->_region_id = fsr_id;
+  /* Set the Material for each stored segment */
+  if (_segment_store != NULL)
+    _segment_store->updateMaterials(materials, FSR_materials, num_FSRs);
 
-            /* Assign CMFD surface boundaries */
-            if (k == 0)
-              new_segment->_cmfd_surface_bwd = cmfd_surface_bwd;
+  delete [] FSR_materials;
+}
 
-            if (k == min_num_cuts-1)
-              new_segment->_cmfd_surface_fwd = cmfd_surface_fwd;
 
-            /* Insert the new segment to the Track */
-            _tracks[i][j].insertSegment(s+k+1, new_segment);
-          }
+/**
+ * @brief Builds the contiguous SegmentStore which owns the segments.
+ * @details The SegmentStore is filled in two passes over the segments. The
+ *          number of segments on each Track is first counted with
+ *          CounterKernels, after which the SegmentStore arrays are allocated
+ *          and filled with SegmentationKernels. Both passes ray trace the
+ *          Tracks when no SegmentStore has been built, and otherwise stream
+ *          the segments of the old SegmentStore, which is then replaced.
+ *          Segments longer than the maximum optical path length are split in
+ *          the process.
+ */
+void TrackGenerator::initializeSegmentStore() {
+
+  if (!_contains_tracks)
+    log_printf(ERROR, "Unable to initialize the SegmentStore since "
+               "tracks have not yet been generated");
+
+  if (_segment_formation == OTF_2D)
+    log_printf(ERROR, "Unable to initialize the SegmentStore since segments "
+               "are formed on-the-fly");
+
+  SegmentStore* segment_store = new SegmentStore(getNumTracks());
+  segment_store->setMaterials(_geometry->getAllMaterials());
+
+  /* Count the segments on each Track and allocate the SegmentStore */
+  SegmentCounter counter(this, segment_store);
+  counter.execute();
+  segment_store->allocate();
+
+#ifdef MPIx
+  /* Number the FSRs consistently across domains before their IDs are stored */
+  if (_segment_store == NULL && _angular_decomposed)
+    synchronizeFSRs();
+#endif
+
+  /* Fill the SegmentStore with the segments on each Track */
+  SegmentStoreFiller filler(this, segment_store);
+  filler.execute();
+
+  installSegmentStore(segment_store);
+}
+
+
+/**
+ * @brief Replaces the SegmentStore with a filled SegmentStore.
+ * @details The SegmentStore is compressed if requested, after which the
+ *          memory saved by the compression and the total segment memory,
+ *          including the threads' decoding buffers, are reported.
+ * @param segment_store the filled SegmentStore, which the TrackGenerator
+ *        takes ownership of
+ */
+void TrackGenerator::installSegmentStore(SegmentStore* segment_store) {
+
+  deleteSegmentStore();
+  _segment_store = segment_store;
+  _max_num_segments = _segment_store->getMaxNumSegments();
+
+  log_printf(INFO, "Stored %ld segments in %.2f MB",
+             _segment_store->getNumSegments(),
+             _segment_store->getNumBytes() / 1.E6);
+
+  /* Compress the segments and report the memory saved */
+  if (_segment_compression) {
+    long num_segments = _segment_store->getNumSegments();
+    long uncompressed_bytes = _segment_store->getNumUncompressedBytes();
+    _segment_store->compress();
+    long compressed_bytes = _segment_store->getNumBytes();
+    log_printf(NORMAL, "Compressed %ld segments from %.2f to %.2f bytes per "
+               "segment (%.2f MB to %.2f MB)", num_segments,
+               double(uncompressed_bytes) / std::max(num_segments, 1L),
+               double(compressed_bytes) / std::max(num_segments, 1L),
+               uncompressed_bytes / 1.E6, compressed_bytes / 1.E6);
+
+    /* The uncompressed arrays are only freed once they have been packed */
+    long buffer_bytes = long(omp_get_max_threads()) * _max_num_segments
+        * (sizeof(FP_STORAGE) + 4 * sizeof(int));
+    log_printf(NORMAL, "Total segment memory of %.2f MB with %.2f MB of "
+               "thread decoding buffers, peaking at %.2f MB during "
+               "compression", (compressed_bytes + buffer_bytes) / 1.E6,
+               buffer_bytes / 1.E6,
+               (uncompressed_bytes + compressed_bytes) / 1.E6);
+  }
+}
+
+
+/**
+ * @brief Deletes the SegmentStore if it has been built.
+ */
+void TrackGenerator::deleteSegmentStore() {
+
+  if (_segment_store != NULL)
+    delete _segment_store;
+
+  _segment_store = NULL;
+
+  /* The Track schedule is weighted by the number of segments */
+  deleteTrackSchedule();
+}
+
+
+/**
+ * @brief Estimates the number of FSR cache misses in a transport sweep.
+ * @details The FSRs crossed by the segments of each Track are accessed in
+ *          the forward and then the reverse direction, with the Tracks of
+ *          each azimuthal angle traversed by index. Each access is applied
+ *          to a least-recently-used cache holding the scalar fluxes of a
+ *          number of FSRs and the misses are counted. This is a serial
+ *          estimate which neglects the partitioning of the Tracks among
+ *          threads.
+ * @param cache_size the number of FSRs held in the cache
+ * @param num_accesses the number of FSR accesses, set by this function
+ * @return the number of cache misses
+ */
+long TrackGenerator::estimateSweepCacheMisses(int cache_size,
+                                              long& num_accesses) {
+
+  int num_FSRs = _geometry->getNumFSRs();
+  std::list<int> cache;
+  std::vector<std::list<int>::iterator> entries(num_FSRs, cache.end());
+  long num_misses = 0;
+  num_accesses = 0;
+
+  SegmentStore* buffer = _segment_store->createTrackBuffer();
 
-          /* Remove the original segment from the Track */
-          _tracks[i][j].removeSegment(s);
+  for (int a=0; a < _num_azim_2; a++) {
+    for (int i=0; i < _num_tracks[a]; i++) {
+      Track* track = &_tracks[a][i];
+      long start, end;
+      SegmentStore* store = _segment_store->getTrackSegments
+          (track->getUid(), buffer, &start, &end);
+      int* region_ids = store->getRegionIds();
+      int num_segments = end - start;
+      num_accesses += 2 * num_segments;
+
+      for (int s=0; s < 2 * num_segments; s++) {
+        int index = (s < num_segments) ? s : 2 * num_segments - s - 1;
+        int fsr_id = region_ids[start + index];
+
+        /* Move an FSR in the cache to the front of the list */
+        if (entries[fsr_id] != cache.end()) {
+          cache.splice(cache.begin(), cache, entries[fsr_id]);
+          continue;
+        }
+
+        /* Insert a missed FSR, evicting the least recently used FSR */
+        num_misses++;
+        cache.push_front(fsr_id);
+        entries[fsr_id] = cache.begin();
+        if (int(cache.size()) > cache_size) {
+          entries[cache.back()] = cache.end();
+          cache.pop_back();
         }
       }
     }
   }
+
+  delete buffer;
+
+  return num_misses;
 }
 
 
 /**
- * @brief Initialize track segments with pointers to FSR Materials.
- * @details This is called by the Solver at simulation time. This
- *          initialization is necessary since Materials in each FSR
- *          may be interchanged by the user in between different
- *          simulations. This method links each segment and fsr_data
- *          struct with the current Material found in each FSR.
+ * @brief Reports the estimated FSR cache misses in a transport sweep.
+ * @details The misses are estimated with estimateSweepCacheMisses(...) for
+ *          an LRU cache of scalar fluxes. This requires explicit segments.
+ * @param cache_size the number of FSRs whose scalar fluxes fit in the cache
  */
-void TrackGenerator::initializeSegments() {
+void TrackGenerator::printSweepCacheReport(int cache_size) {
 
   if (!_contains_tracks)
-    log_printf(ERROR, "Unable to initialize segments since "
-	       "tracks have not yet been generated");
+    log_printf(ERROR, "Unable to report the sweep cache misses since Tracks "
+               "have not yet been generated");
 
-  /* Get all of the Materials from the Geometry */
-  std::map<int, Material*> materials = _geometry->getAllMaterials();
+  if (_segment_formation == OTF_2D)
+    log_printf(ERROR, "Unable to report the sweep cache misses since "
+               "segments are formed on-the-fly");
 
-  /* Get the mappings of FSR to keys to fsr_data to update Materials */
-  ParallelHashMap<std::string, fsr_data*>& FSR_keys_map =
-      _geometry->getFSRKeysMap();
-  std::vector<std::string>& FSRs_to_keys = _geometry->getFSRsToKeys();
+  if (cache_size <= 0)
+    log_printf(ERROR, "Unable to report the sweep cache misses for a cache "
+               "of %d FSRs", cache_size);
 
-#pragma omp parallel
-  {
+  long num_accesses;
+  long num_misses = estimateSweepCacheMisses(cache_size, num_accesses);
+  double miss_rate = 100. * num_misses / std::max(num_accesses, 1L);
+
+  std::string msg_string;
+
+  log_printf(TITLE, "SWEEP CACHE REPORT");
+
+  msg_string = "FSR accesses in a transport sweep";
+  msg_string.resize(REPORT_WIDTH, '.');
+  log_printf(RESULT, "%s%ld", msg_string.c_str(), num_accesses);
+
+  msg_string = "FSR cache misses";
+  msg_string.resize(REPORT_WIDTH, '.');
+  log_printf(RESULT, "%s%ld", msg_string.c_str(), num_misses);
+
+  msg_string = "FSR cache miss rate";
+  msg_string.resize(REPORT_WIDTH, '.');
+  log_printf(RESULT, "%s%.2f %%", msg_string.c_str(), miss_rate);
+}
 
-    int region_id, mat_id;
-    segment* curr_segment;
-    Material* mat;
 
-    /* Set the Material for each FSR */
-#pragma omp for
-    for (int r=0; r < _geometry->getNumFSRs(); r++) {
-      mat = _geometry->findFSRMaterial(r);
-      FSR_keys_map.at(FSRs_to_keys.at(r))->_mat_id = mat->getId();
+/**
+ * @brief Partitions the Tracks of all azimuthal angles among threads
+ *        weighted by their number of segments.
+ * @details Each Track is weighted by its number of segments, or by its
+ *          length if segments are formed on-the-fly. The Tracks are assigned
+ *          in decreasing order of weight to the least loaded thread (the
+ *          longest-processing-time heuristic), after which the Tracks of
+ *          each thread are sorted by UID to retain locality.
+ * @param num_threads the number of threads among which to partition Tracks
+ */
+void TrackGenerator::initializeTrackSchedule(int num_threads) {
+
+  if (num_threads <= 0)
+    log_printf(ERROR, "Unable to initialize a Track schedule for %d threads",
+               num_threads);
+
+  int num_tracks = getNumTracks();
+
+  /* Find the weight of each Track */
+  std::vector<double> weights(num_tracks);
+  for (int a=0; a < _num_azim_2; a++) {
+    for (int i=0; i < _num_tracks[a]; i++) {
+      Track* track = &_tracks[a][i];
+      int uid = track->getUid();
+
+      if (_segment_store != NULL)
+        weights[uid] = _segment_store->getNumSegments(uid);
+      else
+        weights[uid] = track->getStart()->distanceToPoint(track->getEnd());
     }
+  }
 
-    /* Set the Material for each segment */
-    for (int i=0; i < _num_azim_2; i++) {
-#pragma omp for
-      for (int j=0; j < _num_tracks[i]; j++) {
-        for (int s=0; s < _tracks[i][j].getNumSegments(); s++) {
-          curr_segment = _tracks[i][j].getSegment(s);
-          region_id = curr_segment->_region_id;
-          mat_id = FSR_keys_map.at(FSRs_to_keys.at(region_id))->_mat_id;
-          curr_segment->_material = materials[mat_id];
-        }
+  /* Sort the Tracks by decreasing weight */
+  std::vector< std::pair<double, int> > tracks(num_tracks);
+  for (int uid=0; uid < num_tracks; uid++)
+    tracks[uid] = std::make_pair(-weights[uid], uid);
+  std::sort(tracks.begin(), tracks.end());
+
+  /* Assign each Track to the least loaded thread */
+  typedef std::pair<double, int> load;
+  std::priority_queue<load, std::vector<load>, std::greater<load> > loads;
+  for (int t=0; t < num_threads; t++)
+    loads.push(std::make_pair(0., t));
+
+  std::vector< std::vector<int> > thread_tracks(num_threads);
+  double max_load = 0.;
+  double total_load = 0.;
+  for (int i=0; i < num_tracks; i++) {
+    load least_loaded = loads.top();
+    loads.pop();
+    int uid = tracks[i].second;
+    least_loaded.first += weights[uid];
+    thread_tracks[least_loaded.second].push_back(uid);
+    loads.push(least_loaded);
+    max_load = std::max(max_load, least_loaded.first);
+    total_load += weights[uid];
+  }
+
+  /* Store the Tracks of each thread in traversal order */
+  deleteTrackSchedule();
+  _schedule_tracks = new int[num_tracks];
+  _schedule_offsets = new int[num_threads+1];
+  _schedule_offsets[0] = 0;
+  for (int t=0; t < num_threads; t++) {
+    std::sort(thread_tracks[t].begin(), thread_tracks[t].end());
+    int offset = _schedule_offsets[t];
+    for (size_t i=0; i < thread_tracks[t].size(); i++)
+      _schedule_tracks[offset + i] = thread_tracks[t][i];
+    _schedule_offsets[t+1] = offset + thread_tracks[t].size();
+  }
+  _schedule_num_threads = num_threads;
+
+  log_printf(INFO, "Partitioned %d Tracks among %d threads with a maximum "
+             "load %.2f%% above the mean", num_tracks, num_threads,
+             100. * (max_load * num_threads / std::max(total_load, 1.) - 1.));
+}
+
+
+/**
+ * @brief Deletes the schedule by which the Tracks are distributed among
+ *        threads.
+ */
+void TrackGenerator::deleteTrackSchedule() {
+
+  if (_schedule_tracks != NULL)
+    delete [] _schedule_tracks;
+
+  if (_schedule_offsets != NULL)
+    delete [] _schedule_offsets;
+
+  _schedule_tracks = NULL;
+  _schedule_offsets = NULL;
+  _schedule_num_threads = 0;
+}
+
+
+/**
+ * @brief Orders the Track directions along the paths by which the angular
+ *        flux is transferred between Tracks.
+ * @details The angular flux leaving each Track direction is transferred to
+ *          the incoming end of the next Track direction given by the Track's
+ *          outgoing Track and direction. The Track directions are grouped
+ *          into cycles following these transfers: an open cycle starts with a
+ *          Track direction entering through a vacuum boundary and ends with
+ *          one leaving through a vacuum boundary, while the remaining Track
+ *          directions form closed cycles along reflective and periodic
+ *          boundaries. Each Track direction belongs to exactly one cycle.
+ *          Unlike the reflective and periodic cycle indices, the cycles are
+ *          found from each Track's connections and hold for any mix of
+ *          boundary conditions.
+ */
+void TrackGenerator::initializeTrackCycles() {
+
+  if (!_contains_tracks)
+    log_printf(ERROR, "Unable to initialize the Track cycles since Tracks "
+               "have not yet been generated");
+
+  int num_tracks = getNumTracks();
+  int num_directions = 2 * num_tracks;
+
+  /* Find the Track direction to which each Track direction transfers its
+   * outgoing angular flux, if any */
+  std::vector<int> next(num_directions, -1);
+  std::vector<bool> has_previous(num_directions, false);
+  for (int uid=0; uid < num_tracks; uid++) {
+    Track* track = _tracks_array[uid];
+    for (int d=0; d < 2; d++) {
+      bool transfer;
+      int next_direction;
+      if (d == 0) {
+        transfer = track->getTransferFluxOut();
+        next_direction = 2 * track->getTrackOut()->getUid() +
+                         track->isNextOut();
+      }
+      else {
+        transfer = track->getTransferFluxIn();
+        next_direction = 2 * track->getTrackIn()->getUid() +
+                         track->isNextIn();
+      }
+
+      if (!transfer)
+        continue;
+
+      if (has_previous[next_direction])
+        log_printf(ERROR, "Unable to initialize the Track cycles since "
+                   "Track %d receives angular flux from more than one Track",
+                   next_direction / 2);
+
+      next[2*uid+d] = next_direction;
+      has_previous[next_direction] = true;
+    }
+  }
+
+  deleteTrackCycles();
+  _track_cycles = new int[num_directions];
+  std::vector<int> offsets;
+  std::vector<bool> visited(num_directions, false);
+  int num_visited = 0;
+
+  /* Follow the open cycles from each vacuum boundary and then the closed
+   * cycles from the first Track direction not yet visited */
+  for (int pass=0; pass < 2; pass++) {
+    for (int i=0; i < num_directions; i++) {
+      if (visited[i] || (pass == 0 && has_previous[i]))
+        continue;
+
+      offsets.push_back(num_visited);
+      for (int j=i; j != -1 && !visited[j]; j=next[j]) {
+        visited[j] = true;
+        _track_cycles[num_visited++] = j;
       }
     }
   }
+
+  _num_track_cycles = offsets.size();
+  _track_cycle_offsets = new int[_num_track_cycles+1];
+  for (int c=0; c < _num_track_cycles; c++)
+    _track_cycle_offsets[c] = offsets[c];
+  _track_cycle_offsets[_num_track_cycles] = num_directions;
+
+  log_printf(INFO, "Ordered %d Track directions into %d Track cycles",
+             num_directions, _num_track_cycles);
+}
+
+
+/**
+ * @brief Finds the Track directions leaving through each face of a spatial
+ *        domain and the boundary fluxes of their incoming fluxes.
+ * @details INTERFACE boundaries connect the Tracks as REFLECTIVE boundaries
+ *          do, so the sweep stores the outgoing flux of each Track direction
+ *          leaving through an interface in the boundary flux of its
+ *          reflected Track. After the sweep these outgoing fluxes are sent to
+ *          the neighboring domain, which receives them in the Track
+ *          directions to which they would be transferred with PERIODIC
+ *          boundary conditions. The Track directions leaving through every
+ *          face are found since a domain receives the fluxes leaving its
+ *          neighbor through the face opposite to their shared interface.
+ */
+void TrackGenerator::initializeInterfaceFluxes() {
+
+  deleteInterfaceFluxes();
+
+  if (!_geometry->isDomainDecomposed())
+    return;
+
+  std::vector<int> exits[NUM_FACES];
+  std::vector<int> entries[NUM_FACES];
+
+  for (int i=0; i < _num_azim_2; i++) {
+    for (int j=0; j < _num_tracks[i]; j++) {
+
+      Track* track = &_tracks[i][j];
+      int face, periodic_j;
+
+      /* Track direction leaving through a face in the "forward" direction */
+      if (j < _num_y[i]) {
+        face = (i < _num_azim_2/2) ? SURFACE_X_MAX : SURFACE_X_MIN;
+        periodic_j = j + _num_x[i];
+      }
+      else {
+        face = SURFACE_Y_MAX;
+        periodic_j = j - _num_y[i];
+      }
+
+      exits[face].push_back(2 * track->getTrackOut()->getUid() +
+                            track->isNextOut());
+      entries[face].push_back(2 * _tracks[i][periodic_j].getUid());
+
+      /* Track direction leaving through a face in the "reverse" direction */
+      if (j < _num_x[i]) {
+        face = SURFACE_Y_MIN;
+        periodic_j = j + _num_y[i];
+      }
+      else {
+        face = (i < _num_azim_2/2) ? SURFACE_X_MIN : SURFACE_X_MAX;
+        periodic_j = j - _num_x[i];
+      }
+
+      exits[face].push_back(2 * track->getTrackIn()->getUid() +
+                            track->isNextIn());
+      entries[face].push_back(2 * _tracks[i][periodic_j].getUid() + 1);
+    }
+  }
+
+  /* Store the exits and entries of all faces in contiguous arrays */
+  _interface_offsets = new int[NUM_FACES+1];
+  _interface_offsets[0] = 0;
+  for (int f=0; f < NUM_FACES; f++)
+    _interface_offsets[f+1] = _interface_offsets[f] + exits[f].size();
+
+  _interface_exits = new int[_interface_offsets[NUM_FACES]];
+  _interface_entries = new int[_interface_offsets[NUM_FACES]];
+  for (int f=0; f < NUM_FACES; f++) {
+    std::copy(exits[f].begin(), exits[f].end(),
+              &_interface_exits[_interface_offsets[f]]);
+    std::copy(entries[f].begin(), entries[f].end(),
+              &_interface_entries[_interface_offsets[f]]);
+  }
+
+  log_printf(INFO, "Found %d Track directions leaving through the faces of "
+             "domain (%d, %d)", _interface_offsets[NUM_FACES],
+             _geometry->getDomainIndexX(), _geometry->getDomainIndexY());
+}
+
+
+/**
+ * @brief Deletes the interface exits and entries.
+ */
+void TrackGenerator::deleteInterfaceFluxes() {
+
+  if (_interface_exits != NULL)
+    delete [] _interface_exits;
+
+  if (_interface_entries != NULL)
+    delete [] _interface_entries;
+
+  if (_interface_offsets != NULL)
+    delete [] _interface_offsets;
+
+  _interface_exits = NULL;
+  _interface_entries = NULL;
+  _interface_offsets = NULL;
+}
+
+
+/**
+ * @brief Deletes the Track cycles.
+ */
+void TrackGenerator::deleteTrackCycles() {
+
+  if (_track_cycles != NULL)
+    delete [] _track_cycles;
+
+  if (_track_cycle_offsets != NULL)
+    delete [] _track_cycle_offsets;
+
+  _track_cycles = NULL;
+  _track_cycle_offsets = NULL;
+  _num_track_cycles = 0;
 }
 
 
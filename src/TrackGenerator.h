@@ -16,12 +16,19 @@
 #endif
 #include "Track.h"
 #include "Geometry.h"
+#include "SegmentStore.h"
 #include "Quadrature.h"
 #include "Timer.h"
 #include "segmentation_type.h"
+#include "track_scheduling_type.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <queue>
+#include <vector>
 #include <unistd.h>
 #include <omp.h>
 #endif
@@ -103,6 +110,89 @@ protected:
   /** A buffer holding the computed FSR volumes */
   FP_PRECISION* _FSR_volumes;
 
+  /** Contiguous storage of all segments for streaming Track traversals */
+  SegmentStore* _segment_store;
+
+  /** Whether the SegmentStore is compressed once it has been filled */
+  bool _segment_compression;
+
+  /** The memory budget (MB) for explicit segments beyond which segments are
+   *  formed on-the-fly, or zero for no budget */
+  double _segment_memory_budget;
+
+  /** The total number of segments counted for on-the-fly ray tracing */
+  long _num_otf_segments;
+
+  /** The maximum number of segments on any Track */
+  int _max_num_segments;
+
+  /** The schedule by which the Tracks are distributed among threads */
+  trackSchedulingType _track_scheduling;
+
+  /** The number of threads for which the Track schedule was built, or zero
+   *  if it has not been built */
+  int _schedule_num_threads;
+
+  /** The UIDs of the Tracks assigned to each thread, in traversal order */
+  int* _schedule_tracks;
+
+  /** The offset of each thread's Tracks in the schedule, with the number of
+   *  Tracks in the last entry */
+  int* _schedule_offsets;
+
+  /** The number of Track cycles, or zero if they have not been built */
+  int _num_track_cycles;
+
+  /** The Track directions of each Track cycle in the order in which the
+   *  angular flux is transferred along it, each encoded as twice the Track's
+   *  UID plus one for the reverse direction */
+  int* _track_cycles;
+
+  /** The offset of each Track cycle in the Track cycles array, with the
+   *  number of Track directions in the last entry */
+  int* _track_cycle_offsets;
+
+  /** The boundary angular fluxes holding the outgoing flux of each Track
+   *  direction leaving through a face of a spatial domain, grouped by face
+   *  and each encoded as twice the UID of the Track holding it plus one for
+   *  its reverse direction */
+  int* _interface_exits;
+
+  /** The boundary angular fluxes receiving the incoming flux which enters
+   *  through the opposite face for each of the interface exits, encoded
+   *  as for the interface exits */
+  int* _interface_entries;
+
+  /** The offset of each face's interface exits, with the total number of
+   *  interface exits in the last entry */
+  int* _interface_offsets;
+
+  /** Whether the azimuthal angles are decomposed across MPI ranks */
+  bool _angular_decomposed;
+
+  /** The number of MPI ranks across which the azimuthal angles are
+   *  decomposed */
+  int _num_angle_ranks;
+
+  /** The rank of this process among the ranks decomposing the azimuthal
+   *  angles */
+  int _angle_rank;
+
+  /** The number of modules along the x-axis across which the Tracks are
+   *  laid down cyclically for modular ray tracing, or zero if not modular */
+  int _num_modules_x;
+
+  /** The number of modules along the y-axis across which the Tracks are
+   *  laid down cyclically for modular ray tracing, or zero if not modular */
+  int _num_modules_y;
+
+#ifdef MPIx
+  /** The MPI communicator of the ranks decomposing the azimuthal angles */
+  MPI_Comm _MPI_angles;
+
+  void synchronizeFSRs();
+#endif
+
   void computeEndPoint(Point* start, Point* end,  const double phi,
                        const double width_x, const double width_y);
 
@@ -114,6 +204,14 @@ protected:
   void initializeTrackCycleIndices(boundaryType bc);
   void initializeVolumes();
   void initializeFSRLocks();
+  void deleteSegmentStore();
+  void deleteTrackSchedule();
+  void deleteTrackCycles();
+  void initializeInterfaceFluxes();
+  void deleteInterfaceFluxes();
+  long estimateSweepCacheMisses(int cache_size, long& num_accesses);
+  double estimateSegmentMemory();
+  FP_PRECISION countSegments();
   void segmentize();
   void dumpTracksToFile();
   bool readTracksFromFile();
@@ -135,7 +233,7 @@ public:
   int getNumTracks();
   int getNumX(int azim);
   int getNumY(int azim);
-  int getNumSegments();
+  long getNumSegments();
   Track** getTracks();
   Track** getTracksArray();
   FP_PRECISION retrieveMaxOpticalLength();
@@ -145,7 +243,28 @@ public:
   FP_PRECISION getMaxOpticalLength();
   double getZCoord();
   omp_lock_t* getFSRLocks();
+  SegmentStore* getSegmentStore();
   segmentationType getSegmentFormation();
+  double getSegmentMemoryBudget();
+  bool isUsingSegmentCompression();
+  int getMaxNumSegments();
+  trackSchedulingType getTrackScheduling();
+  int getTrackScheduleNumThreads();
+  int* getTrackSchedule();
+  int* getTrackScheduleOffsets();
+  int getNumTrackCycles();
+  int* getTrackCycles();
+  int* getTrackCycleOffsets();
+  int* getInterfaceExits();
+  int* getInterfaceEntries();
+  int* getInterfaceOffsets();
+  bool isAngularDecomposed();
+  bool containsAzim(int azim);
+  int getNumAzimTracks(int azim);
+  bool isModularRayTracing();
+#ifdef MPIx
+  MPI_Comm getMPIAngles();
+#endif
 
   /* Set parameters */
   void setNumAzim(int num_azim);
@@ -155,6 +274,14 @@ public:
   void setNumThreads(int num_threads);
   void setZCoord(double z_coord);
   void setTracksFilenameSuffix(char* suffix);
+  void setSegmentFormation(segmentationType segmentation_type);
+  void setSegmentMemoryBudget(double megabytes);
+  void setSegmentCompression(bool compress);
+  void setTrackScheduling(trackSchedulingType track_scheduling);
+  void setModularRayTracing(int num_modules_x, int num_modules_y);
+#ifdef MPIx
+  void setAngularDecomposition();
+#endif
 
   /* Worker functions */
   bool containsTracks();
@@ -165,7 +292,12 @@ public:
   void generateFSRCentroids();
   void splitSegments(FP_PRECISION max_optical_length);
   void initializeSegments();
+  void initializeSegmentStore();
+  void installSegmentStore(SegmentStore* segment_store);
+  void initializeTrackSchedule(int num_threads);
+  void initializeTrackCycles();
   void printTimerReport();
+  void printSweepCacheReport(int cache_size);
   void resetFSRVolumes();
 };
 
@@ -28,6 +28,165 @@ void VolumeCalculator::execute() {
 }
 
 
+/**
+ * @brief Constructor for CentroidCalculator calls the TraverseTracks
+ *        constructor and sets the centroid coordinate arrays
+ * @param track_generator The TrackGenerator to pull tracking information from
+ * @param centroids_x The array of FSR centroid x-coordinates to add to
+ * @param centroids_y The array of FSR centroid y-coordinates to add to
+ */
+CentroidCalculator::CentroidCalculator(TrackGenerator* track_generator,
+                                       double* centroids_x,
+                                       double* centroids_y)
+                                      : TraverseTracks(track_generator) {
+  _centroids_x = centroids_x;
+  _centroids_y = centroids_y;
+}
+
+
+/**
+ * @brief FSR centroids are calculated and saved in the centroid arrays
+ * @details CentroidKernels are created and used to loop over all segments,
+ *          either stored or formed on-the-fly, and tally each segment's
+ *          contribution to the FSR centroids.
+ */
+void CentroidCalculator::execute() {
+#pragma omp parallel
+  {
+    CentroidKernel kernel(_track_generator, _centroids_x, _centroids_y);
+    loopOverTracks(&kernel);
+  }
+}
+
+
+/**
+ * @brief Constructor for SegmentCounter calls the TraverseTracks
+ *        constructor and sets the SegmentStore to size
+ * @param track_generator The TrackGenerator to pull tracking information from
+ * @param store The SegmentStore in which to register the segment counts, or
+ *        NULL if the counts are only to be totaled
+ */
+SegmentCounter::SegmentCounter(TrackGenerator* track_generator,
+                               SegmentStore* store)
+                              : TraverseTracks(track_generator) {
+  _store = store;
+  _kernels = new CounterKernel*[omp_get_max_threads()];
+  _num_segments = 0;
+  _max_num_segments = 0;
+  _max_optical_length = 0.;
+}
+
+
+/**
+ * @brief Destructor deletes the array of thread kernel pointers
+ */
+SegmentCounter::~SegmentCounter() {
+  delete [] _kernels;
+}
+
+
+/**
+ * @brief Returns the total number of segments counted across all Tracks.
+ * @return the total number of segments
+ */
+long SegmentCounter::getNumSegments() {
+  return _num_segments;
+}
+
+
+/**
+ * @brief Returns the maximum number of segments counted on any Track.
+ * @return the maximum number of segments on a Track
+ */
+int SegmentCounter::getMaxNumSegments() {
+  return _max_num_segments;
+}
+
+
+/**
+ * @brief Returns the maximum optical path length of any segment counted.
+ * @return the maximum optical path length before splitting
+ */
+FP_PRECISION SegmentCounter::getMaxOpticalLength() {
+  return _max_optical_length;
+}
+
+
+/**
+ * @brief The number of segments on each Track is counted and registered
+ *        with the SegmentStore
+ * @details CounterKernels are created and used to loop over all segments,
+ *          accounting for segments split by the maximum optical path length.
+ */
+void SegmentCounter::execute() {
+
+  _num_segments = 0;
+  _max_num_segments = 0;
+  _max_optical_length = 0.;
+
+#pragma omp parallel
+  {
+    CounterKernel kernel(_track_generator);
+    _kernels[omp_get_thread_num()] = &kernel;
+    loopOverTracks(&kernel);
+
+    /* Reduce the maximum optical path length across threads */
+#pragma omp critical
+    _max_optical_length = std::max(_max_optical_length,
+                                   kernel.getMaxOpticalLength());
+  }
+}
+
+
+/**
+ * @brief Registers the number of segments counted on a Track
+ * @param track The Track whose segments have been counted
+ * @param segments The segments on the Track
+ */
+void SegmentCounter::onTrack(Track* track, segment* segments) {
+
+  int count = _kernels[omp_get_thread_num()]->getCount();
+
+  if (_store != NULL)
+    _store->setNumSegments(track->getUid(), count);
+
+#pragma omp atomic update
+  _num_segments += count;
+
+  if (count > _max_num_segments) {
+#pragma omp critical
+    _max_num_segments = std::max(_max_num_segments, count);
+  }
+}
+
+
+/**
+ * @brief Constructor for SegmentStoreFiller calls the TraverseTracks
+ *        constructor and sets the SegmentStore to fill
+ * @param track_generator The TrackGenerator to pull tracking information from
+ * @param store The allocated SegmentStore to fill with segments
+ */
+SegmentStoreFiller::SegmentStoreFiller(TrackGenerator* track_generator,
+                                       SegmentStore* store)
+                                      : TraverseTracks(track_generator) {
+  _store = store;
+}
+
+
+/**
+ * @brief All segments are written into the SegmentStore
+ * @details SegmentationKernels are created and used to loop over all
+ *          segments, writing each into its Track's range of the SegmentStore.
+ */
+void SegmentStoreFiller::execute() {
+#pragma omp parallel
+  {
+    SegmentationKernel kernel(_track_generator, _store);
+    loopOverTracks(&kernel);
+  }
+}
+
+
 /**
  * @brief Constructor for TransportSweep calls the TraverseTracks
  *        constructor and allocates temporary memory for local scalar fluxes
@@ -36,6 +195,16 @@ void VolumeCalculator::execute() {
 TransportSweep::TransportSweep(TrackGenerator* track_generator)
                               : TraverseTracks(track_generator) {
   _cpu_solver = NULL;
+  _thread_track_fluxes = NULL;
+  _track_flux_width = 0;
+  _thread_segments = NULL;
+  _kernels = NULL;
+  _sweep_track = NULL;
+  _sweep_segments = NULL;
+
+  if (_segment_formation != OTF_2D && _segment_store == NULL)
+    log_printf(ERROR, "Unable to sweep Tracks before the TrackGenerator has "
+               "built its SegmentStore");
 
   /* Allocate temporary storage of FSR fluxes */
   int num_threads = omp_get_max_threads();
@@ -47,29 +216,77 @@ TransportSweep::TransportSweep(TrackGenerator* track_generator)
   int array_width = num_groups + 8;
   for (int i=0; i < num_threads; i++)
     _thread_fsr_fluxes[i] = new FP_PRECISION[array_width];
+
+  /* Allocate a buffer for the longest Track's segments for each thread */
+  if (_segment_formation == OTF_2D) {
+    _thread_segments = new SegmentStore*[num_threads];
+    _kernels = new MOCKernel*[num_threads];
+    for (int i=0; i < num_threads; i++) {
+      _thread_segments[i] = new SegmentStore(1);
+      _thread_segments[i]->setMaterials(_geometry->getAllMaterials());
+      _thread_segments[i]->setNumSegments(0,
+          track_generator->getMaxNumSegments());
+      _thread_segments[i]->allocate();
+    }
+  }
 }
 
 
 /**
- * @brief Destructor deletes temporary storage of local scalar fluxes
+ * @brief Destructor deletes temporary storage of local scalar fluxes and
+ *        on-the-fly segments
  */
 TransportSweep::~TransportSweep() {
   int num_threads = omp_get_max_threads();
   for (int i=0; i < num_threads; i++)
     delete [] _thread_fsr_fluxes[i];
   delete [] _thread_fsr_fluxes;
+
+  if (_thread_track_fluxes != NULL) {
+    for (int i=0; i < num_threads; i++)
+      delete [] _thread_track_fluxes[i];
+    delete [] _thread_track_fluxes;
+  }
+
+  if (_thread_segments != NULL) {
+    for (int i=0; i < num_threads; i++)
+      delete _thread_segments[i];
+    delete [] _thread_segments;
+    delete [] _kernels;
+  }
 }
 
 
 /**
  * @brief MOC equations are applied to every segment in the TrackGenerator
  * @details onTrack(...) applies the MOC equations to each segment and
- *          transfers boundary fluxes for the corresponding Track.
+ *          transfers boundary fluxes for the corresponding Track. With
+ *          on-the-fly segmentation, SegmentationKernels first ray trace each
+ *          Track into the thread's buffer. If the CPUSolver stores its
+ *          boundary fluxes in a single array, the Track directions are swept
+ *          along the Track cycles instead.
  */
 void TransportSweep::execute() {
+
+  /* Select the MOC kernels once for all Tracks */
+  selectSweepTrack();
+  bool sweep_cycles = (_cpu_solver->getCycleChunkOffsets() != NULL);
+
 #pragma omp parallel
   {
-    loopOverTracks(NULL);
+    if (_segment_formation == OTF_2D) {
+      int tid = omp_get_thread_num();
+      SegmentationKernel kernel(_track_generator, _thread_segments[tid]);
+      _kernels[tid] = &kernel;
+      if (sweep_cycles)
+        sweepTrackCycles();
+      else
+        loopOverTracks(&kernel);
+    }
+    else if (sweep_cycles)
+      sweepTrackCycles();
+    else
+      loopOverTracks(NULL);
   }
 }
 
@@ -82,17 +299,90 @@ void TransportSweep::execute() {
  */
 void TransportSweep::setCPUSolver(CPUSolver* cpu_solver) {
   _cpu_solver = cpu_solver;
+  _track_flux_width = cpu_solver->getNumPolarAngles() / 2 *
+                      _geometry->getNumEnergyGroups();
+
+  /* Allocate two angular flux buffers for each thread, padded to avoid false
+   * sharing conflicts, to sweep along the Track cycles or in double
+   * precision for mixed precision builds */
+  bool allocate = (cpu_solver->getCycleChunkOffsets() != NULL);
+#ifdef MIXED
+  allocate = true;
+#endif
+  if (allocate) {
+    int num_threads = omp_get_max_threads();
+    _thread_track_fluxes = new FP_PRECISION*[num_threads];
+    for (int i=0; i < num_threads; i++)
+      _thread_track_fluxes[i] = new FP_PRECISION[2 * (_track_flux_width + 8)];
+  }
+}
+
+
+/**
+ * @brief Returns the angular flux to sweep along a Track in one direction.
+ * @details The CPUSolver's boundary flux is swept in place unless it is
+ *          stored in single precision in a mixed precision build, in which
+ *          case it is copied into the thread's double precision buffer.
+ * @param track_id The Track's unique ID
+ * @param fwd Whether to sweep the Track forward (true) or backward (false)
+ * @return a pointer to the angular flux to sweep
+ */
+FP_PRECISION* TransportSweep::getTrackFlux(int track_id, bool fwd) {
+
+  FP_STORAGE* boundary_flux = _cpu_solver->getBoundaryFlux(track_id, fwd);
+
+#ifdef MIXED
+  FP_PRECISION* track_flux = _thread_track_fluxes[omp_get_thread_num()];
+  for (int i=0; i < _track_flux_width; i++)
+    track_flux[i] = boundary_flux[i];
+  return track_flux;
+#else
+  return boundary_flux;
+#endif
+}
+
+
+/**
+ * @brief Finds the segments of a Track to sweep.
+ * @details The segments are read from the Track's range of the SegmentStore,
+ *          from the thread's on-the-fly buffer into which the Track has been
+ *          ray traced, or from the thread's buffer into which the Track is
+ *          decoded if the SegmentStore is compressed.
+ * @param track The Track whose segments are swept
+ * @param start The index of the Track's first segment in the returned store
+ * @param end The index one past the Track's last segment in the returned
+ *        store
+ * @return the SegmentStore holding the Track's segments
+ */
+SegmentStore* TransportSweep::getTrackSegments(Track* track, long* start,
+                                               long* end) {
+
+  int tid = omp_get_thread_num();
+  int track_id = track->getUid();
+
+  if (_segment_formation == OTF_2D) {
+    *start = 0;
+    *end = _kernels[tid]->getCount();
+    return _thread_segments[tid];
+  }
+
+  SegmentStore* buffer = NULL;
+  if (_decoded_segments != NULL)
+    buffer = _decoded_segments[tid];
+
+  return _segment_store->getTrackSegments(track_id, buffer, start, end);
 }
 
 
 /**
  * @brief Applies the MOC equations the Track and segments
- * @details The MOC equations are applied to each segment, attenuating the
- *          Track's angular flux and tallying FSR contributions. Finally,
- *          Track boundary fluxes are transferred.
+ * @details The MOC equations are applied to each segment, streamed from the
+ *          Track's range of the SegmentStore or from the thread's on-the-fly
+ *          or decoded buffer, with the sweep selected for this transport
+ *          sweep.
  * @param track The Track for which the angular flux is attenuated and
  *        transferred
- * @param segments The segments over which the MOC equations are applied
+ * @param segments The segments owned by the Track (unused)
  */
 void TransportSweep::onTrack(Track* track, segment* segments) {
 
@@ -100,40 +390,362 @@ void TransportSweep::onTrack(Track* track, segment* segments) {
   int tid = omp_get_thread_num();
   FP_PRECISION* thread_fsr_flux = _thread_fsr_fluxes[tid];
 
+  /* Find the Track's segments */
+  long start, end;
+  SegmentStore* store = getTrackSegments(track, &start, &end);
+
+  /* Apply the MOC equations to the Track's segments */
+  (this->*_sweep_track)(track, store, start, end, thread_fsr_flux);
+}
+
+
+/**
+ * @brief Sweeps the chunks of the TrackGenerator's Track cycles assigned to
+ *        this thread.
+ * @details Each chunk's Track directions are swept in the order in which the
+ *          angular flux is transferred along the cycle. The thread sweeps
+ *          each Track direction in a buffer holding its incoming flux, staged
+ *          for the first Track direction of the chunk by the CPUSolver. The
+ *          incoming flux of the next Track direction is copied into the
+ *          thread's second buffer before the outgoing flux is transferred
+ *          into the same location of the CPUSolver's single boundary flux
+ *          array, such that each Track direction is swept with the incoming
+ *          flux of the previous transport sweep. With GAUSS_SEIDEL boundary
+ *          fluxes, each Track direction is instead swept with the outgoing
+ *          flux of the previous Track direction left in the thread's buffer.
+ *          With on-the-fly segmentation, each Track direction is ray traced
+ *          in turn.
+ */
+void TransportSweep::sweepTrackCycles() {
+
+  int tid = omp_get_thread_num();
+  FP_PRECISION* thread_fsr_flux = _thread_fsr_fluxes[tid];
+  FP_PRECISION* track_flux = _thread_track_fluxes[tid];
+  FP_PRECISION* next_track_flux = &track_flux[_track_flux_width + 8];
+
+  Track** tracks = _track_generator->getTracksArray();
+  int* cycles = _track_generator->getTrackCycles();
+  int* chunk_offsets = _cpu_solver->getCycleChunkOffsets();
+  int num_chunks = _cpu_solver->getNumCycleChunks();
+  bool gauss_seidel = (_cpu_solver->getBoundaryFluxUpdate() == GAUSS_SEIDEL);
+
+#pragma omp for schedule(dynamic)
+  for (int k=0; k < num_chunks; k++) {
+
+    /* Load the staged incoming flux of the chunk's first Track direction */
+    FP_STORAGE* boundary_flux = _cpu_solver->getCycleChunkFlux(k);
+    for (int i=0; i < _track_flux_width; i++)
+      track_flux[i] = (boundary_flux == NULL) ? 0. : boundary_flux[i];
+
+    for (int c=chunk_offsets[k]; c < chunk_offsets[k+1]; c++) {
+
+      Track* track = tracks[cycles[c] / 2];
+      bool fwd = (cycles[c] % 2 == 0);
+
+      /* Find the Track's segments, ray tracing them if necessary */
+      if (_segment_formation == OTF_2D) {
+        _kernels[tid]->newTrack(track);
+        _geometry->segmentize(track, _kernels[tid]);
+      }
+      long start, end;
+      SegmentStore* store = getTrackSegments(track, &start, &end);
+
+      /* Apply the MOC equations to the Track's segments */
+      (this->*_sweep_segments)(track, store, start, end, fwd, track_flux,
+                               thread_fsr_flux);
+
+      /* Load the next Track direction's incoming flux before it is
+       * overwritten by the outgoing flux */
+      if (!gauss_seidel && c+1 < chunk_offsets[k+1]) {
+        boundary_flux = _cpu_solver->getBoundaryFlux(cycles[c+1] / 2,
+                                                     cycles[c+1] % 2 == 0);
+        for (int i=0; i < _track_flux_width; i++)
+          next_track_flux[i] = (boundary_flux == NULL) ? 0. :
+                               boundary_flux[i];
+      }
+
+      /* Transfer the outgoing flux to the next Track direction */
+      bool transfer = fwd ? track->getTransferFluxOut() :
+                            track->getTransferFluxIn();
+      if (transfer) {
+        Track* track_out = fwd ? track->getTrackOut() : track->getTrackIn();
+        bool next_fwd = !(fwd ? track->isNextOut() : track->isNextIn());
+        boundary_flux = _cpu_solver->getBoundaryFlux(track_out->getUid(),
+                                                     next_fwd);
+        for (int i=0; i < _track_flux_width; i++)
+          boundary_flux[i] = track_flux[i];
+      }
+
+      /* Sweep the next Track direction with the outgoing flux */
+      if (!gauss_seidel)
+        std::swap(track_flux, next_track_flux);
+    }
+  }
+}
+
+
+/**
+ * @brief Selects the sweep over each Track's segments for the CPUSolver's
+ *        number of energy groups and polar angles.
+ * @details Instantiations with the loop bounds fixed at compile time are
+ *          provided for common numbers of energy groups and polar angles,
+ *          while other problems use runtime loop bounds. CPUSolvers which
+ *          override the virtual MOC kernels use the virtual sweep.
+ */
+void TransportSweep::selectSweepTrack() {
+
+  int num_groups = _geometry->getNumEnergyGroups();
+  int num_polar_2 = _cpu_solver->getNumPolarAngles() / 2;
+
+  if (!_cpu_solver->usesTemplatedKernels()) {
+    _sweep_track = &TransportSweep::sweepTrack;
+    _sweep_segments = &TransportSweep::sweepSegments;
+    return;
+  }
+
+  selectSweepTrackFixed<0, 0>();
+
+  if (num_groups == 1) {
+    if (num_polar_2 == 1)
+      selectSweepTrackFixed<1, 1>();
+    else if (num_polar_2 == 2)
+      selectSweepTrackFixed<1, 2>();
+    else if (num_polar_2 == 3)
+      selectSweepTrackFixed<1, 3>();
+  }
+  else if (num_polar_2 == 3) {
+    if (num_groups == 2)
+      selectSweepTrackFixed<2, 3>();
+    else if (num_groups == 7)
+      selectSweepTrackFixed<7, 3>();
+    else if (num_groups == 8)
+      selectSweepTrackFixed<8, 3>();
+    else if (num_groups == 70)
+      selectSweepTrackFixed<70, 3>();
+  }
+}
+
+
+/**
+ * @brief Selects the sweeps over a Track's segments templated on the number
+ *        of energy groups and polar angles for the CPUSolver's flux
+ *        accumulation scheme.
+ */
+template <int NUM_GROUPS, int NUM_POLAR_2>
+void TransportSweep::selectSweepTrackFixed() {
+
+  fluxAccumulationType accumulation = _cpu_solver->getFluxAccumulation();
+
+  if (accumulation == ATOMIC_UPDATES)
+    selectSweepTrackAccumulation<NUM_GROUPS, NUM_POLAR_2, ATOMIC_UPDATES>();
+  else if (accumulation == THREAD_PRIVATE)
+    selectSweepTrackAccumulation<NUM_GROUPS, NUM_POLAR_2, THREAD_PRIVATE>();
+  else
+    selectSweepTrackAccumulation<NUM_GROUPS, NUM_POLAR_2, FSR_LOCKS>();
+}
+
+
+/**
+ * @brief Selects the sweeps over a Track's segments in both directions and
+ *        in one direction templated on the number of energy groups and polar
+ *        angles and on the flux accumulation scheme.
+ */
+template <int NUM_GROUPS, int NUM_POLAR_2, fluxAccumulationType ACCUMULATION>
+void TransportSweep::selectSweepTrackAccumulation() {
+  _sweep_track =
+      &TransportSweep::sweepTrackFixed<NUM_GROUPS, NUM_POLAR_2, ACCUMULATION>;
+  _sweep_segments =
+      &TransportSweep::sweepSegmentsFixed<NUM_GROUPS, NUM_POLAR_2,
+                                          ACCUMULATION>;
+}
+
+
+/**
+ * @brief Applies the MOC equations to a Track's segments with the CPUSolver's
+ *        virtual MOC kernels
+ * @param track The Track for which the angular flux is attenuated and
+ *        transferred
+ * @param store The SegmentStore holding the Track's segments
+ * @param start The index of the Track's first segment in the store
+ * @param end The index one past the Track's last segment in the store
+ * @param thread_fsr_flux The thread's temporary FSR scalar flux buffer
+ */
+void TransportSweep::sweepTrack(Track* track, SegmentStore* store, long start,
+                                long end, FP_PRECISION* thread_fsr_flux) {
+
   /* Extract Track information */
   int track_id = track->getUid();
   int azim_index = track->getAzimAngleIndex();
-  int num_segments = track->getNumSegments();
   FP_PRECISION* track_flux;
 
-  /* Correct azimuthal index to first octant */
-  Quadrature* quad = _track_generator->getQuadrature();
+  /* Sweep the forward track flux */
+  track_flux = getTrackFlux(track_id, true);
+  sweepSegments(track, store, start, end, true, track_flux, thread_fsr_flux);
 
-  /* Get the forward track flux */
-  track_flux = _cpu_solver->getBoundaryFlux(track_id, true);
+  /* Transfer boundary angular flux to outgoing Track */
+  _cpu_solver->transferBoundaryFlux(track_id, azim_index, true, track_flux);
 
-  /* Loop over each Track segment in forward direction */
-  for (int s=0; s < num_segments; s++) {
-    segment* curr_segment = &segments[s];
-    _cpu_solver->tallyScalarFlux(curr_segment, azim_index, track_flux,
-                                 thread_fsr_flux);
-    _cpu_solver->tallyCurrent(curr_segment, azim_index, track_flux, true);
-  }
+  /* Sweep the backward track flux */
+  track_flux = getTrackFlux(track_id, false);
+  sweepSegments(track, store, start, end, false, track_flux, thread_fsr_flux);
 
   /* Transfer boundary angular flux to outgoing Track */
-  _cpu_solver->transferBoundaryFlux(track_id, azim_index, true, track_flux);
+  _cpu_solver->transferBoundaryFlux(track_id, azim_index, false, track_flux);
+}
+
 
-  /* Get the backward track flux */
-  track_flux = _cpu_solver->getBoundaryFlux(track_id, false);
+/**
+ * @brief Applies the MOC equations to a Track's segments in one direction
+ *        with the CPUSolver's virtual MOC kernels
+ * @param track The Track for which the angular flux is attenuated
+ * @param store The SegmentStore holding the Track's segments
+ * @param start The index of the Track's first segment in the store
+ * @param end The index one past the Track's last segment in the store
+ * @param fwd Whether to sweep the Track forward (true) or backward (false)
+ * @param track_flux The angular flux swept along the Track
+ * @param thread_fsr_flux The thread's temporary FSR scalar flux buffer
+ */
+void TransportSweep::sweepSegments(Track* track, SegmentStore* store,
+                                   long start, long end, bool fwd,
+                                   FP_PRECISION* track_flux,
+                                   FP_PRECISION* thread_fsr_flux) {
+
+  int azim_index = track->getAzimAngleIndex();
+
+  /* Extract the segment arrays */
+  FP_STORAGE* lengths = store->getLengths();
+  int* material_indices = store->getMaterialIndices();
+  int* region_ids = store->getRegionIds();
+  int* cmfd_surfaces_fwd = store->getCmfdSurfacesFwd();
+  int* cmfd_surfaces_bwd = store->getCmfdSurfacesBwd();
+  Material** materials = store->getMaterials();
+  FP_PRECISION* sigma_t;
+
+  /* Loop over each Track segment in forward direction */
+  if (fwd) {
+    for (long s=start; s < end; s++) {
+      sigma_t = materials[material_indices[s]]->getSigmaT();
+      _cpu_solver->tallyScalarFlux(lengths[s], region_ids[s], sigma_t,
+                                   azim_index, track_flux, thread_fsr_flux);
+      _cpu_solver->tallyCurrent(cmfd_surfaces_fwd[s], azim_index, track_flux,
+                                true);
+    }
+  }
 
   /* Loop over each Track segment in reverse direction */
-  for (int s=num_segments-1; s >= 0; s--) {
-    segment* curr_segment = &segments[s];
-    _cpu_solver->tallyScalarFlux(curr_segment, azim_index, track_flux,
-                                 thread_fsr_flux);
-    _cpu_solver->tallyCurrent(curr_segment, azim_index, track_flux, false);
+  else {
+    for (long s=end-1; s >= start; s--) {
+      sigma_t = materials[material_indices[s]]->getSigmaT();
+      _cpu_solver->tallyScalarFlux(lengths[s], region_ids[s], sigma_t,
+                                   azim_index, track_flux, thread_fsr_flux);
+      _cpu_solver->tallyCurrent(cmfd_surfaces_bwd[s], azim_index, track_flux,
+                                false);
+    }
   }
+}
+
+
+/**
+ * @brief Applies the MOC equations to a Track's segments with the CPUSolver's
+ *        MOC kernels templated on the number of energy groups and polar
+ *        angles
+ * @details The MOC kernels are called without virtual dispatch, and with
+ *          the loop bounds fixed at compile time unless a template parameter
+ *          is zero. The flux accumulation scheme is fixed at compile time.
+ *          CMFD currents are only tallied for segments crossing a CMFD
+ *          surface.
+ * @param track The Track for which the angular flux is attenuated and
+ *        transferred
+ * @param store The SegmentStore holding the Track's segments
+ * @param start The index of the Track's first segment in the store
+ * @param end The index one past the Track's last segment in the store
+ * @param thread_fsr_flux The thread's temporary FSR scalar flux buffer
+ */
+template <int NUM_GROUPS, int NUM_POLAR_2, fluxAccumulationType ACCUMULATION>
+void TransportSweep::sweepTrackFixed(Track* track, SegmentStore* store,
+                                     long start, long end,
+                                     FP_PRECISION* thread_fsr_flux) {
+
+  /* Extract Track information */
+  int track_id = track->getUid();
+  int azim_index = track->getAzimAngleIndex();
+  FP_PRECISION* track_flux;
+
+  /* Sweep the forward track flux */
+  track_flux = getTrackFlux(track_id, true);
+  sweepSegmentsFixed<NUM_GROUPS, NUM_POLAR_2, ACCUMULATION>
+      (track, store, start, end, true, track_flux, thread_fsr_flux);
 
   /* Transfer boundary angular flux to outgoing Track */
-  _cpu_solver->transferBoundaryFlux(track_id, azim_index, false, track_flux);
+  _cpu_solver->transferBoundaryFluxFixed<NUM_GROUPS, NUM_POLAR_2>
+      (track_id, azim_index, true, track_flux);
+
+  /* Sweep the backward track flux */
+  track_flux = getTrackFlux(track_id, false);
+  sweepSegmentsFixed<NUM_GROUPS, NUM_POLAR_2, ACCUMULATION>
+      (track, store, start, end, false, track_flux, thread_fsr_flux);
+
+  /* Transfer boundary angular flux to outgoing Track */
+  _cpu_solver->transferBoundaryFluxFixed<NUM_GROUPS, NUM_POLAR_2>
+      (track_id, azim_index, false, track_flux);
+}
+
+
+/**
+ * @brief Applies the MOC equations to a Track's segments in one direction
+ *        with the CPUSolver's MOC kernels templated on the number of energy
+ *        groups and polar angles
+ * @param track The Track for which the angular flux is attenuated
+ * @param store The SegmentStore holding the Track's segments
+ * @param start The index of the Track's first segment in the store
+ * @param end The index one past the Track's last segment in the store
+ * @param fwd Whether to sweep the Track forward (true) or backward (false)
+ * @param track_flux The angular flux swept along the Track
+ * @param thread_fsr_flux The thread's temporary FSR scalar flux buffer
+ */
+template <int NUM_GROUPS, int NUM_POLAR_2, fluxAccumulationType ACCUMULATION>
+void TransportSweep::sweepSegmentsFixed(Track* track, SegmentStore* store,
+                                        long start, long end, bool fwd,
+                                        FP_PRECISION* track_flux,
+                                        FP_PRECISION* thread_fsr_flux) {
+
+  int azim_index = track->getAzimAngleIndex();
+
+  /* Extract the segment arrays */
+  FP_STORAGE* lengths = store->getLengths();
+  int* material_indices = store->getMaterialIndices();
+  int* region_ids = store->getRegionIds();
+  int* cmfd_surfaces_fwd = store->getCmfdSurfacesFwd();
+  int* cmfd_surfaces_bwd = store->getCmfdSurfacesBwd();
+  Material** materials = store->getMaterials();
+  FP_PRECISION* sigma_t;
+  bool tally_currents = _cpu_solver->isTallyingCurrents();
+
+  /* Loop over each Track segment in forward direction */
+  if (fwd) {
+    for (long s=start; s < end; s++) {
+      sigma_t = materials[material_indices[s]]->getSigmaT();
+      _cpu_solver->tallyScalarFluxFixed<NUM_GROUPS, NUM_POLAR_2,
+                                        ACCUMULATION>
+          (lengths[s], region_ids[s], sigma_t, azim_index, track_flux,
+           thread_fsr_flux);
+      if (tally_currents && cmfd_surfaces_fwd[s] != -1)
+        _cpu_solver->tallyCurrentFixed(cmfd_surfaces_fwd[s], azim_index,
+                                       track_flux);
+    }
+  }
+
+  /* Loop over each Track segment in reverse direction */
+  else {
+    for (long s=end-1; s >= start; s--) {
+      sigma_t = materials[material_indices[s]]->getSigmaT();
+      _cpu_solver->tallyScalarFluxFixed<NUM_GROUPS, NUM_POLAR_2,
+                                        ACCUMULATION>
+          (lengths[s], region_ids[s], sigma_t, azim_index, track_flux,
+           thread_fsr_flux);
+      if (tally_currents && cmfd_surfaces_bwd[s] != -1)
+        _cpu_solver->tallyCurrentFixed(cmfd_surfaces_bwd[s], azim_index,
+                                       track_flux);
+    }
+  }
 }
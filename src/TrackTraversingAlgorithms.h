@@ -20,6 +20,7 @@
 #define TRACK_TRAVERSING_ALGORITHMS_H_
 
 #include "TraverseTracks.h"
+#include "flux_accumulation_type.h"
 
 
 /** Forward declaration of CPUSolver class */
@@ -44,6 +45,94 @@ public:
 };
 
 
+/**
+ * @class CentroidCalculator TrackTraversingAlgorithms.h
+ *        "src/TrackTraversingAlgorithms.h"
+ * @brief A class used to calculate FSR centroids
+ * @details A CentroidCalculator allocates CentroidKernels to add the
+ *          weighted midpoints of all segments to the provided arrays of FSR
+ *          centroid coordinates, which must be zeroed beforehand.
+ */
+class CentroidCalculator: public TraverseTracks {
+
+private:
+
+  /** The arrays of FSR centroid x and y coordinates */
+  double* _centroids_x;
+  double* _centroids_y;
+
+public:
+
+  CentroidCalculator(TrackGenerator* track_generator, double* centroids_x,
+                     double* centroids_y);
+  void execute();
+};
+
+
+/**
+ * @class SegmentCounter TrackTraversingAlgorithms.h
+ *        "src/TrackTraversingAlgorithms.h"
+ * @brief A class used to count the number of segments on each Track
+ * @details A SegmentCounter applies CounterKernels to all segments and
+ *          registers the number of segments on each Track with the provided
+ *          SegmentStore so that its arrays may be allocated. The total and
+ *          maximum number of segments per Track and the maximum optical path
+ *          length are also computed, which is used to size the buffers for
+ *          on-the-fly ray tracing when no SegmentStore is provided.
+ */
+class SegmentCounter: public TraverseTracks {
+
+private:
+
+  /** The SegmentStore in which to register the segment counts, if any */
+  SegmentStore* _store;
+
+  /** The CounterKernel used by each thread */
+  CounterKernel** _kernels;
+
+  /** The total number of segments across all Tracks */
+  long _num_segments;
+
+  /** The maximum number of segments on any Track */
+  int _max_num_segments;
+
+  /** The maximum optical path length of any segment */
+  FP_PRECISION _max_optical_length;
+
+public:
+
+  SegmentCounter(TrackGenerator* track_generator, SegmentStore* store=NULL);
+  virtual ~SegmentCounter();
+  long getNumSegments();
+  int getMaxNumSegments();
+  FP_PRECISION getMaxOpticalLength();
+  void execute();
+  void onTrack(Track* track, segment* segments);
+};
+
+
+/**
+ * @class SegmentStoreFiller TrackTraversingAlgorithms.h
+ *        "src/TrackTraversingAlgorithms.h"
+ * @brief A class used to fill a SegmentStore with the segments of all Tracks
+ * @details A SegmentStoreFiller applies SegmentationKernels to all segments,
+ *          writing them into a SegmentStore previously sized by a
+ *          SegmentCounter.
+ */
+class SegmentStoreFiller: public TraverseTracks {
+
+private:
+
+  /** The SegmentStore to fill */
+  SegmentStore* _store;
+
+public:
+
+  SegmentStoreFiller(TrackGenerator* track_generator, SegmentStore* store);
+  void execute();
+};
+
+
 /**
  * @class TransportSweep TrackTraversingAlgorithms.h
  *        "src/TrackTraversingAlgorithms.h"
@@ -52,6 +141,15 @@ public:
  *          using a provided CPUSolver, it applies the MOC equations to each
  *          segment, tallying the contributions to each FSR. At the end of each
  *          Track, boundary fluxes are exchanged based on boundary conditions.
+ *          With on-the-fly segmentation, the segments of each Track are
+ *          first ray traced into a SegmentStore buffer owned by each thread.
+ *          The sweep over each Track's segments is selected once for each
+ *          transport sweep from instantiations templated on the flux
+ *          accumulation scheme and on common numbers of energy groups and
+ *          polar angles, falling back to runtime loop bounds for other
+ *          problems. If the CPUSolver stores its boundary fluxes in a single
+ *          array, the Track directions are instead swept in chunks along the
+ *          TrackGenerator's Track cycles.
  */
 class TransportSweep: public TraverseTracks {
 
@@ -60,6 +158,58 @@ private:
   CPUSolver* _cpu_solver;
   FP_PRECISION** _thread_fsr_fluxes;
 
+  /** The buffers for each thread in which a Track's stored angular flux is
+   *  swept in double precision for mixed precision builds, or in which the
+   *  incoming and next incoming angular fluxes are staged when sweeping
+   *  along the Track cycles */
+  FP_PRECISION** _thread_track_fluxes;
+
+  /** The number of angular flux values stored per Track direction */
+  int _track_flux_width;
+
+  /** The single Track SegmentStore buffer for each thread used for
+   *  on-the-fly ray tracing */
+  SegmentStore** _thread_segments;
+
+  /** The SegmentationKernel used by each thread to fill its buffer */
+  MOCKernel** _kernels;
+
+  /** The sweep over a Track's segments selected for this transport sweep */
+  void (TransportSweep::*_sweep_track)(Track* track, SegmentStore* store,
+                                       long start, long end,
+                                       FP_PRECISION* thread_fsr_flux);
+
+  /** The sweep over a Track's segments in one direction selected for this
+   *  transport sweep */
+  void (TransportSweep::*_sweep_segments)(Track* track, SegmentStore* store,
+                                          long start, long end, bool fwd,
+                                          FP_PRECISION* track_flux,
+                                          FP_PRECISION* thread_fsr_flux);
+
+  void selectSweepTrack();
+  template <int NUM_GROUPS, int NUM_POLAR_2>
+  void selectSweepTrackFixed();
+  template <int NUM_GROUPS, int NUM_POLAR_2,
+            fluxAccumulationType ACCUMULATION>
+  void selectSweepTrackAccumulation();
+  FP_PRECISION* getTrackFlux(int track_id, bool fwd);
+  SegmentStore* getTrackSegments(Track* track, long* start, long* end);
+  void sweepTrack(Track* track, SegmentStore* store, long start, long end,
+                  FP_PRECISION* thread_fsr_flux);
+  void sweepSegments(Track* track, SegmentStore* store, long start, long end,
+                     bool fwd, FP_PRECISION* track_flux,
+                     FP_PRECISION* thread_fsr_flux);
+  template <int NUM_GROUPS, int NUM_POLAR_2,
+            fluxAccumulationType ACCUMULATION>
+  void sweepTrackFixed(Track* track, SegmentStore* store, long start,
+                       long end, FP_PRECISION* thread_fsr_flux);
+  template <int NUM_GROUPS, int NUM_POLAR_2,
+            fluxAccumulationType ACCUMULATION>
+  void sweepSegmentsFixed(Track* track, SegmentStore* store, long start,
+                          long end, bool fwd, FP_PRECISION* track_flux,
+                          FP_PRECISION* thread_fsr_flux);
+  void sweepTrackCycles();
+
 public:
 
   TransportSweep(TrackGenerator* track_generator);
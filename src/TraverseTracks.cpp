@@ -6,11 +6,27 @@
  */
 TraverseTracks::TraverseTracks(TrackGenerator* track_generator) {
 
-  /* Save the track generator */
+  /* Save the track generator and geometry */
   _track_generator = track_generator;
+  _geometry = track_generator->getGeometry();
 
   /* Determine the type of segment formation used */
   _segment_formation = track_generator->getSegmentFormation();
+
+  /* Stream segments from the SegmentStore if one has been built */
+  _segment_store = track_generator->getSegmentStore();
+
+  _schedule_cursors = NULL;
+  _decoded_segments = NULL;
+
+  /* Allocate a buffer for the longest Track's decoded segments for each
+   * thread if the SegmentStore is compressed */
+  if (_segment_store != NULL && _segment_store->isCompressed()) {
+    int num_threads = omp_get_max_threads();
+    _decoded_segments = new SegmentStore*[num_threads];
+    for (int i=0; i < num_threads; i++)
+      _decoded_segments[i] = _segment_store->createTrackBuffer();
+  }
 }
 
 
@@ -18,6 +34,14 @@ TraverseTracks::TraverseTracks(TrackGenerator* track_generator) {
  * @brief Destructor for TraverseTracks
  */
 TraverseTracks::~TraverseTracks() {
+  if (_schedule_cursors != NULL)
+    delete [] _schedule_cursors;
+
+  if (_decoded_segments != NULL) {
+    for (int i=0; i < omp_get_max_threads(); i++)
+      delete _decoded_segments[i];
+    delete [] _decoded_segments;
+  }
 }
 
 
@@ -26,13 +50,19 @@ TraverseTracks::~TraverseTracks() {
  *        the functionality described in onTrack(...) to all Tracks.
  * @details The segment formation method imported from the TrackGenerator
  *          during construction is used to redirect to the appropriate looping
- *          scheme.
+ *          scheme. Unless the TrackGenerator uses AZIMUTHAL_SCHEDULING, the
+ *          Tracks of all azimuthal angles are traversed from the
+ *          TrackGenerator's segment-weighted Track schedule.
  * @param kernel The MOCKernel to apply to all segments
  */
 void TraverseTracks::loopOverTracks(MOCKernel* kernel) {
   switch (_segment_formation) {
     case EXPLICIT_2D:
-      loopOverTracks2D(kernel);
+    case OTF_2D:
+      if (_track_generator->getTrackScheduling() == AZIMUTHAL_SCHEDULING)
+        loopOverTracks2D(kernel);
+      else
+        loopOverTrackSchedule(kernel);
       break;
     default:
       log_printf(ERROR, "Segment formation type not currently supported");
@@ -41,10 +71,12 @@ void TraverseTracks::loopOverTracks(MOCKernel* kernel) {
 
 
 /**
- * @brief Loops over all explicit 2D Tracks
+ * @brief Loops over all 2D Tracks
  * @details The onTrack(...) function is applied to all 2D Tracks and the
  *          specified kernel is applied to all segments. If NULL is provided
  *          for the kernel, only the onTrack(...) functionality is applied.
+ *          With on-the-fly segmentation, the segments are formed by ray
+ *          tracing each Track as the kernel is applied.
  * @param kernel The MOCKernel to apply to all segments
  */
 void TraverseTracks::loopOverTracks2D(MOCKernel* kernel) {
@@ -53,39 +85,142 @@ void TraverseTracks::loopOverTracks2D(MOCKernel* kernel) {
   Track** tracks_2D = _track_generator->getTracks();
   int num_azim = _track_generator->getNumAzim();
   for (int a=0; a < num_azim/2; a++) {
-    int num_xy = _track_generator->getNumX(a) + _track_generator->getNumY(a);
+    int num_xy = _track_generator->getNumAzimTracks(a);
 #pragma omp for
-    for (int i=0; i < num_xy; i++) {
+    for (int i=0; i < num_xy; i++)
+      applyToTrack(&tracks_2D[a][i], kernel);
+  }
+}
 
-      Track* track_2D = &tracks_2D[a][i];
 
-      /* Apply the kernel to segments if necessary */
-      if (kernel != NULL) {
-        kernel->newTrack(track_2D);
-        traceSegmentsExplicit(track_2D, kernel);
-      }
+/**
+ * @brief Loops over all 2D Tracks from the TrackGenerator's Track schedule
+ * @details Each thread traverses the Tracks assigned to it by the
+ *          segment-weighted Track schedule, which is built for the number of
+ *          threads at the start of the traversal if necessary. With
+ *          WORK_STEALING_SCHEDULING, each thread which exhausts its own
+ *          Tracks claims the remaining Tracks of the other threads through
+ *          their atomic cursors. No barrier is imposed between Tracks of
+ *          different azimuthal angles.
+ * @param kernel The MOCKernel to apply to all segments
+ */
+void TraverseTracks::loopOverTrackSchedule(MOCKernel* kernel) {
+
+  int num_threads = omp_get_num_threads();
+
+#pragma omp single
+  {
+    if (_track_generator->getTrackScheduleNumThreads() != num_threads)
+      _track_generator->initializeTrackSchedule(num_threads);
+
+    /* Initialize each thread's cursor to the start of its Tracks */
+    int* offsets = _track_generator->getTrackScheduleOffsets();
+    if (_schedule_cursors != NULL)
+      delete [] _schedule_cursors;
+    _schedule_cursors = new int[num_threads * SCHEDULE_CURSOR_STRIDE];
+    for (int t=0; t < num_threads; t++)
+      _schedule_cursors[t * SCHEDULE_CURSOR_STRIDE] = offsets[t];
+  }
 
-      /* Operate on the Track */
-      segment* segments = track_2D->getSegments();
-      onTrack(track_2D, segments);
+  Track** tracks = _track_generator->getTracksArray();
+  int* schedule = _track_generator->getTrackSchedule();
+  int* offsets = _track_generator->getTrackScheduleOffsets();
+  int tid = omp_get_thread_num();
+
+  /* Traverse the Tracks assigned to this thread */
+  if (_track_generator->getTrackScheduling() == STATIC_SCHEDULING) {
+    for (int i=offsets[tid]; i < offsets[tid+1]; i++)
+      applyToTrack(tracks[schedule[i]], kernel);
+  }
+
+  /* Claim the Tracks of this thread and then steal from the other threads */
+  else {
+    for (int v=0; v < num_threads; v++) {
+      int victim = (tid + v) % num_threads;
+      int* cursor = &_schedule_cursors[victim * SCHEDULE_CURSOR_STRIDE];
+      while (true) {
+        int i;
+#pragma omp atomic capture
+        i = (*cursor)++;
+        if (i >= offsets[victim+1])
+          break;
+        applyToTrack(tracks[schedule[i]], kernel);
+      }
     }
   }
 }
 
 
+/**
+ * @brief Applies the kernel to the segments of a Track and the
+ *        functionality described in onTrack(...) to the Track
+ * @details With on-the-fly segmentation, or before the TrackGenerator has
+ *          stored the explicit segments, the segments are formed by ray
+ *          tracing the Track as the kernel is applied.
+ * @param track The Track to operate on
+ * @param kernel The MOCKernel to apply to all segments
+ */
+void TraverseTracks::applyToTrack(Track* track, MOCKernel* kernel) {
+
+  /* Apply the kernel to segments if necessary */
+  if (kernel != NULL) {
+    kernel->newTrack(track);
+    if (_segment_formation == OTF_2D || _segment_store == NULL)
+      traceSegmentsOTF(track, kernel);
+    else
+      traceSegmentsExplicit(track, kernel);
+  }
+
+  /* Operate on the Track */
+  segment* segments = track->getSegments();
+  onTrack(track, segments);
+}
+
+
 /**
  * @brief Loops over segments in a Track when segments are explicitly generated
  * @details All segments in the provided Track are looped over and the provided
- *          MOCKernel is applied to them.
+ *          MOCKernel is applied to them. Segments are streamed from the
+ *          TrackGenerator's SegmentStore, after being decoded into the
+ *          thread's buffer if the SegmentStore is compressed.
  * @param track The Track whose segments will be traversed
  * @param kernel The kernel to apply to all segments
  */
 void TraverseTracks::traceSegmentsExplicit(Track* track, MOCKernel* kernel) {
-  for (int s=0; s < track->getNumSegments(); s++) {
-    segment* seg = track->getSegment(s);
-    kernel->execute(seg->_length, seg->_material, seg->_region_id,
-                    seg->_cmfd_surface_fwd, seg->_cmfd_surface_bwd);
-  }
+
+  /* Stream through the Track's range of the SegmentStore arrays */
+  SegmentStore* buffer = NULL;
+  if (_decoded_segments != NULL)
+    buffer = _decoded_segments[omp_get_thread_num()];
+
+  long start, end;
+  SegmentStore* store = _segment_store->getTrackSegments(track->getUid(),
+                                                         buffer, &start, &end);
+
+  FP_STORAGE* lengths = store->getLengths();
+  int* material_indices = store->getMaterialIndices();
+  int* region_ids = store->getRegionIds();
+  int* cmfd_surfaces_fwd = store->getCmfdSurfacesFwd();
+  int* cmfd_surfaces_bwd = store->getCmfdSurfacesBwd();
+  Material** materials = store->getMaterials();
+
+  for (long s=start; s < end; s++)
+    kernel->execute(lengths[s], materials[material_indices[s]],
+                    region_ids[s], cmfd_surfaces_fwd[s],
+                    cmfd_surfaces_bwd[s]);
+}
+
+
+/**
+ * @brief Forms the segments of a Track by ray tracing on-the-fly
+ * @details The Track is ray traced across the Geometry and the provided
+ *          MOCKernel is applied to each segment as it is formed, without
+ *          storing the segments.
+ * @param track The Track whose segments will be formed
+ * @param kernel The kernel to apply to all segments
+ */
+void TraverseTracks::traceSegmentsOTF(Track* track, MOCKernel* kernel) {
+  _geometry->segmentize(track, kernel);
 }
 
 
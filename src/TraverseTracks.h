@@ -36,20 +36,38 @@ class TraverseTracks {
 
 private:
 
+  /** The cursor of each thread into its Tracks in the TrackGenerator's
+   *  Track schedule for work stealing, strided by SCHEDULE_CURSOR_STRIDE */
+  int* _schedule_cursors;
+
   /* Functions defining how to loop over Tracks */
   void loopOverTracks2D(MOCKernel* kernel);
+  void loopOverTrackSchedule(MOCKernel* kernel);
+  void applyToTrack(Track* track, MOCKernel* kernel);
 
   /* Functions defining how to traverse segments */
   void traceSegmentsExplicit(Track* track, MOCKernel* kernel);
+  void traceSegmentsOTF(Track* track, MOCKernel* kernel);
 
 protected:
 
   /** Pointer to the associated TrackGenerator */
   TrackGenerator* _track_generator;
 
+  /** Pointer to the Geometry used for on-the-fly ray tracing */
+  Geometry* _geometry;
+
   /** The type of segmentation used for segment formation */
   segmentationType _segment_formation;
 
+  /** The contiguous storage of all segments, or NULL if segments are to be
+   *  formed by ray tracing */
+  SegmentStore* _segment_store;
+
+  /** A buffer for each thread into which the segments of each Track are
+   *  decoded if the SegmentStore is compressed, or NULL otherwise */
+  SegmentStore** _decoded_segments;
+
   TraverseTracks(TrackGenerator* track_generator);
   virtual ~TraverseTracks();
 
@@ -69,6 +69,14 @@ Universe::Universe(const int id, const char* name) {
 
   /* By default, the Universe's fissionability is unknown */
   _fissionable = false;
+
+  /* The Cell grid is built once the Cells have been subdivided */
+  _grid_num_x = 0;
+  _grid_num_y = 0;
+
+  /* The Universe does not fill a subdivided Cell until told so */
+  _ring_x0 = 0.;
+  _ring_y0 = 0.;
 }
 
 
@@ -589,6 +597,8 @@ void Universe::addCell(Cell* cell) {
 
   try {
     _cells.insert(std::pair<int, Cell*>(cell->getId(), cell));
+    clearCellGrid();
+    _subcells.clear();
     log_printf(DEBUG, "Added Cell with ID = %d to Universe with ID = %d",
                cell->getId(), _id);
   }
@@ -606,96 +616,163 @@ void Universe::addCell(Cell* cell) {
 void Universe::removeCell(Cell* cell) {
   if (_cells.find(cell->getId()) != _cells.end())
     _cells.erase(cell->getId());
+  clearCellGrid();
+  _subcells.clear();
 }
 
 
 /**
  * @brief Finds the Cell for which a LocalCoords object resides.
  * @details Finds the Cell that a LocalCoords object is located inside by
- *          checking each of this Universe's Cells. Returns NULL if the
- *          LocalCoords is not in any of the Cells.
+ *          checking each of this Universe's Cells. If the Cell grid has been
+ *          built, only the Cells overlapping the grid bin containing the
+ *          LocalCoords are checked. Returns NULL if the LocalCoords is not in
+ *          any of the Cells. If this Universe fills a Cell subdivided into
+ *          rings and sectors, the ring and sector containing the LocalCoords
+ *          are computed from its radius and angle instead, assuming that the
+ *          LocalCoords lies within the subdivided Cell.
  * @param coords a pointer to the LocalCoords of interest
  * @return a pointer the Cell where the LocalCoords is located
  */
 Cell* Universe::findCell(LocalCoords* coords) {
 
-  Cell* cell;
-  std::vector<Cell*> cells;
-  std::vector<Cell*>::iterator iter;
+  Cell* cell = NULL;
 
   /* Sets the LocalCoord type to UNIV at this level */
   coords->setType(UNIV);
 
-  /* If the LocalCoords is populated with Universe/Cell already, we assume
-   * that we are looking for the location in a neighboring Cell */
-  if (coords->getCell() != NULL)
-    cells = coords->getCell()->getNeighbors();
+  /* Find the ring and sector of a subdivided Cell containing the coords */
+  if (!_subcells.empty()) {
 
-  /* Add all of Universe's Cells to the back of neighbor Cells vector */
-  std::transform(_cells.begin(), _cells.end(),
-                 std::back_inserter(cells), pair_second(_cells));
+    int num_sectors = _sector_A.size();
+    int ring = 0;
+    int sector = 0;
 
-  /* Loop over all Cells */
-  for (iter = cells.begin(); iter != cells.end(); ++iter) {
-    cell = (*iter);
-
-    if (cell->containsCoords(coords)) {
-
-      /* Set the Cell on this level */
-      coords->setCell(cell);
-
-      /* MATERIAL type Cell - lowest level, terminate search for Cell */
-      if (cell->getType() == MATERIAL)
-        return cell;
-
-      /* FILL type Cell - Cell contains a Universe at a lower level
-       * Update coords to next level and continue search */
-      else if (cell->getType() == FILL) {
-
-        LocalCoords* next_coords =
-            new LocalCoords(coords->getX(), coords->getY(), coords->getZ());
-        next_coords->setPhi(coords->getPhi());
-
-        /* Apply translation to position in the next coords */
-	if (cell->isTranslated()){
-	  double* translation = cell->getTranslation();
-	  double new_x = coords->getX() + translation[0];
-	  double new_y = coords->getY() + translation[1];
-	  double new_z = coords->getZ() + translation[2];
-	  next_coords->setX(new_x);
-	  next_coords->setY(new_y);
-	  next_coords->setZ(new_z);
-	}
-
-        /* Apply rotation to position and direction in the next coords */
-	if (cell->isRotated()){
-	  double x = coords->getX();
-	  double y = coords->getY();
-	  double z = coords->getZ();
-	  double* matrix = cell->getRotationMatrix();
-	  double new_x = matrix[0] * x + matrix[1] * y + matrix[2] * z;
-	  double new_y = matrix[3] * x + matrix[4] * y + matrix[5] * z;
-	  double new_z = matrix[6] * x + matrix[7] * y + matrix[8] * z;
-	  next_coords->setX(new_x);
-	  next_coords->setY(new_y);
-	  next_coords->setZ(new_z);
-          next_coords->incrementPhi(cell->getPsi() * M_PI / 180.);
-	}
-
-        Universe* univ = cell->getFillUniverse();
-        next_coords->setUniverse(univ);
-
-        coords->setNext(next_coords);
-        next_coords->setPrev(coords);
-        if (univ->getType() == SIMPLE)
-          return univ->findCell(next_coords);
+    /* Bisect the squared ring radii, which decrease from the outside in */
+    if (!_ring_radii2.empty()) {
+      double dx = coords->getX() - _ring_x0;
+      double dy = coords->getY() - _ring_y0;
+      double r2 = dx * dx + dy * dy;
+      int high = _ring_radii2.size();
+
+      while (ring < high) {
+        int mid = (ring + high) / 2;
+        if (r2 <= _ring_radii2[mid])
+          ring = mid + 1;
         else
-          return static_cast<Lattice*>(univ)->findCell(next_coords);
+          high = mid;
+      }
+    }
+
+    /* Find the angular bin of the sector, and step to the adjacent sector if
+     * round-off put the coords on the wrong side of a sector's Planes */
+    if (num_sectors > 0) {
+      double x = coords->getX();
+      double y = coords->getY();
+      double delta_azim = 2. * M_PI / num_sectors;
+      sector = int(floor((atan2(y, x) + M_PI / 4.) / delta_azim));
+      sector = (sector % num_sectors + num_sectors) % num_sectors;
+
+      int next = (sector + 1) % num_sectors;
+      if (_sector_A[sector] * x + _sector_B[sector] * y < 0.)
+        sector = (sector + num_sectors - 1) % num_sectors;
+      else if (num_sectors != 2 && _sector_A[next] * x + _sector_B[next] * y
+               > 0.)
+        sector = next;
+    }
+    else
+      num_sectors = 1;
+
+    cell = _subcells[ring * num_sectors + sector];
+  }
+
+  /* Check the candidate Cells of the grid bin containing the coords */
+  else if (_grid_num_x > 0) {
+
+    double bin_x = floor((coords->getX() - _grid_min_x) / _grid_width_x);
+    double bin_y = floor((coords->getY() - _grid_min_y) / _grid_width_y);
+    bin_x = std::min(std::max(bin_x, 0.), _grid_num_x - 1.);
+    bin_y = std::min(std::max(bin_y, 0.), _grid_num_y - 1.);
+    int bin = int(bin_y) * _grid_num_x + int(bin_x);
+
+    for (int i=_grid_offsets[bin]; i < _grid_offsets[bin+1]; i++) {
+      if (_grid_cells[i]->containsCoords(coords)) {
+        cell = _grid_cells[i];
+        break;
       }
     }
   }
 
-  return NULL;
+  else {
+
+    /* If the LocalCoords is populated with Universe/Cell already, we assume
+     * that we are looking for the location in a neighboring Cell */
+    if (coords->getCell() != NULL) {
+      const std::vector<Cell*>& neighbors = coords->getCell()->getNeighbors();
+      for (int i=0; i < neighbors.size(); i++) {
+        if (neighbors[i]->containsCoords(coords)) {
+          cell = neighbors[i];
+          break;
+        }
+      }
+    }
+
+    /* Loop over all Cells */
+    std::map<int, Cell*>::iterator iter;
+    for (iter = _cells.begin(); iter != _cells.end() && cell == NULL; ++iter)
+      if (iter->second->containsCoords(coords))
+        cell = iter->second;
+  }
+
+  if (cell == NULL)
+    return NULL;
+
+  /* Set the Cell on this level */
+  coords->setCell(cell);
+
+  /* MATERIAL type Cell - lowest level, terminate search for Cell */
+  if (cell->getType() == MATERIAL)
+    return cell;
+
+  /* FILL type Cell - Cell contains a Universe at a lower level
+   * Update coords to next level and continue search */
+  LocalCoords* next_coords =
+      coords->getNextCreate(coords->getX(), coords->getY(), coords->getZ());
+  next_coords->setPhi(coords->getPhi());
+
+  /* Apply translation to position in the next coords */
+  if (cell->isTranslated()){
+    double* translation = cell->getTranslation();
+    double new_x = coords->getX() + translation[0];
+    double new_y = coords->getY() + translation[1];
+    double new_z = coords->getZ() + translation[2];
+    next_coords->setX(new_x);
+    next_coords->setY(new_y);
+    next_coords->setZ(new_z);
+  }
+
+  /* Apply rotation to position and direction in the next coords */
+  if (cell->isRotated()){
+    double x = coords->getX();
+    double y = coords->getY();
+    double z = coords->getZ();
+    double* matrix = cell->getRotationMatrix();
+    double new_x = matrix[0] * x + matrix[1] * y + matrix[2] * z;
+    double new_y = matrix[3] * x + matrix[4] * y + matrix[5] * z;
+    double new_z = matrix[6] * x + matrix[7] * y + matrix[8] * z;
+    next_coords->setX(new_x);
+    next_coords->setY(new_y);
+    next_coords->setZ(new_z);
+    next_coords->incrementPhi(cell->getPsi() * M_PI / 180.);
+  }
+
+  Universe* univ = cell->getFillUniverse();
+  next_coords->setUniverse(univ);
+
+  if (univ->getType() == SIMPLE)
+    return univ->findCell(next_coords);
+  else
+    return static_cast<Lattice*>(univ)->findCell(next_coords);
 }
 
 
@@ -746,6 +823,199 @@ void Universe::buildNeighbors() {
 }
 
 
+/**
+ * @brief Builds a uniform grid of the Cells in this Universe and all
+ *        Universes below it for optimized ray tracing.
+ * @details The grid spans the finite extents of the bounding boxes of the
+ *          Cells, with about as many bins as Cells. Each bin stores the Cells
+ *          whose bounding boxes and Surfaces may overlap it, padded slightly
+ *          such that Points on the boundary of a bin find the Cell from
+ *          either side. Points outside the grid use the nearest bin, whose
+ *          box extends to infinity in that direction. The grid is only
+ *          built for Universes with at least CELL_GRID_MIN_CELLS Cells and
+ *          is cleared when a Cell is added or removed.
+ */
+void Universe::buildCellGrid() {
+
+  clearCellGrid();
+
+  /* Make recursive call to the fill Universes of the Cells */
+  std::map<int, Cell*>::iterator iter;
+  for (iter = _cells.begin(); iter != _cells.end(); ++iter) {
+    if (iter->second->getType() == FILL) {
+      Universe* fill = iter->second->getFillUniverse();
+      if (fill->getType() == SIMPLE)
+        fill->buildCellGrid();
+      else
+        static_cast<Lattice*>(fill)->buildCellGrid();
+    }
+  }
+
+  /* The Cells of a subdivided Cell are found without a grid */
+  int num_cells = _cells.size();
+  if (num_cells < CELL_GRID_MIN_CELLS || !_subcells.empty())
+    return;
+
+  /* Find the bounding boxes of the Cells and their finite extents */
+  std::vector<double> bounds(4*num_cells);
+  double min_x = INFINITY;
+  double max_x = -INFINITY;
+  double min_y = INFINITY;
+  double max_y = -INFINITY;
+  int c = 0;
+
+  for (iter = _cells.begin(); iter != _cells.end(); ++iter, ++c) {
+    bounds[4*c] = iter->second->getMinX();
+    bounds[4*c+1] = iter->second->getMaxX();
+    bounds[4*c+2] = iter->second->getMinY();
+    bounds[4*c+3] = iter->second->getMaxY();
+
+    for (int b=0; b < 2; b++) {
+      if (fabs(bounds[4*c+b]) != INFINITY) {
+        min_x = std::min(min_x, bounds[4*c+b]);
+        max_x = std::max(max_x, bounds[4*c+b]);
+      }
+      if (fabs(bounds[4*c+2+b]) != INFINITY) {
+        min_y = std::min(min_y, bounds[4*c+2+b]);
+        max_y = std::max(max_y, bounds[4*c+2+b]);
+      }
+    }
+  }
+
+  /* The grid cannot discriminate between Cells without finite extents */
+  if (!(min_x < max_x) || !(min_y < max_y))
+    return;
+
+  int num_x = ceil(sqrt(double(num_cells)));
+  int num_y = num_x;
+  double width_x = (max_x - min_x) / num_x;
+  double width_y = (max_y - min_y) / num_y;
+
+  /* Collect the Cells overlapping each bin in order of Cell ID */
+  std::vector< std::vector<Cell*> > bins(num_x * num_y);
+  c = 0;
+  for (iter = _cells.begin(); iter != _cells.end(); ++iter, ++c) {
+
+    int bin_min_x = floor((bounds[4*c] - min_x) / width_x - TINY_MOVE);
+    int bin_max_x = floor((bounds[4*c+1] - min_x) / width_x + TINY_MOVE);
+    int bin_min_y = floor((bounds[4*c+2] - min_y) / width_y - TINY_MOVE);
+    int bin_max_y = floor((bounds[4*c+3] - min_y) / width_y + TINY_MOVE);
+    if (bounds[4*c] == -INFINITY)
+      bin_min_x = 0;
+    if (bounds[4*c+1] == INFINITY)
+      bin_max_x = num_x - 1;
+    if (bounds[4*c+2] == -INFINITY)
+      bin_min_y = 0;
+    if (bounds[4*c+3] == INFINITY)
+      bin_max_y = num_y - 1;
+    bin_min_x = std::max(bin_min_x, 0);
+    bin_max_x = std::min(bin_max_x, num_x - 1);
+    bin_min_y = std::max(bin_min_y, 0);
+    bin_max_y = std::min(bin_max_y, num_y - 1);
+
+    /* Keep the Cell in the bins its Surfaces may overlap, where the bins
+     * on the edges of the grid extend to infinity */
+    for (int j=bin_min_y; j <= bin_max_y; j++) {
+      for (int i=bin_min_x; i <= bin_max_x; i++) {
+        double box_min_x = (i == 0) ? -INFINITY : min_x + i * width_x;
+        double box_max_x = (i == num_x-1) ? INFINITY : min_x + (i+1) * width_x;
+        double box_min_y = (j == 0) ? -INFINITY : min_y + j * width_y;
+        double box_max_y = (j == num_y-1) ? INFINITY : min_y + (j+1) * width_y;
+        double pad_x = TINY_MOVE * width_x;
+        double pad_y = TINY_MOVE * width_y;
+        if (iter->second->mayOverlapBox(box_min_x - pad_x, box_max_x + pad_x,
+                                        box_min_y - pad_y, box_max_y + pad_y))
+          bins[j * num_x + i].push_back(iter->second);
+      }
+    }
+  }
+
+  /* Store the candidate Cells of all bins contiguously */
+  _grid_offsets.resize(num_x * num_y + 1);
+  _grid_offsets[0] = 0;
+  for (int b=0; b < num_x * num_y; b++) {
+    _grid_offsets[b+1] = _grid_offsets[b] + bins[b].size();
+    _grid_cells.insert(_grid_cells.end(), bins[b].begin(), bins[b].end());
+  }
+
+  _grid_min_x = min_x;
+  _grid_min_y = min_y;
+  _grid_width_x = width_x;
+  _grid_width_y = width_y;
+  _grid_num_y = num_y;
+  _grid_num_x = num_x;
+
+  log_printf(DEBUG, "Built a %d x %d Cell grid with %d candidate Cells for "
+             "Universe ID=%d", num_x, num_y, _grid_cells.size(), _id);
+}
+
+
+/**
+ * @brief Clears the grid of the Cells in this Universe such that all Cells
+ *        are checked when finding the Cell containing a point.
+ */
+void Universe::clearCellGrid() {
+  _grid_num_x = 0;
+  _grid_num_y = 0;
+  _grid_offsets.clear();
+  _grid_cells.clear();
+}
+
+
+/**
+ * @brief Describes the rings and sectors of the Cell which this Universe
+ *        fills, such that Universe::findCell() computes the ring and sector
+ *        containing a point without testing each subcell.
+ * @details The subcells must be ordered by ring from the outside in and then
+ *          by sector, as created by Cell::subdivideCell(). Ring i lies
+ *          inside the ZCylinder i, except for an unbounded outermost ring,
+ *          and outside the ZCylinder i+1. Sector i lies in the positive
+ *          halfspace of Plane i and the negative halfspace of Plane i+1. A
+ *          single sector is degenerate, in which case the subcells are
+ *          searched as for any other Universe.
+ * @param subcells the ring and sector Cells subdividing the Cell
+ * @param zcylinders the ZCylinders bounding the rings from the outside
+ * @param planes the Planes through the origin bounding the sectors
+ */
+void Universe::setSubdivision(std::vector<Cell*>& subcells,
+                              std::vector<ZCylinder*>& zcylinders,
+                              std::vector<Plane*>& planes) {
+
+  _subcells.clear();
+  _ring_radii2.clear();
+  _sector_A.clear();
+  _sector_B.clear();
+
+  if (planes.size() == 1)
+    return;
+
+  if (std::max(zcylinders.size(), size_t(1)) *
+      std::max(planes.size(), size_t(1)) != subcells.size())
+    log_printf(ERROR, "Unable to describe the subdivision of Universe %d "
+               "with %d rings and %d sectors since it has %d subcells", _id,
+               int(zcylinders.size()), int(planes.size()),
+               int(subcells.size()));
+
+  /* The ZCylinder bounding the outermost ring only locates the center */
+  if (!zcylinders.empty()) {
+    _ring_x0 = zcylinders[0]->getX0();
+    _ring_y0 = zcylinders[0]->getY0();
+  }
+
+  for (int i=1; i < zcylinders.size(); i++) {
+    double radius = zcylinders[i]->getRadius();
+    _ring_radii2.push_back(radius * radius);
+  }
+
+  for (int i=0; i < planes.size(); i++) {
+    _sector_A.push_back(planes[i]->getA());
+    _sector_B.push_back(planes[i]->getB());
+  }
+
+  _subcells = subcells;
+}
+
+
 /**
  * @brief Convert the member attributes of this Universe to a character array.
  * @return a character array representing the Universe's attributes
@@ -1312,6 +1582,22 @@ void Lattice::buildNeighbors() {
 
 
 
+/**
+ * @brief Builds the Cell grids of each Universe in the Lattice for optimized
+ *        ray tracing.
+ */
+void Lattice::buildCellGrid() {
+
+  /* Get list of unique Universes in this Lattice */
+  std::map<int, Universe*> universes = getUniqueUniverses();
+
+  /* Loop over each Universe and make recursive call */
+  std::map<int, Universe*>::iterator iter;
+  for (iter = universes.begin(); iter != universes.end(); ++iter)
+    iter->second->buildCellGrid();
+}
+
+
 /**
  * @brief Checks if a Point is within the bounds of a Lattice.
  * @param point a pointer to the Point of interest
@@ -1366,7 +1652,6 @@ Cell* Lattice::findCell(LocalCoords* coords) {
   int lat_x = getLatX(coords->getPoint());
   int lat_y = getLatY(coords->getPoint());
   int lat_z = getLatZ(coords->getPoint());
-  double next_x, next_y, next_z;
 
   /* If the indices are outside the bound of the Lattice */
   if (lat_x < 0 || lat_x >= _num_x ||
@@ -1375,6 +1660,66 @@ Cell* Lattice::findCell(LocalCoords* coords) {
     return NULL;
   }
 
+  return findCellInLatticeCell(coords, lat_x, lat_y, lat_z);
+}
+
+
+/**
+ * @brief Finds the Cell within this Lattice that a LocalCoords has moved
+ *        into after crossing the boundaries of its Lattice cell.
+ * @details The Lattice cell indices stored in the LocalCoords are stepped
+ *          across each Lattice cell boundary that it has crossed, as in a
+ *          digital differential analyzer, and the Universe inside the new
+ *          Lattice cell is then searched. The LocalCoords is assumed to
+ *          have moved within the x-y plane. If the LocalCoords has left the
+ *          Lattice, this method will return NULL.
+ * @param coords the LocalCoords of interest at this Lattice's level
+ * @return a pointer to the Cell this LocalCoord is in or NULL
+ */
+Cell* Lattice::findNextLatticeCell(LocalCoords* coords) {
+
+  int lat_x = coords->getLatticeX();
+  int lat_y = coords->getLatticeY();
+  int lat_z = coords->getLatticeZ();
+
+  /* Compute the position in units of Lattice cells from the minimum corner */
+  double x = (coords->getX() + _width_x*_num_x/2.0 - _offset.getX())
+      / _width_x;
+  double y = (coords->getY() + _width_y*_num_y/2.0 - _offset.getY())
+      / _width_y;
+
+  /* Step the indices across each Lattice cell boundary that was crossed */
+  while (x >= lat_x + 1)
+    lat_x++;
+  while (x < lat_x)
+    lat_x--;
+  while (y >= lat_y + 1)
+    lat_y++;
+  while (y < lat_y)
+    lat_y--;
+
+  /* If the LocalCoords has left the Lattice */
+  if (lat_x < 0 || lat_x >= _num_x || lat_y < 0 || lat_y >= _num_y)
+    return NULL;
+
+  return findCellInLatticeCell(coords, lat_x, lat_y, lat_z);
+}
+
+
+/**
+ * @brief Finds the Cell containing a LocalCoords within the Universe
+ *        filling one of this Lattice's cells.
+ * @param coords the LocalCoords of interest at this Lattice's level
+ * @param lat_x the x index of the Lattice cell containing the LocalCoords
+ * @param lat_y the y index of the Lattice cell containing the LocalCoords
+ * @param lat_z the z index of the Lattice cell containing the LocalCoords
+ * @return a pointer to the Cell this LocalCoord is in or NULL
+ */
+Cell* Lattice::findCellInLatticeCell(LocalCoords* coords, int lat_x,
+                                     int lat_y, int lat_z) {
+
+  double next_x, next_y, next_z;
+
   /* Compute local position of Point in the next level Universe */
   next_x = coords->getX() -
     (-_width_x*_num_x/2.0 + _offset.getX() + (lat_x + 0.5) * _width_x) +
@@ -1390,13 +1735,8 @@ Cell* Lattice::findCell(LocalCoords* coords) {
       (-_width_z*_num_z/2.0 + _offset.getZ() + (lat_z + 0.5) * _width_z) +
       getOffset()->getZ();
 
-  /* Create a new LocalCoords object for the next level Universe */
-  LocalCoords* next_coords;
-
-  if (coords->getNext() == NULL)
-    next_coords = new LocalCoords(next_x, next_y, next_z);
-  else
-    next_coords = coords->getNext();
+  /* Get the LocalCoords for the next level Universe */
+  LocalCoords* next_coords = coords->getNextCreate(next_x, next_y, next_z);
 
   Universe* univ = getUniverse(lat_x, lat_y, lat_z);
   next_coords->setUniverse(univ);
@@ -1408,9 +1748,6 @@ Cell* Lattice::findCell(LocalCoords* coords) {
   coords->setLatticeY(lat_y);
   coords->setLatticeZ(lat_z);
 
-  coords->setNext(next_coords);
-  next_coords->setPrev(coords);
-
   /* Search the next lowest level Universe for the Cell */
   return univ->findCell(next_coords);
 }
@@ -24,6 +24,8 @@
 class LocalCoords;
 class Cell;
 class Surface;
+class Plane;
+class ZCylinder;
 class Material;
 struct surface_halfspace;
 
@@ -81,6 +83,56 @@ protected:
    *  with a non-zero fission cross-section and is fissionable */
   bool _fissionable;
 
+  /** The number of bins of the Cell grid along the x-axis, zero if the grid
+   *  has not been built */
+  int _grid_num_x;
+
+  /** The number of bins of the Cell grid along the y-axis */
+  int _grid_num_y;
+
+  /** The minimum x-coordinate of the Cell grid */
+  double _grid_min_x;
+
+  /** The minimum y-coordinate of the Cell grid */
+  double _grid_min_y;
+
+  /** The width of each bin of the Cell grid along the x-axis */
+  double _grid_width_x;
+
+  /** The width of each bin of the Cell grid along the y-axis */
+  double _grid_width_y;
+
+  /** The offsets of the candidate Cells of each bin in _grid_cells */
+  std::vector<int> _grid_offsets;
+
+  /** The Cells whose bounding boxes overlap each bin, in order of Cell ID */
+  std::vector<Cell*> _grid_cells;
+
+  /** The ring and sector Cells subdividing a Cell, ordered by ring from the
+   *  outside in and then by sector, if this Universe fills a subdivided
+   *  Cell. The vector is empty otherwise. */
+  std::vector<Cell*> _subcells;
+
+  /** The x-coordinate of the center of the rings */
+  double _ring_x0;
+
+  /** The y-coordinate of the center of the rings */
+  double _ring_y0;
+
+  /** The squared radii of the ZCylinders separating adjacent rings, from the
+   *  outside in */
+  std::vector<double> _ring_radii2;
+
+  /** The A coefficients of the Planes through the origin bounding the
+   *  sectors */
+  std::vector<double> _sector_A;
+
+  /** The B coefficients of the Planes through the origin bounding the
+   *  sectors */
+  std::vector<double> _sector_B;
+
+  void clearCellGrid();
+
 public:
 
   Universe(const int id=-1, const char* name="");
@@ -117,6 +169,12 @@ public:
   void setFissionability(bool fissionable);
   void subdivideCells(double max_radius=INFINITY);
   void buildNeighbors();
+  void buildCellGrid();
+#ifndef SWIG
+  void setSubdivision(std::vector<Cell*>& subcells,
+                      std::vector<ZCylinder*>& zcylinders,
+                      std::vector<Plane*>& planes);
+#endif
 
   virtual std::string toString();
   void printString();
@@ -158,6 +216,9 @@ private:
   std::vector< std::vector< std::vector< std::pair<int, Universe*> > > >
       _universes;
 
+  Cell* findCellInLatticeCell(LocalCoords* coords, int lat_x, int lat_y,
+                              int lat_z);
+
 public:
 
   Lattice(const int id=-1, const char* name="");
@@ -195,9 +256,11 @@ public:
   void removeUniverse(Universe* universe);
   void subdivideCells(double max_radius=INFINITY);
   void buildNeighbors();
+  void buildCellGrid();
 
   bool withinBounds(Point* point);
   Cell* findCell(LocalCoords* coords);
+  Cell* findNextLatticeCell(LocalCoords* coords);
   double minSurfaceDist(LocalCoords* coords);
 
   int getLatX(Point* point);
@@ -12,13 +12,10 @@ VectorizedSolver::VectorizedSolver(TrackGenerator* track_generator) :
     log_printf(ERROR, "The VectorizedSolver is not yet configured for CMFD");
 
   _delta_psi = NULL;
-  _thread_taus = NULL;
   _thread_exponentials = NULL;
 
   if (track_generator != NULL)
     setTrackGenerator(track_generator);
-
-  vmlSetMode(VML_EP);
 }
 
 
@@ -33,6 +30,11 @@ VectorizedSolver::~VectorizedSolver() {
     _boundary_flux = NULL;
   }
 
+  if (_start_flux != NULL) {
+    MM_FREE(_start_flux);
+    _start_flux = NULL;
+  }
+
   if (_scalar_flux != NULL && !_user_fluxes) {
     MM_FREE(_scalar_flux);
     _scalar_flux = NULL;
@@ -58,11 +60,6 @@ VectorizedSolver::~VectorizedSolver() {
     _delta_psi = NULL;
   }
 
-  if (_thread_taus != NULL) {
-    MM_FREE(_thread_taus);
-    _thread_taus = NULL;
-  }
-
   if (_thread_exponentials != NULL) {
     MM_FREE(_thread_exponentials);
     _thread_exponentials = NULL;
@@ -83,6 +80,16 @@ int VectorizedSolver::getNumVectorWidths() {
 }
 
 
+/**
+ * @brief Returns false so that the transport sweep calls the vectorized
+ *        MOC kernels rather than the CPUSolver's templated kernels.
+ * @return false
+ */
+bool VectorizedSolver::usesTemplatedKernels() {
+  return false;
+}
+
+
 /**
  * @brief Sets the Geometry for the Solver.
  * @param geometry a pointer to the Geometry
@@ -92,31 +99,29 @@ void VectorizedSolver::setGeometry(Geometry* geometry) {
   CPUSolver::setGeometry(geometry);
 
   /* Compute the number of SIMD vector widths needed to fit energy groups */
+  _num_groups = _geometry->getNumEnergyGroups();
   _num_vector_lengths = (_num_groups / VEC_LENGTH) + 1;
 
   /* Reset the number of energy groups by rounding up for the number
    * of vector widths needed to accomodate the energy groups */
   _num_groups = _num_vector_lengths * VEC_LENGTH;
-  _polar_times_groups = _num_groups * _num_polar;
+  _polar_times_groups = _num_groups * _num_polar_2;
 }
 
 
 /**
- * @brief Allocates memory for the exponential linear interpolation table.
+ * @brief Allocates aligned memory for the exponentials of each thread.
  */
 void VectorizedSolver::initializeExpEvaluator() {
 
-  CPUSolver::initializeExpEvaluator();
+  Solver::initializeExpEvaluator();
 
   /* Deallocates memory for the exponentials if it was allocated for a
    * previous simulation */
   if (_thread_exponentials != NULL)
     MM_FREE(_thread_exponentials);
 
-  /* Allocates memory for an array of exponential values for each thread
-   * - this is not used by default, but can be to allow for vectorized
-   * evaluation of the exponentials. Unfortunately this does not appear
-   * to give any performance boost. */
+  /* Allocates memory for an array of exponential values for each thread */
   int size = _num_threads * _polar_times_groups * sizeof(FP_PRECISION);
   _thread_exponentials = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
 }
@@ -147,10 +152,17 @@ void VectorizedSolver::initializeMaterials(solverMode mode) {
  */
 void VectorizedSolver::initializeFluxArrays() {
 
+  if (_boundary_flux_update != DOUBLE_BUFFERED)
+    log_printf(ERROR, "Unable to store the boundary fluxes along the Track "
+               "cycles with the VectorizedSolver");
+
   /* Delete old flux arrays if they exist */
   if (_boundary_flux != NULL)
     MM_FREE(_boundary_flux);
 
+  if (_start_flux != NULL)
+    MM_FREE(_start_flux);
+
   if (_scalar_flux != NULL && !_user_fluxes)
     MM_FREE(_scalar_flux);
 
@@ -160,31 +172,24 @@ void VectorizedSolver::initializeFluxArrays() {
   if (_delta_psi != NULL)
     MM_FREE(_delta_psi);
 
-  if (_thread_taus != NULL)
-    MM_FREE(_thread_taus);
-
-  int size;
+  long size;
 
   /* Allocate aligned memory for all flux arrays */
-  try{
+  size = 2 * (long)_tot_num_tracks * _polar_times_groups;
+  size *= sizeof(FP_STORAGE);
+  _boundary_flux = (FP_STORAGE*)MM_MALLOC(size, VEC_ALIGNMENT);
+  _start_flux = (FP_STORAGE*)MM_MALLOC(size, VEC_ALIGNMENT);
 
-    size = 2 * _tot_num_tracks * _num_groups * _num_polar;
-    size *= sizeof(FP_PRECISION);
-    _boundary_flux = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
+  size = (long)_num_FSRs * _num_groups * sizeof(FP_PRECISION);
+  _scalar_flux = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
+  _old_scalar_flux = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
 
-    size = _num_FSRs * _num_groups * sizeof(FP_PRECISION);
-    _scalar_flux = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
-    _old_scalar_flux = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
-
-    size = _num_threads * _num_groups * sizeof(FP_PRECISION);
-    _delta_psi = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
+  size = _num_threads * _num_groups * sizeof(FP_PRECISION);
+  _delta_psi = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
 
-    size = _num_threads * _polar_times_groups * sizeof(FP_PRECISION);
-    _thread_taus = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
-  }
-  catch(std::exception &e) {
+  if (_boundary_flux == NULL || _start_flux == NULL || _scalar_flux == NULL ||
+      _old_scalar_flux == NULL || _delta_psi == NULL)
     log_printf(ERROR, "Could not allocate memory for the fluxes");
-  }
 }
 
 
@@ -201,16 +206,15 @@ void VectorizedSolver::initializeSourceArrays() {
   if (_fixed_sources != NULL)
     MM_FREE(_fixed_sources);
 
-  int size = _num_FSRs * _num_groups * sizeof(FP_PRECISION);
+  long size = (long)_num_FSRs * _num_groups * sizeof(FP_PRECISION);
 
   /* Allocate aligned memory for all source arrays */
-  try{
-    _reduced_sources = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
-    _fixed_sources = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
-  }
-  catch(std::exception &e) {
+  _reduced_sources = (FP_STORAGE*)MM_MALLOC((long)_num_FSRs * _num_groups *
+                                            sizeof(FP_STORAGE), VEC_ALIGNMENT);
+  _fixed_sources = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
+
+  if (_reduced_sources == NULL || _fixed_sources == NULL)
     log_printf(ERROR, "Could not allocate memory for FSR sources");
-  }
 
   /* Initialize fixed sources to zero */
   memset(_fixed_sources, 0.0, size);
@@ -266,7 +270,7 @@ void VectorizedSolver::initializeFSRs() {
   /* Reset the number of energy groups by rounding up for the number
    * of vector widths needed to accomodate the energy groups */
   _num_groups = _num_vector_lengths * VEC_LENGTH;
-  _polar_times_groups = _num_groups * _num_polar;
+  _polar_times_groups = _num_groups * _num_polar_2;
 }
 
 
@@ -282,7 +286,7 @@ void VectorizedSolver::normalizeFluxes() {
   FP_PRECISION tot_fission_source;
   FP_PRECISION norm_factor;
 
-  int size = _num_FSRs * _num_groups * sizeof(FP_PRECISION);
+  long size = (long)_num_FSRs * _num_groups * sizeof(FP_PRECISION);
   FP_PRECISION* fission_sources = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
 
   /* Compute total fission source for each FSR, energy group */
@@ -297,24 +301,15 @@ void VectorizedSolver::normalizeFluxes() {
     for (int v=0; v < _num_vector_lengths; v++) {
 
       /* Loop over each energy group within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
       for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
-        fission_sources(r,e) = nu_sigma_f[e] * _scalar_flux(r,e);
-
-      /* Loop over each energy group within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
-      for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
-        fission_sources(r,e) *= volume;
+        fission_sources(r,e) = nu_sigma_f[e] * _scalar_flux(r,e) * volume;
     }
   }
 
   /* Compute the total fission source */
-  size = _num_FSRs * _num_groups;
-#ifdef SINGLE
-  tot_fission_source = cblas_sasum(size, fission_sources, 1);
-#else
-  tot_fission_source = cblas_dasum(size, fission_sources, 1);
-#endif
+  tot_fission_source = pairwise_sum<FP_PRECISION>(fission_sources,
+                                                  _num_FSRs * _num_groups);
 
   /* Deallocate memory for fission source array */
   MM_FREE(fission_sources);
@@ -326,24 +321,29 @@ void VectorizedSolver::normalizeFluxes() {
              tot_fission_source, norm_factor);
 
   /* Normalize the FSR scalar fluxes */
-#ifdef SINGLE
-  cblas_sscal(size, norm_factor, _scalar_flux, 1);
-  cblas_sscal(size, norm_factor, _old_scalar_flux, 1);
-#else
-  cblas_dscal(size, norm_factor, _scalar_flux, 1);
-  cblas_dscal(size, norm_factor, _old_scalar_flux, 1);
-#endif
+#pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+
+#pragma omp simd
+    for (int e=0; e < _num_groups; e++) {
+      _scalar_flux(r,e) *= norm_factor;
+      _old_scalar_flux(r,e) *= norm_factor;
+    }
+  }
 
   /* Normalize the Track angular boundary fluxes */
-  size = 2 * _tot_num_tracks * _num_polar * _num_groups;
+#pragma omp parallel for schedule(guided)
+  for (int t=0; t < _tot_num_tracks; t++) {
 
-#ifdef SINGLE
-  cblas_sscal(size, norm_factor, _boundary_flux, 1);
-#else
-  cblas_dscal(size, norm_factor, _boundary_flux, 1);
-#endif
+    FP_STORAGE* boundary_flux = &_boundary_flux(t,0,0,0);
+    FP_STORAGE* start_flux = &_start_flux(t,0,0,0);
 
-  return;
+#pragma omp simd
+    for (int i=0; i < 2 * _polar_times_groups; i++) {
+      boundary_flux[i] *= norm_factor;
+      start_flux[i] *= norm_factor;
+    }
+  }
 }
 
 
@@ -356,7 +356,6 @@ void VectorizedSolver::computeFSRSources() {
 
 #pragma omp parallel default(none)
   {
-    int tid;
     Material* material;
     FP_PRECISION* sigma_t;
     FP_PRECISION* sigma_s;
@@ -373,7 +372,6 @@ void VectorizedSolver::computeFSRSources() {
 #pragma omp for schedule(guided)
     for (int r=0; r < _num_FSRs; r++) {
 
-      tid = omp_get_thread_num();
       material = _FSR_materials[r];
       sigma_t = material->getSigmaT();
       sigma_s = material->getSigmaS();
@@ -383,27 +381,23 @@ void VectorizedSolver::computeFSRSources() {
       for (int G=0; G < _num_groups; G++) {
         for (int v=0; v < _num_vector_lengths; v++) {
 
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
           for (int g=v*VEC_LENGTH; g < (v+1)*VEC_LENGTH; g++) {
             scatter_sources[g] = sigma_s[G*_num_groups+g] * _scalar_flux(r,g);
             fission_sources[g] = fiss_mat[G*_num_groups+g] * _scalar_flux(r,g);
           }
         }
 
-#ifdef SINGLE
-        scatter_source=cblas_sasum(_num_groups, scatter_sources, 1);
-        fission_source=cblas_sasum(_num_groups, fission_sources, 1);
-#else
-        scatter_source=cblas_dasum(_num_groups, scatter_sources, 1);
-        fission_source=cblas_dasum(_num_groups, fission_sources, 1);
-#endif
-
+        scatter_source = pairwise_sum<FP_PRECISION>(scatter_sources,
+                                                    _num_groups);
+        fission_source = pairwise_sum<FP_PRECISION>(fission_sources,
+                                                    _num_groups);
         fission_source /= _k_eff;
 
         /* Compute total (scatter+fission+fixed) reduced source */
-        _reduced_sources(r,G) = _fixed_sources(r,G);
-        _reduced_sources(r,G) += scatter_source + fission_source;
-        _reduced_sources(r,G) *= ONE_OVER_FOUR_PI / sigma_t[G];
+        _reduced_sources(r,G) = (_fixed_sources(r,G) + scatter_source +
+                                 fission_source) * ONE_OVER_FOUR_PI /
+                                 sigma_t[G];
       }
     }
 
@@ -434,19 +428,11 @@ void VectorizedSolver::addSourceToScalarFlux() {
     for (int v=0; v < _num_vector_lengths; v++) {
 
       /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
-      for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
-        _scalar_flux(r,e) *= 0.5;
-
-      /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
-      for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
-        _scalar_flux(r,e) = _scalar_flux(r,e) / (sigma_t[e] * volume);
-
-      /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
-      for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
+#pragma omp simd
+      for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++) {
+        _scalar_flux(r,e) /= (sigma_t[e] * volume);
         _scalar_flux(r,e) += FOUR_PI * _reduced_sources(r,e);
+      }
     }
   }
 
@@ -487,25 +473,18 @@ void VectorizedSolver::computeKeff() {
       for (int v=0; v < _num_vector_lengths; v++) {
 
         /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
         for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
           group_rates[tid+e] = sigma[e] * _scalar_flux(r,e);
       }
 
-#ifdef SINGLE
-      FSR_rates[r] = cblas_sasum(_num_groups, &group_rates[tid], 1) * volume;
-#else
-      FSR_rates[r] = cblas_dasum(_num_groups, &group_rates[tid], 1) * volume;
-#endif
+      FSR_rates[r]=pairwise_sum<FP_PRECISION>(&group_rates[tid], _num_groups);
+      FSR_rates[r] *= volume;
     }
   }
 
   /* Reduce new fission rates across FSRs */
-#ifdef SINGLE
-  fission = cblas_sasum(_num_FSRs, FSR_rates, 1);
-#else
-  fission = cblas_dasum(_num_FSRs, FSR_rates, 1);
-#endif
+  fission = pairwise_sum<FP_PRECISION>(FSR_rates, _num_FSRs);
 
   _k_eff *= fission;
 
@@ -520,67 +499,51 @@ void VectorizedSolver::computeKeff() {
  * @details This method integrates the angular flux for a Track segment across
  *        energy groups and polar angles, and tallies it into the FSR scalar
  *        flux, and updates the Track's angular flux.
- * @param curr_segment a pointer to the Track segment of interest
+ * @param length the length of the Track segment
+ * @param fsr_id the ID of the FSR in which the segment resides
+ * @param sigma_t the total cross-sections of the segment's Material
  * @param azim_index a pointer to the azimuthal angle index for this segment
  * @param track_flux a pointer to the Track's angular flux
  * @param fsr_flux a pointer to the temporary FSR flux buffer
  */
-void VectorizedSolver::tallyScalarFlux(segment* curr_segment,
+void VectorizedSolver::tallyScalarFlux(FP_PRECISION length, int fsr_id,
+                                       FP_PRECISION* sigma_t,
                                        int azim_index,
                                        FP_PRECISION* track_flux,
                                        FP_PRECISION* fsr_flux) {
 
   int tid = omp_get_thread_num();
-  int fsr_id = curr_segment->_region_id;
   FP_PRECISION* delta_psi = &_delta_psi[tid*_num_groups];
   FP_PRECISION* exponentials = &_thread_exponentials[tid*_polar_times_groups];
+  FP_PRECISION weight;
 
-  computeExponentials(curr_segment, exponentials);
+  computeExponentials(length, sigma_t, exponentials);
 
   /* Set the FSR scalar flux buffer to zero */
   memset(fsr_flux, 0.0, _num_groups * sizeof(FP_PRECISION));
 
   /* Tally the flux contribution from segment to FSR's scalar flux */
   /* Loop over polar angles */
-  for (int p=0; p < _num_polar; p++) {
+  for (int p=0; p < _num_polar_2; p++) {
+
+    weight = _quadrature->getWeightInline(azim_index, p);
 
     /* Loop over each energy group vector length */
     for (int v=0; v < _num_vector_lengths; v++) {
 
       /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
-      for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
-        delta_psi[e] = track_flux(p,e) - _reduced_sources(fsr_id,e);
-
-      /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
-      for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
-        delta_psi[e] *= exponentials(p,e);
-
-      /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
-      for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
-        fsr_flux[e] += delta_psi[e] * _polar_weights(azim_index,p);
-
-      /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
-      for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
+#pragma omp simd
+      for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++) {
+        delta_psi[e] = (track_flux(p,e) - _reduced_sources(fsr_id,e)) *
+            exponentials(p,e);
+        fsr_flux[e] += delta_psi[e] * weight;
         track_flux(p,e) -= delta_psi[e];
+      }
     }
   }
 
   /* Atomically increment the FSR scalar flux from the temporary array */
-  omp_set_lock(&_FSR_locks[fsr_id]);
-  {
-#ifdef SINGLE
-    vsAdd(_num_groups, &_scalar_flux(fsr_id,0), fsr_flux,
-          &_scalar_flux(fsr_id,0));
-#else
-    vdAdd(_num_groups, &_scalar_flux(fsr_id,0), fsr_flux,
-          &_scalar_flux(fsr_id,0));
-#endif
-  }
-  omp_unset_lock(&_FSR_locks[fsr_id]);
+  accumulateScalarFlux(fsr_id, fsr_flux);
 }
 
 
@@ -588,66 +551,18 @@ void VectorizedSolver::tallyScalarFlux(segment* curr_segment,
  * @brief Computes an array of the exponentials in the transport equation,
  *        \f$ exp(-\frac{\Sigma_t * l}{sin(\theta)}) \f$, for each energy group
  *        and polar angle for a given Track segment.
- * @param curr_segment pointer to the Track segment of interest
+ * @details The exponentials for all energy groups and polar angles are
+ *          evaluated together by the ExpEvaluator.
+ * @param length the length of the Track segment
+ * @param sigma_t the total cross-sections of the segment's Material
  * @param exponentials the array to store the exponential values
  */
-void VectorizedSolver::computeExponentials(segment* curr_segment,
+void VectorizedSolver::computeExponentials(FP_PRECISION length,
+                                           FP_PRECISION* sigma_t,
                                            FP_PRECISION* exponentials) {
 
-  FP_PRECISION length = curr_segment->_length;
-  FP_PRECISION* sigma_t = curr_segment->_material->getSigmaT();
-
-  /* Evaluate the exponentials using the linear interpolation table */
-  if (_exp_evaluator->isUsingInterpolation()) {
-    FP_PRECISION tau;
-
-    for (int e=0; e < _num_groups; e++) {
-      tau = length * sigma_t[e];
-      for (int p=0; p < _num_polar; p++)
-        exponentials(p,e) = _exp_evaluator->computeExponential(tau, p);
-    }
-  }
-
-  /* Evalute the exponentials using the intrinsic exp(...) function */
-  else {
-
-    int tid = omp_get_thread_num();
-    FP_PRECISION* sin_thetas = _polar_quad->getSinThetas();
-    FP_PRECISION* taus = &_thread_taus[tid*_polar_times_groups];
-
-    /* Initialize the tau argument for the exponentials */
-    for (int p=0; p < _num_polar; p++) {
-
-      for (int v=0; v < _num_vector_lengths; v++) {
-
-#pragma simd vectorlength(VEC_LENGTH)
-        for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
-          taus(p,e) = -sigma_t[e] * length;
-
-#pragma simd vectorlength(VEC_LENGTH)
-        for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
-          taus(p,e) /= sin_thetas[p];
-      }
-    }
-
-    /* Evaluate the negative of the exponentials using Intel's MKL */
-#ifdef SINGLE
-    vsExp(_polar_times_groups, taus, exponentials);
-#else
-    vdExp(_polar_times_groups, taus, exponentials);
-#endif
-
-    /* Compute one minus the exponentials */
-    for (int p=0; p < _num_polar; p++) {
-
-      for (int v=0; v < _num_vector_lengths; v++) {
-
-#pragma simd vectorlength(VEC_LENGTH)
-        for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
-          exponentials(p,e) = 1.0 - exponentials(p,e);
-      }
-    }
-  }
+  _exp_evaluator->computeExponentials(length, sigma_t, _num_groups,
+                                      _num_polar_2, exponentials);
 }
 
 
@@ -683,16 +598,16 @@ void VectorizedSolver::transferBoundaryFlux(int track_id, int azim_index,
     track_out_id = _tracks[track_id]->getTrackIn()->getUid();
   }
 
-  FP_PRECISION* track_out_flux = &_boundary_flux(track_out_id,0,0,start);
+  FP_STORAGE* track_out_flux = &_start_flux(track_out_id,0,0,start);
 
   /* Loop over polar angles and energy groups */
-  for (int p=0; p < _num_polar; p++) {
+  for (int p=0; p < _num_polar_2; p++) {
 
     /* Loop over each energy group vector length */
     for (int v=0; v < _num_vector_lengths; v++) {
 
       /* Loop over energy groups within this vector */
-#pragma simd vectorlength(VEC_LENGTH)
+#pragma omp simd
       for (int e=v*VEC_LENGTH; e < (v+1)*VEC_LENGTH; e++)
         track_out_flux(p,e) = track_flux(p,e) * transfer_flux;
     }
@@ -15,13 +15,8 @@
 #include <math.h>
 #include <omp.h>
 #include <stdlib.h>
-#include <mkl.h>
 #endif
 
-/** Indexing scheme for the optical length (\f$ l\Sigma_t \f$) for a
- *  given Track segment for each polar angle and energy group */
-#define taus(p,e) (taus[(p)*_num_groups + (e)])
-
 /** Indexing scheme for the exponentials in the neutron transport equation
  *  (\f$ 1 - exp(-\frac{l\Sigma_t}{sin(\theta_p)}) \f$) for a given
  *  Track segment for each polar angle and energy group */
@@ -30,11 +25,15 @@
 /**
  * @class VectorizedSolver VectorizedSolver.h "src/VectorizedSolver.h"
  * @brief This is a subclass of the CPUSolver class which uses memory-aligned
- *        data structures and Intel's auto-vectorization.
- * @note This class is only compiled if the Intel compiler is used when building
- *       OpenMOC. If building OpenMOC with the "--with-icpc" flag, then this
- *       class will be available in the "openmoc.intel.single" or
- *       "openmoc.intel.double" Python module.
+ *        data structures and OpenMP SIMD directives for auto-vectorization.
+ * @details The number of energy groups is padded to a multiple of the vector
+ *          length (VEC_LENGTH) and all flux, source and cross-section arrays
+ *          are allocated on VEC_ALIGNMENT byte boundaries, so that the loops
+ *          over each vector of energy groups may be compiled to SIMD (e.g.,
+ *          AVX2 or AVX-512) instructions by the GNU, Clang or Intel compilers.
+ * @note This class is always compiled with the Intel compiler, and with the
+ *       GNU or Clang compilers if OpenMOC is built with the "--with-simd"
+ *       flag (or with "SIMD = yes" in the profile Makefile).
  */
 class VectorizedSolver : public CPUSolver {
 
@@ -46,24 +45,20 @@ protected:
   /** The change in angular flux along a track segment for each energy group */
   FP_PRECISION* _delta_psi;
 
-  /** An array for the optical length for each thread in each energy group */
-  FP_PRECISION* _thread_taus;
-
-  /** An array for the exponential terms in the transport equation for *
-   *  each thread in each energy group and polar angle */
-  FP_PRECISION* _thread_exponentials;
-
-  void tallyScalarFlux(segment* curr_segment, int azim_index,
+  void tallyScalarFlux(FP_PRECISION length, int fsr_id,
+                       FP_PRECISION* sigma_t, int azim_index,
                        FP_PRECISION* track_flux, FP_PRECISION* fsr_flux);
   void transferBoundaryFlux(int track_id, int azim_index, bool direction,
                             FP_PRECISION* track_flux);
-  void computeExponentials(segment* curr_segment, FP_PRECISION* exponentials);
+  void computeExponentials(FP_PRECISION length, FP_PRECISION* sigma_t,
+                           FP_PRECISION* exponentials);
 
 public:
   VectorizedSolver(TrackGenerator* track_generator=NULL);
   virtual ~VectorizedSolver();
 
   int getNumVectorWidths();
+  bool usesTemplatedKernels();
 
   void setGeometry(Geometry* geometry);
 
@@ -915,6 +915,41 @@ void GPUSolver::getFluxes(FP_PRECISION* out_fluxes, int num_fluxes) {
 }
 
 
+/**
+ * @brief Fills an array with the Track angular fluxes.
+ * @details This is a helper method to restart a calculation, possibly in
+ *          another precision, from the Track angular fluxes with
+ *          setInitialTrackFluxes(...). This method may be called from Python
+ *          as follows:
+ *
+ * @code
+ *          num_track_fluxes = 2 * num_tracks * num_polar / 2 * num_groups
+ *          track_fluxes = solver.getTrackFluxes(num_track_fluxes)
+ * @endcode
+ *
+ * @param out_track_fluxes an array of the Track angular fluxes
+ * @param num_track_fluxes the total number of Track angular flux values
+ */
+void GPUSolver::getTrackFluxes(double* out_track_fluxes,
+                               int num_track_fluxes) {
+
+  int size = 2 * _tot_num_tracks * _polar_times_groups;
+  if (num_track_fluxes != size)
+    log_printf(ERROR, "Unable to get the Track angular fluxes since there are "
+               "%d values which does not match the requested %d values",
+               size, num_track_fluxes);
+
+  else if (_start_flux.size() == 0)
+    log_printf(ERROR, "Unable to get the Track angular fluxes since they "
+               "have not yet been allocated on the device");
+
+  /* Copy the fluxes from the GPU and convert them to double precision */
+  thrust::host_vector<FP_PRECISION> track_fluxes(_start_flux);
+  for (int i=0; i < size; i++)
+    out_track_fluxes[i] = track_fluxes[i];
+}
+
+
 /**
  * @brief Sets the number of thread blocks (>0) for CUDA kernels.
  * @param num_blocks the number of thread blocks
@@ -1070,6 +1105,13 @@ void GPUSolver::copyQuadrature() {
  */
 void GPUSolver::initializeExpEvaluator() {
 
+  /* The GPUExpEvaluator does not implement the polynomial approximation */
+  if (_exp_evaluator->isUsingPolynomial()) {
+    log_printf(WARNING, "The GPUSolver does not support the exponential "
+               "polynomial approximation and will use the exp intrinsic");
+    _exp_evaluator->useIntrinsic();
+  }
+
   Solver::initializeExpEvaluator();
 
   log_printf(INFO, "Initializing the exponential evaluator on the GPU...");
@@ -1362,6 +1404,47 @@ void GPUSolver::flattenFSRFluxes(FP_PRECISION value) {
 }
 
 
+/**
+ * @brief Set the scalar flux for each FSR and energy group to the initial
+ *        guess given by setInitialGuess(...).
+ */
+void GPUSolver::loadFSRFluxes() {
+
+  if (_num_initial_fluxes != _num_groups * _num_FSRs)
+    log_printf(ERROR, "Unable to load an initial guess with %d flux values "
+               "for %d groups and %d FSRs", _num_initial_fluxes, _num_groups,
+               _num_FSRs);
+
+  /* Convert the guess to the GPU's precision and copy it onto the GPU */
+  thrust::host_vector<FP_PRECISION> initial_fluxes(_initial_fluxes,
+       _initial_fluxes + _num_initial_fluxes);
+  thrust::copy(initial_fluxes.begin(), initial_fluxes.end(),
+               _scalar_flux.begin());
+}
+
+
+/**
+ * @brief Set each Track's boundary fluxes to the initial guess given by
+ *        setInitialTrackFluxes(...).
+ */
+void GPUSolver::loadTrackFluxes() {
+
+  int size = 2 * _tot_num_tracks * _polar_times_groups;
+  if (_num_initial_track_fluxes != size)
+    log_printf(ERROR, "Unable to load an initial guess with %d Track flux "
+               "values for %d Track flux values", _num_initial_track_fluxes,
+               size);
+
+  /* Convert the guess to the GPU's precision and copy it onto the GPU */
+  thrust::host_vector<FP_PRECISION> track_fluxes(_initial_track_fluxes,
+       _initial_track_fluxes + size);
+  thrust::copy(track_fluxes.begin(), track_fluxes.end(),
+               _boundary_flux.begin());
+  thrust::copy(track_fluxes.begin(), track_fluxes.end(),
+               _start_flux.begin());
+}
+
+
 /**
  * @brief Stores the FSR scalar fluxes in the old scalar flux array.
  */
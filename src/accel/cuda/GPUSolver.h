@@ -21,6 +21,7 @@
 #include <iostream>
 
 #include <thrust/device_vector.h>
+#include <thrust/host_vector.h>
 #include <thrust/copy.h>
 #include <thrust/fill.h>
 #include <thrust/reduce.h>
@@ -123,6 +124,7 @@ public:
   FP_PRECISION getFSRSource(int fsr_id, int group);
   FP_PRECISION getFlux(int fsr_id, int group);
   void getFluxes(FP_PRECISION* out_fluxes, int num_fluxes);
+  void getTrackFluxes(double* out_track_fluxes, int num_track_fluxes);
 
   void setNumThreadBlocks(int num_blocks);
   void setNumThreadsPerBlock(int num_threads);
@@ -140,6 +142,8 @@ public:
 
   void zeroTrackFluxes();
   void flattenFSRFluxes(FP_PRECISION value);
+  void loadFSRFluxes();
+  void loadTrackFluxes();
   void storeFSRFluxes();
   void normalizeFluxes();
   void computeFSRSources();
@@ -23,7 +23,11 @@ enum boundaryType {
   PERIODIC,
 
   /** No boundary type (typically an interface between flat source regions) */
-  BOUNDARY_NONE
+  BOUNDARY_NONE,
+
+  /** An interface with the neighboring spatial domain of a domain
+   *  decomposed Geometry */
+  INTERFACE
 };
 
 #endif /* BOUNDARY_TYPE_H_ */
@@ -38,6 +38,29 @@
 /** Error threshold to determine if a point is to be considered on a Surface */
 #define ON_SURFACE_THRESH 1E-12
 
+/** The maximum number of entries in the path of an FSR key, which holds the
+ *  CMFD cell followed by one entry per level of nested Universes, such that
+ *  an FSR key fills 64 bytes */
+#define MAX_FSR_KEY_LENGTH 15
+
+/** The maximum number of levels of nested Universes, including the root
+ *  Universe, for which a LocalCoords reserves storage. Deeper Geometries
+ *  cannot be described by an FSR key. */
+#define MAX_LOCAL_COORDS_LEVELS (MAX_FSR_KEY_LENGTH - 1)
+
+/** The precision to which the points at which Tracks enter Lattice cells are
+ *  rounded to identify the segment templates reused for repeated cells */
+#define SEGMENT_TEMPLATE_PRECISION 1E-9
+
+/** The stride in longs between the per-thread FSR lookup counters, such that
+ *  each thread's counters reside on their own cache line */
+#define FSR_LOOKUP_COUNT_STRIDE 8
+
+/** The minimum number of Cells in a Universe for which a grid of the Cells
+ *  overlapping each bin is built to accelerate finding the Cell containing a
+ *  point */
+#define CELL_GRID_MIN_CELLS 4
+
 /** Tolerance for difference of the sum of polar weights with respect to 1.0 */
 #define POLAR_WEIGHT_SUM_TOL 1E-5
 
@@ -53,6 +76,45 @@
  *  was selected based on analysis by Yamamoto's 2004 paper on the topic. */
 #define EXP_PRECISION FP_PRECISION(1E-5)
 
+/** The floating point type used to store segment lengths, Track angular
+ *  fluxes and reduced sources. Mixed precision builds store these in single
+ *  precision while computing in double precision (FP_PRECISION). */
+#ifndef FP_STORAGE
+#define FP_STORAGE FP_PRECISION
+#endif
+
+/** The MPI datatype matching the floating point precision (FP_PRECISION) */
+#ifdef MPIx
+#define MPI_FP_PRECISION ((sizeof(FP_PRECISION) == sizeof(float)) ? \
+                          MPI_FLOAT : MPI_DOUBLE)
+#endif
+
+/** The maximum degree of the ExpEvaluator's polynomial approximation */
+#define MAX_EXP_POLY_DEGREE 8
+
+/** The stride in integers between the per-thread cursors into the Track
+ *  schedule, such that each cursor resides on its own cache line */
+#define SCHEDULE_CURSOR_STRIDE 16
+
+/** The largest quantized segment length increment in a compressed
+ *  SegmentStore, one less than the range of a 16-bit integer such that the
+ *  rounded increments always fit */
+#define MAX_PACKED_LENGTH 65534
+
+/** The FSR ID delta in a compressed SegmentStore which marks an FSR ID that
+ *  is read from the table of escaped FSR IDs */
+#define REGION_ID_ESCAPE SHRT_MIN
+
+/** The magic number and format version written after the Geometry in each
+ *  Track file. The version is incremented whenever the layout of the Track
+ *  file changes, such that Track files in an older layout are regenerated */
+#define TRACK_FILE_MAGIC 0x434F4D4F
+#define TRACK_FILE_VERSION 2
+
+/** The number of chunks per thread into which the Track cycles are split at
+ *  most when they are swept from a single boundary flux array */
+#define CYCLE_CHUNKS_PER_THREAD 8
+
 /** The maximum number of iterations allowed for a power method eigenvalue
  *  solve in linalg.cpp */
 #define MIN_LINALG_POWER_ITERATIONS 10
@@ -99,6 +161,10 @@
  *  retrieved from the TrackGenerator. */
 #define NUM_VALUES_PER_RETRIEVED_SEGMENT 7
 
+/** The stride between the Tracks ray traced to estimate the memory required
+ *  to store all segments explicitly */
+#define SEGMENT_MEMORY_SAMPLE_STRIDE 10
+
 #ifdef NVCC
 
 /** The maximum number of polar angles to reserve constant memory on GPU */
@@ -0,0 +1,28 @@
+/**
+ * @file flux_accumulation_type.h
+ * @details The fluxAccumulationType enum.
+ * @date October 16, 2026
+ */
+
+#ifndef FLUX_ACCUMULATION_TYPE_H_
+#define FLUX_ACCUMULATION_TYPE_H_
+
+/**
+ * @enum fluxAccumulationType
+ * @brief The scheme used to tally segment contributions into the shared
+ *        FSR scalar flux array during a transport sweep.
+ */
+enum fluxAccumulationType {
+
+  /** Guard each FSR's scalar flux with an OpenMP mutual exclusion lock */
+  FSR_LOCKS,
+
+  /** Increment each FSR's scalar flux with atomic adds */
+  ATOMIC_UPDATES,
+
+  /** Tally into private per-thread scalar fluxes reduced after the sweep */
+  THREAD_PRIVATE
+
+};
+
+#endif /* FLUX_ACCUMULATION_TYPE_H_ */
@@ -69,6 +69,14 @@ static char title_char = '*';
 static int line_length = 67;
 
 
+/**
+ * @var rank
+ * @brief The MPI rank of this process, of which only the first rank reports
+ *        messages other than ERROR messages.
+ */
+static int rank = 0;
+
+
 /**
  * @var log_error_lock
  * @brief OpenMP mutex lock for ERROR messages which throw exceptions
@@ -295,6 +303,19 @@ const char* get_log_level() {
 }
 
 
+#ifdef MPIx
+/**
+ * @brief Sets the MPI communicator of the processes which share the log.
+ * @details Only the first rank in the communicator reports messages other
+ *          than ERROR messages to the console and the log file.
+ * @param comm the MPI communicator
+ */
+void log_set_ranks(MPI_Comm comm) {
+  MPI_Comm_rank(comm, &rank);
+}
+#endif
+
+
 /**
  * @brief Print a formatted message to the console.
  * @details If the logging level is ERROR, this function will throw a
@@ -304,7 +325,7 @@ const char* get_log_level() {
  */
 void log_printf(logLevel level, const char* format, ...) {
 
-  if (level >= log_level) {
+  if (level >= log_level && (rank == 0 || level == ERROR)) {
     va_list args;
     va_start(args, format);
 
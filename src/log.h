@@ -30,6 +30,9 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <omp.h>
+#ifdef MPIx
+#include <mpi.h>
+#endif
 #endif
 
 #ifdef SWIG
@@ -106,6 +109,9 @@ char get_title_character();
 void set_line_length(int length);
 void set_log_level(const char* new_level);
 const char* get_log_level();
+#ifdef MPIx
+void log_set_ranks(MPI_Comm comm);
+#endif
 
 void log_printf(logLevel level, const char *format, ...);
 std::string create_multiline_msg(std::string level, std::string message);
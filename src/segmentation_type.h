@@ -17,6 +17,10 @@ enum segmentationType {
   /** Explicit 2D segments (required for 2D simulations) */
   EXPLICIT_2D,
 
+  /** On-the-fly 2D segment formation by ray tracing each Track during each
+   *  transport sweep */
+  OTF_2D,
+
   /** Explicit 3D segments */
   EXPLICIT_3D,
 
@@ -0,0 +1,31 @@
+/**
+ * @file track_scheduling_type.h
+ * @details The trackSchedulingType enum.
+ * @date October 16, 2026
+ */
+
+#ifndef TRACK_SCHEDULING_TYPE_H_
+#define TRACK_SCHEDULING_TYPE_H_
+
+/**
+ * @enum trackSchedulingType
+ * @brief The schedules by which the Tracks are distributed among threads
+ *        during a Track traversal.
+ */
+enum trackSchedulingType {
+
+  /** The Tracks of each azimuthal angle are divided evenly by count among
+   *  the threads, with a barrier between azimuthal angles */
+  AZIMUTHAL_SCHEDULING,
+
+  /** The Tracks of all azimuthal angles are statically partitioned among the
+   *  threads by segment count with the longest-processing-time heuristic */
+  STATIC_SCHEDULING,
+
+  /** The Tracks are partitioned as for STATIC_SCHEDULING, after which
+   *  threads which exhaust their own Tracks steal Tracks from other threads */
+  WORK_STEALING_SCHEDULING
+
+};
+
+#endif /* TRACK_SCHEDULING_TYPE_H_ */